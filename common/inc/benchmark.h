@@ -0,0 +1,98 @@
+/***************************************************************************/ /**
+ * @file benchmark.h
+ * @brief Cycle-accurate micro-benchmarks with regression thresholds
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+// Benchmarks are opt-in, define BENCHMARK_ENABLE to 1 in the project to run
+// them. When it is 0, the module adds no code or data.
+#ifndef BENCHMARK_ENABLE
+#define BENCHMARK_ENABLE 0
+#endif
+
+#if BENCHMARK_ENABLE
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cycle_counter.h"
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Code under measurement, called once per iteration
+typedef void (*benchmark_function_t)(void *context);
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Starts the cycle counter, measures the overhead of a measurement and
+ * clears the failure count.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void benchmark_init(void);
+
+/***************************************************************************/ /**
+ * Runs a function under the cycle counter, with interrupts masked, and
+ * prints the result as one JSON line. The measurement overhead is removed.
+ * The benchmark fails when the mean cost per unit, such as a byte or a
+ * captured edge, is above the threshold. It is reported as invalid, and
+ * fails, when the total number of units is 0 or does not fit 32 bits.
+ *
+ * @param[in] name Benchmark name, printed in the result.
+ * @param[in] function Code to measure.
+ * @param[in] context Passed to the function.
+ * @param[in] iterations Number of calls, not 0.
+ * @param[in] units_per_iteration Units processed per call, not 0.
+ * @param[in] max_cycles_per_unit Threshold, in cycles per unit.
+ * @return true if passed, false if regressed.
+ ******************************************************************************/
+bool benchmark_run(const char *name,
+                   benchmark_function_t function,
+                   void *context,
+                   uint32_t iterations,
+                   uint32_t units_per_iteration,
+                   uint32_t max_cycles_per_unit);
+
+/***************************************************************************/ /**
+ * Checks and prints a cost measured by the caller, such as an interrupt
+ * handler traced during a real transfer, in the same format as
+ * benchmark_run() without cycles_min and cycles_max, which are not known.
+ *
+ * @param[in] name Benchmark name, printed in the result.
+ * @param[in] units Units processed, not 0.
+ * @param[in] total_cycles Cycles spent for all the units.
+ * @param[in] max_cycles_per_unit Threshold, in cycles per unit.
+ * @return true if passed, false if regressed.
+ ******************************************************************************/
+bool benchmark_report(const char *name,
+                      uint32_t units,
+                      uint64_t total_cycles,
+                      uint32_t max_cycles_per_unit);
+
+/***************************************************************************/ /**
+ * Prints the number of benchmarks run and failed, as one JSON line.
+ *
+ * @param none
+ * @return number of failed benchmarks
+ ******************************************************************************/
+uint32_t benchmark_print_summary(void);
+
+#endif // BENCHMARK_ENABLE
+
+#endif /* BENCHMARK_H_ */
@@ -0,0 +1,141 @@
+/***************************************************************************/ /**
+ * @file capture_export.h
+ * @brief Compact binary framing of capture timestamps
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef CAPTURE_EXPORT_H_
+#define CAPTURE_EXPORT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Frame layout, multi-byte fields little endian:
+//   sync      2 bytes, CAPTURE_EXPORT_SYNC_0 then CAPTURE_EXPORT_SYNC_1
+//   sequence  2 bytes, incremented for every frame, sent or dropped
+//   flags     1 byte, CAPTURE_EXPORT_FLAG_*
+//   count     1 byte, number of timestamps
+//   length    1 byte, payload length
+//   payload   [lost] first timestamp, then count - 1 deltas, as varints
+//   crc       2 bytes, CRC-16/CCITT-FALSE from sequence to payload
+// A varint holds 7 bits per byte, least significant first, with the top bit
+// set on all bytes but the last. The first timestamp is absolute so every
+// frame can be decoded alone, the next ones are differences to the previous
+// timestamp and usually take 2 to 4 bytes.
+#define CAPTURE_EXPORT_SYNC_0        0xA5
+#define CAPTURE_EXPORT_SYNC_1        0x5A
+#define CAPTURE_EXPORT_FLAG_LOST     0x01 // The payload starts with the number of captures lost before the frame
+#define CAPTURE_EXPORT_HEADER_SIZE   7
+#define CAPTURE_EXPORT_CRC_SIZE      2
+#define CAPTURE_EXPORT_PAYLOAD_MAX   240  // Largest payload, fits the length byte
+#define CAPTURE_EXPORT_VARINT_MAX    10   // Largest varint, for 64 bits
+#define CAPTURE_EXPORT_FRAME_MAX \
+  (CAPTURE_EXPORT_HEADER_SIZE + CAPTURE_EXPORT_PAYLOAD_MAX + CAPTURE_EXPORT_CRC_SIZE)
+
+#ifndef CAPTURE_EXPORT_RECORDS_MAX
+#define CAPTURE_EXPORT_RECORDS_MAX   64   // Timestamps per frame
+#endif
+#ifndef CAPTURE_EXPORT_TX_SIZE
+#define CAPTURE_EXPORT_TX_SIZE       1024 // Frames waiting for transmission, in bytes, must be a power of two
+#endif
+#define CAPTURE_EXPORT_TX_MASK       (CAPTURE_EXPORT_TX_SIZE - 1)
+
+// The queue indexes run freely and wrap at 2^32, the slot is only right
+// across that wrap when the size divides 2^32.
+_Static_assert((CAPTURE_EXPORT_TX_SIZE & CAPTURE_EXPORT_TX_MASK) == 0,
+               "CAPTURE_EXPORT_TX_SIZE must be a power of two");
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Sends bytes on the export link, it may block.
+typedef void (*capture_export_write_t)(const uint8_t *data, uint32_t length);
+
+// Exporter, used from a single context. Timestamps are encoded into the
+// current frame as they are added. Closed frames wait in a transmit queue
+// and are written in chunks, when the caller has time.
+typedef struct {
+  uint8_t frame[CAPTURE_EXPORT_FRAME_MAX]; // Frame being built
+  uint32_t frame_length;                   // Bytes in frame, header included
+  uint32_t frame_count;                    // Timestamps in frame
+  uint64_t previous;                       // Last timestamp encoded
+  uint16_t sequence;                       // Sequence number of the next frame
+  uint8_t tx[CAPTURE_EXPORT_TX_SIZE];      // Transmit queue
+  uint32_t tx_head;                        // Next byte queued
+  uint32_t tx_tail;                        // Next byte written
+  uint32_t frames_dropped;                 // Frames dropped, transmit queue full
+} capture_export_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Initializes an exporter, with empty frame and transmit queue.
+ *
+ * @param[out] exporter Exporter to initialize.
+ * @return none
+ ******************************************************************************/
+void capture_export_init(capture_export_t *exporter);
+
+/***************************************************************************/ /**
+ * Adds a timestamp to the current frame. The frame is closed and queued when
+ * it is full. A timestamp following lost captures starts a new frame, which
+ * holds the number of lost captures.
+ *
+ * @param[in,out] exporter Exporter.
+ * @param[in] timestamp Capture timestamp, not below the previous one.
+ * @param[in] lost Number of captures lost just before this one, usually 0.
+ * @return none
+ ******************************************************************************/
+void capture_export_add(capture_export_t *exporter,
+                        uint64_t timestamp,
+                        uint32_t lost);
+
+/***************************************************************************/ /**
+ * Closes the current frame, if it holds any timestamp, and queues it.
+ *
+ * @param[in,out] exporter Exporter.
+ * @return none
+ ******************************************************************************/
+void capture_export_flush(capture_export_t *exporter);
+
+/***************************************************************************/ /**
+ * Returns whether the current frame holds timestamps not queued yet.
+ *
+ * @param[in] exporter Exporter.
+ * @return true if the frame is not empty.
+ ******************************************************************************/
+bool capture_export_is_pending(const capture_export_t *exporter);
+
+/***************************************************************************/ /**
+ * Writes up to max_length queued bytes, so the caller bounds the time spent.
+ *
+ * @param[in,out] exporter Exporter.
+ * @param[in] write Function sending the bytes.
+ * @param[in] max_length Largest number of bytes written.
+ * @return number of bytes written
+ ******************************************************************************/
+uint32_t capture_export_transmit(capture_export_t *exporter,
+                                 capture_export_write_t write,
+                                 uint32_t max_length);
+
+/***************************************************************************/ /**
+ * Returns the number of frames dropped because the transmit queue was full.
+ * The receiver sees them as gaps in the sequence numbers.
+ *
+ * @param[in] exporter Exporter.
+ * @return number of dropped frames
+ ******************************************************************************/
+uint32_t capture_export_get_frames_dropped(const capture_export_t *exporter);
+
+#endif /* CAPTURE_EXPORT_H_ */
@@ -0,0 +1,128 @@
+/***************************************************************************/ /**
+ * @file capture_ring.h
+ * @brief Lock-free ring of timer capture timestamps
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef CAPTURE_RING_H_
+#define CAPTURE_RING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "si91x_device.h"
+
+#ifndef CAPTURE_RING_SIZE
+#define CAPTURE_RING_SIZE 64 // Number of timestamps, must be a power of two
+#endif
+#define CAPTURE_RING_MASK (CAPTURE_RING_SIZE - 1)
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Single producer, single consumer ring. The interrupt handler writes the
+// head and the main loop the tail. When the ring is full, the new timestamp
+// is dropped and counted, and the next stored one is flagged as following a
+// gap, so the consumer never pairs timestamps across lost ones. A producer
+// which loses a capture before it reaches the ring flags it the same way.
+typedef struct {
+  uint64_t timestamps[CAPTURE_RING_SIZE]; // Extended capture timestamps
+  volatile uint8_t gap[CAPTURE_RING_SIZE]; // Timestamps lost before this one
+  volatile uint32_t head;                 // Next slot written by the producer
+  volatile uint32_t tail;                 // Next slot read by the consumer
+  volatile uint32_t overruns;             // Timestamps dropped or lost
+  bool gap_pending;                       // Producer only, a drop is not flagged yet
+} capture_ring_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Empties a ring and clears its overrun counter. It must not be called while
+ * the producer is running.
+ *
+ * @param[out] ring Ring to initialize.
+ * @return none
+ ******************************************************************************/
+void capture_ring_init(capture_ring_t *ring);
+
+/***************************************************************************/ /**
+ * Counts a timestamp lost by the producer, from the interrupt handler. The
+ * next stored timestamp is flagged as following a gap.
+ *
+ * @param[in,out] ring Ring to write.
+ * @return none
+ ******************************************************************************/
+__STATIC_INLINE void capture_ring_mark_lost(capture_ring_t *ring)
+{
+  ring->overruns++;
+  ring->gap_pending = true;
+}
+
+/***************************************************************************/ /**
+ * Adds a timestamp, from the interrupt handler. It runs in constant time.
+ *
+ * @param[in,out] ring Ring to write.
+ * @param[in] timestamp Capture timestamp, in timer counts.
+ * @return true if stored, false if dropped because the ring is full.
+ ******************************************************************************/
+__STATIC_INLINE bool capture_ring_push(capture_ring_t *ring, uint64_t timestamp)
+{
+  uint32_t head = ring->head;
+  uint32_t slot = head & CAPTURE_RING_MASK;
+
+  if ((head - ring->tail) >= CAPTURE_RING_SIZE) {
+    capture_ring_mark_lost(ring);
+    return false;
+  }
+  ring->timestamps[slot] = timestamp;
+  ring->gap[slot] = ring->gap_pending;
+  ring->gap_pending = false;
+  // The timestamp must be visible before the consumer can see the index.
+  __DMB();
+  ring->head = head + 1;
+  return true;
+}
+
+/***************************************************************************/ /**
+ * Removes up to max_count timestamps, oldest first.
+ *
+ * @param[in,out] ring Ring to read.
+ * @param[out] timestamps Buffer for the timestamps.
+ * @param[out] gaps Set to true for each timestamp preceded by lost ones,
+ *             can be NULL.
+ * @param[in] max_count Size of the buffers.
+ * @return number of timestamps removed
+ ******************************************************************************/
+uint32_t capture_ring_pop_batch(capture_ring_t *ring,
+                                uint64_t *timestamps,
+                                bool *gaps,
+                                uint32_t max_count);
+
+/***************************************************************************/ /**
+ * Returns the number of timestamps waiting in a ring.
+ *
+ * @param[in] ring Ring to check.
+ * @return number of timestamps
+ ******************************************************************************/
+uint32_t capture_ring_get_count(const capture_ring_t *ring);
+
+/***************************************************************************/ /**
+ * Returns the number of timestamps dropped since the ring was initialized,
+ * full ring or lost by the producer.
+ *
+ * @param[in] ring Ring to check.
+ * @return number of dropped timestamps
+ ******************************************************************************/
+uint32_t capture_ring_get_overruns(const capture_ring_t *ring);
+
+#endif /* CAPTURE_RING_H_ */
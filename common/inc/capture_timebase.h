@@ -0,0 +1,110 @@
+/***************************************************************************/ /**
+ * @file capture_timebase.h
+ * @brief 64-bit extension of timer capture timestamps
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef CAPTURE_TIMEBASE_H_
+#define CAPTURE_TIMEBASE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "si91x_device.h"
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Timebase of a free-running counter which wraps to 0 after its top value.
+// The counter interrupt handler counts the wraps, the epoch, which extends
+// the counter and its captures to a monotonic 64-bit count.
+typedef struct {
+  volatile uint32_t epoch; // Counter wraps counted so far
+  uint32_t counter_mask;   // Top value of the counter
+  uint8_t counter_bits;    // Width of the counter
+} capture_timebase_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Initializes a timebase, with the epoch at 0. It must be called before the
+ * counter starts.
+ *
+ * @param[out] timebase Timebase to initialize.
+ * @param[in] counter_bits Width of the counter, 16 or 32.
+ * @return none
+ ******************************************************************************/
+void capture_timebase_init(capture_timebase_t *timebase, uint8_t counter_bits);
+
+/***************************************************************************/ /**
+ * Counts one wrap of the counter, from the interrupt handler of its peak
+ * event.
+ *
+ * @param[in,out] timebase Timebase of the counter.
+ * @return none
+ ******************************************************************************/
+__STATIC_INLINE void capture_timebase_wrap(capture_timebase_t *timebase)
+{
+  timebase->epoch = timebase->epoch + 1;
+}
+
+/***************************************************************************/ /**
+ * Extends a capture, from the interrupt handler. When the peak event is
+ * pending in the same handler run, the capture may have been taken on either
+ * side of the wrap: a capture in the lower half of the range was taken after
+ * it. The handler must run within half a counter range of the capture.
+ *
+ * @param[in] timebase Timebase of the counter.
+ * @param[in] capture Captured counter value.
+ * @param[in] wrap_pending The peak event is set and not counted yet.
+ * @return 64-bit timestamp, in counts
+ ******************************************************************************/
+__STATIC_INLINE uint64_t capture_timebase_extend(
+  const capture_timebase_t *timebase,
+  uint32_t capture,
+  bool wrap_pending)
+{
+  uint64_t epoch = timebase->epoch;
+
+  if (wrap_pending && (capture <= (timebase->counter_mask >> 1))) {
+    epoch++;
+  }
+  return (epoch << timebase->counter_bits) | capture;
+}
+
+/***************************************************************************/ /**
+ * Extends a capture knowing the counter value read after it, with all the
+ * wraps up to that value counted. A capture above the counter value was
+ * taken before the last wrap. This is exact, with no condition on latency
+ * other than less than one full range.
+ *
+ * @param[in] timebase Timebase of the counter.
+ * @param[in] capture Captured counter value.
+ * @param[in] counter Counter value read after the capture.
+ * @return 64-bit timestamp, in counts
+ ******************************************************************************/
+__STATIC_INLINE uint64_t capture_timebase_extend_at(
+  const capture_timebase_t *timebase,
+  uint32_t capture,
+  uint32_t counter)
+{
+  uint64_t timestamp =
+    ((uint64_t)timebase->epoch << timebase->counter_bits) | capture;
+
+  if (capture > counter) {
+    timestamp -= (uint64_t)timebase->counter_mask + 1;
+  }
+  return timestamp;
+}
+
+#endif /* CAPTURE_TIMEBASE_H_ */
@@ -0,0 +1,156 @@
+/***************************************************************************/ /**
+ * @file capture_timer.h
+ * @brief Config timer input capture, configured at compile time
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef CAPTURE_TIMER_H_
+#define CAPTURE_TIMER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "rsi_ct.h"
+#include "rsi_rom_clks.h"
+#include "capture_timebase.h"
+
+// The configuration is fixed at compile time, define these in the project
+// to change it. Every access then resolves to a known register.
+#ifndef CAPTURE_TIMER_COUNTER_BITS
+#define CAPTURE_TIMER_COUNTER_BITS 32 // 32 for one 32-bit counter, 16 for counter 0 in 16-bit mode
+#endif
+#ifndef CAPTURE_TIMER_INPUT_PORT
+#define CAPTURE_TIMER_INPUT_PORT   RTE_SCT_IN_0_PORT
+#define CAPTURE_TIMER_INPUT_PIN    RTE_SCT_IN_0_PIN
+#define CAPTURE_TIMER_INPUT_MUX    RTE_SCT_IN_0_MUX
+#endif
+
+// The M4 has a single config timer with a single interrupt line, the instance
+// is not configurable.
+#define CAPTURE_TIMER_BASE         CT0
+#define CAPTURE_TIMER_IRQn         CT_IRQn
+#define CAPTURE_TIMER_IRQHandler   IRQ034_Handler
+
+#if CAPTURE_TIMER_COUNTER_BITS == 32
+#define CAPTURE_TIMER_CONTROL      (COUNTER32_BITMODE | PERIODIC_ENCOUNTER_0 | COUNTER0_UP)
+#define CAPTURE_TIMER_COUNTER_MASK 0xFFFFFFFF
+#elif CAPTURE_TIMER_COUNTER_BITS == 16
+#define CAPTURE_TIMER_CONTROL      (PERIODIC_ENCOUNTER_0 | COUNTER0_UP)
+#define CAPTURE_TIMER_COUNTER_MASK 0xFFFF
+#else
+#error "CAPTURE_TIMER_COUNTER_BITS must be 16 or 32"
+#endif
+
+#define CAPTURE_TIMER_RISING_EDGE   0x01 // Input event of a rising edge of SCT_IN_0
+#define CAPTURE_TIMER_FALLING_EDGE  0x05 // Input event of a falling edge of SCT_IN_0
+#define CAPTURE_TIMER_INPUT_RISING_EDGE(input)  (CAPTURE_TIMER_RISING_EDGE + (input)) // Rising edge of SCT_IN_<input>
+#define CAPTURE_TIMER_INPUT_FALLING_EDGE(input) (CAPTURE_TIMER_FALLING_EDGE + (input)) // Falling edge of SCT_IN_<input>
+#define CAPTURE_TIMER_INPUT_BOTH_EDGES(input)   (0x09 + (input)) // Rising or falling edge of SCT_IN_<input>
+#define CAPTURE_TIMER_CAPTURE_EVENT RSI_CT_EVENT_INTR_0_l // Capture interrupt
+#define CAPTURE_TIMER_WRAP_EVENT    RSI_CT_EVENT_COUNTER_0_IS_PEAK_l // Counter 0 peak interrupt
+#define CAPTURE_TIMER_FREQUENCY     RSI_CLK_GetBaseClock(M4_CT)
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Enables the GPIO clocks and gives the input pin to the config timer.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void capture_timer_gpio_init(void);
+
+/***************************************************************************/ /**
+ * Enables the GPIO clocks and gives one more input pin to the config timer,
+ * for the services capturing several inputs.
+ *
+ * @param[in] port GPIO port, RTE_SCT_IN_<n>_PORT.
+ * @param[in] pin GPIO pin, RTE_SCT_IN_<n>_PIN.
+ * @param[in] mux Pin mux mode, RTE_SCT_IN_<n>_MUX.
+ * @return none
+ ******************************************************************************/
+void capture_timer_input_init(uint8_t port, uint8_t pin, uint8_t mux);
+
+/***************************************************************************/ /**
+ * Selects the config timer clock. CAPTURE_TIMER_FREQUENCY is valid after it.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void capture_timer_clock_init(void);
+
+/***************************************************************************/ /**
+ * Configures counter 0 as a free-running counter capturing the input, and
+ * starts it. The clock is selected first.
+ *
+ * @param[in] interrupt_events Interrupts to enable, such as
+ *            CAPTURE_TIMER_CAPTURE_EVENT and CAPTURE_TIMER_WRAP_EVENT.
+ * @param[in] edge_event First edge captured, CAPTURE_TIMER_RISING_EDGE or
+ *            CAPTURE_TIMER_FALLING_EDGE.
+ * @return none
+ ******************************************************************************/
+void capture_timer_init(uint32_t interrupt_events, uint32_t edge_event);
+
+/***************************************************************************/ /**
+ * Changes the captured edge, from the interrupt handler. The capture is
+ * armed before the interrupt.
+ *
+ * @param[in] edge_event CAPTURE_TIMER_RISING_EDGE or
+ *            CAPTURE_TIMER_FALLING_EDGE.
+ * @return none
+ ******************************************************************************/
+__STATIC_INLINE void capture_timer_select_edge(uint32_t edge_event)
+{
+  RSI_CT_CaptureEventSelect(CAPTURE_TIMER_BASE, edge_event);
+  RSI_CT_InterruptEventSelect(CAPTURE_TIMER_BASE, edge_event);
+}
+
+/***************************************************************************/ /**
+ * Returns the current value of counter 0.
+ *
+ * @param none
+ * @return counter value
+ ******************************************************************************/
+__STATIC_INLINE uint32_t capture_timer_get_count(void)
+{
+  return CAPTURE_TIMER_BASE->CT_COUNTER_REG;
+}
+
+/***************************************************************************/ /**
+ * Interrupt handler path shared by the examples. It acknowledges the pending
+ * events, extends the capture to a 64-bit timestamp and counts the wrap. A
+ * wrap in the same run may be on either side of the capture, it is resolved
+ * before the wrap is counted.
+ *
+ * @param[in,out] timebase Timebase of counter 0.
+ * @param[out] edge Extended capture, only written on a capture event.
+ * @return events handled, test CAPTURE_TIMER_CAPTURE_EVENT for a new edge
+ ******************************************************************************/
+__STATIC_INLINE uint32_t capture_timer_service(capture_timebase_t *timebase,
+                                               uint64_t *edge)
+{
+  uint32_t events = RSI_CT_GetInterruptStatus(CAPTURE_TIMER_BASE);
+
+  RSI_CT_InterruptClear(CAPTURE_TIMER_BASE, events);
+  if (events & CAPTURE_TIMER_CAPTURE_EVENT) {
+    *edge = capture_timebase_extend(timebase,
+                                    CAPTURE_TIMER_BASE->CT_CAPTURE_REG,
+                                    (events & CAPTURE_TIMER_WRAP_EVENT) != 0);
+  }
+  if (events & CAPTURE_TIMER_WRAP_EVENT) {
+    capture_timebase_wrap(timebase);
+  }
+  return events;
+}
+
+#endif /* CAPTURE_TIMER_H_ */
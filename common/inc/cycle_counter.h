@@ -0,0 +1,129 @@
+/***************************************************************************/ /**
+ * @file cycle_counter.h
+ * @brief Cycle counter based delay and timeout service
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef CYCLE_COUNTER_H_
+#define CYCLE_COUNTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "si91x_device.h"
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Timeout started by cycle_counter_timeout_start()
+typedef struct {
+  uint32_t start;  // Cycle count at start
+  uint32_t cycles; // Duration in cycles
+} cycle_counter_timeout_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Starts the DWT cycle counter and reads the M4 core clock frequency.
+ * It can be called again to start over, it never resets the counter.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void cycle_counter_init(void);
+
+/***************************************************************************/ /**
+ * Reads the M4 core clock frequency again. It must be called after the core
+ * clock is changed, the conversions use the frequency read here.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void cycle_counter_update_frequency(void);
+
+/***************************************************************************/ /**
+ * Returns the M4 core clock frequency used for the conversions, in Hz.
+ *
+ * @param none
+ * @return core clock frequency
+ ******************************************************************************/
+uint32_t cycle_counter_get_frequency(void);
+
+/***************************************************************************/ /**
+ * Returns the current cycle count. The counter wraps around, differences
+ * between two reads are valid up to 2^32 cycles.
+ *
+ * @param none
+ * @return cycle count
+ ******************************************************************************/
+__STATIC_INLINE uint32_t cycle_counter_get(void)
+{
+  return DWT->CYCCNT;
+}
+
+/***************************************************************************/ /**
+ * Converts microseconds to core clock cycles.
+ *
+ * @param[in] microseconds Duration to convert.
+ * @return number of cycles, saturated to UINT32_MAX
+ ******************************************************************************/
+uint32_t cycle_counter_us_to_cycles(uint32_t microseconds);
+
+/***************************************************************************/ /**
+ * Converts core clock cycles to microseconds.
+ *
+ * @param[in] cycles Number of cycles to convert.
+ * @return duration in microseconds
+ ******************************************************************************/
+uint32_t cycle_counter_cycles_to_us(uint32_t cycles);
+
+/***************************************************************************/ /**
+ * Busy-waits for the given number of microseconds. The delay must fit in the
+ * counter range, about 23 s at 180 MHz.
+ *
+ * @param[in] microseconds Duration of the delay.
+ * @return none
+ ******************************************************************************/
+void cycle_counter_delay_us(uint32_t microseconds);
+
+/***************************************************************************/ /**
+ * Busy-waits for the given number of milliseconds, without range limit.
+ *
+ * @param[in] milliseconds Duration of the delay.
+ * @return none
+ ******************************************************************************/
+void cycle_counter_delay_ms(uint32_t milliseconds);
+
+/***************************************************************************/ /**
+ * Starts a timeout. The duration must fit in the counter range.
+ *
+ * @param[out] timeout Timeout to start.
+ * @param[in] microseconds Duration of the timeout.
+ * @return none
+ ******************************************************************************/
+void cycle_counter_timeout_start(cycle_counter_timeout_t *timeout,
+                                 uint32_t microseconds);
+
+/***************************************************************************/ /**
+ * Checks whether a timeout has expired. It is cheap enough to be polled.
+ *
+ * @param[in] timeout Started timeout.
+ * @return true if expired, false otherwise
+ ******************************************************************************/
+__STATIC_INLINE bool cycle_counter_timeout_expired(
+  const cycle_counter_timeout_t *timeout)
+{
+  return (cycle_counter_get() - timeout->start) >= timeout->cycles;
+}
+
+#endif /* CYCLE_COUNTER_H_ */
@@ -0,0 +1,112 @@
+/***************************************************************************/ /**
+ * @file deferred_log.h
+ * @brief Deferred lock-free logging
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef DEFERRED_LOG_H_
+#define DEFERRED_LOG_H_
+
+// Logging is deferred by default. When DEFERRED_LOG_ENABLE is 0, DLOG prints
+// synchronously with DEBUGOUT and the module adds no code or data.
+#ifndef DEFERRED_LOG_ENABLE
+#define DEFERRED_LOG_ENABLE 1
+#endif
+
+#if DEFERRED_LOG_ENABLE
+
+#include <stdint.h>
+#include "si91x_device.h"
+
+#ifndef DEFERRED_LOG_RING_SIZE
+#define DEFERRED_LOG_RING_SIZE    32 // Records per context, must be a power of two
+#endif
+#ifndef DEFERRED_LOG_PROCESS_MAX
+#define DEFERRED_LOG_PROCESS_MAX  8  // Records printed per deferred_log_process() call
+#endif
+#define DEFERRED_LOG_ARGS_MAX     4  // Arguments per record
+#define DEFERRED_LOG_CONTEXTS     2  // Thread mode, and all the handlers
+
+// -----------------------------------------------------------------------------
+// Macros
+
+// Records a message with up to DEFERRED_LOG_ARGS_MAX arguments, which are
+// stored as pointer-sized values, 32 bits on the M4. The format string is not read at the call site,
+// its address identifies the message: it must be a string literal, and %s
+// arguments must point to strings which are never modified.
+#define DLOG(...)                                                        \
+  DLOG_SELECT(__VA_ARGS__, DLOG_4, DLOG_3, DLOG_2, DLOG_1, DLOG_0, unused) \
+  (__VA_ARGS__)
+#define DLOG_SELECT(format, a0, a1, a2, a3, name, ...) name
+#define DLOG_0(format) deferred_log_write((format), 0, 0, 0, 0)
+#define DLOG_1(format, a0) deferred_log_write((format), (uintptr_t)(a0), 0, 0, 0)
+#define DLOG_2(format, a0, a1) \
+  deferred_log_write((format), (uintptr_t)(a0), (uintptr_t)(a1), 0, 0)
+#define DLOG_3(format, a0, a1, a2)                                     \
+  deferred_log_write((format), (uintptr_t)(a0), (uintptr_t)(a1), \
+                     (uintptr_t)(a2), 0)
+#define DLOG_4(format, a0, a1, a2, a3)                                 \
+  deferred_log_write((format), (uintptr_t)(a0), (uintptr_t)(a1), \
+                     (uintptr_t)(a2), (uintptr_t)(a3))
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Records a message in the ring of the calling context, thread mode or
+ * handler. It is safe from any interrupt priority: a slot is claimed with
+ * an exclusive access, so a preempting handler takes the next slot. The
+ * message is dropped and counted when the ring is full. Nothing is
+ * formatted here.
+ *
+ * @param[in] format Format string, its address is the message identifier.
+ * @param[in] a0 First argument.
+ * @param[in] a1 Second argument.
+ * @param[in] a2 Third argument.
+ * @param[in] a3 Fourth argument.
+ * @return none
+ ******************************************************************************/
+void deferred_log_write(const char *format,
+                        uintptr_t a0,
+                        uintptr_t a1,
+                        uintptr_t a2,
+                        uintptr_t a3);
+
+/***************************************************************************/ /**
+ * Prints up to DEFERRED_LOG_PROCESS_MAX recorded messages with DEBUGOUT,
+ * thread mode messages first. The order is kept within each context. It
+ * must be called from a single context, usually the main loop when idle.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void deferred_log_process(void);
+
+/***************************************************************************/ /**
+ * Returns the number of messages dropped because a ring was full.
+ *
+ * @param none
+ * @return number of dropped messages
+ ******************************************************************************/
+uint32_t deferred_log_get_dropped(void);
+
+#else // DEFERRED_LOG_ENABLE
+
+#include "rsi_debug.h"
+
+#define DLOG(...) DEBUGOUT(__VA_ARGS__)
+#define deferred_log_process()
+
+#endif // DEFERRED_LOG_ENABLE
+
+#endif /* DEFERRED_LOG_H_ */
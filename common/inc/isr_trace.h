@@ -0,0 +1,172 @@
+/***************************************************************************/ /**
+ * @file isr_trace.h
+ * @brief Interrupt handler latency and duration tracing
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef ISR_TRACE_H_
+#define ISR_TRACE_H_
+
+// Tracing is opt-in, define ISR_TRACE_ENABLE to 1 in the project to use it.
+// When it is 0, the macros expand to nothing and no code or data is added.
+#ifndef ISR_TRACE_ENABLE
+#define ISR_TRACE_ENABLE 0
+#endif
+
+#if ISR_TRACE_ENABLE
+
+#include <stdint.h>
+#include "cycle_counter.h"
+
+#ifndef ISR_TRACE_SOURCE_COUNT
+#define ISR_TRACE_SOURCE_COUNT    2  // Number of traced interrupt handlers
+#endif
+#ifndef ISR_TRACE_RING_SIZE
+#define ISR_TRACE_RING_SIZE       32 // Records per handler, must be a power of two
+#endif
+#define ISR_TRACE_HISTOGRAM_BINS  16 // Bin n counts values from 2^n to 2^(n+1)-1 cycles
+#define ISR_TRACE_NO_LATENCY      UINT32_MAX // Latency not measured by the handler
+// Function returning the entry and exit timestamps, a test can replace it
+#ifndef ISR_TRACE_CYCLES
+#define ISR_TRACE_CYCLES          cycle_counter_get
+#endif
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Statistics of one measured value, in core clock cycles
+typedef struct {
+  uint32_t count;                               // Number of samples
+  uint32_t min;                                 // Smallest sample
+  uint32_t max;                                 // Largest sample
+  uint64_t total;                               // Sum of the samples, for the mean
+  uint32_t histogram[ISR_TRACE_HISTOGRAM_BINS]; // Samples per power of two bin
+} isr_trace_metric_t;
+
+// Statistics of one interrupt handler
+typedef struct {
+  isr_trace_metric_t duration; // Entry to exit
+  isr_trace_metric_t latency;  // Event to entry, when measured by the handler
+  uint32_t overruns;           // Records lost because the ring was full
+} isr_trace_stats_t;
+
+// -----------------------------------------------------------------------------
+// Macros
+
+// To be placed first in the handler, it declares the entry timestamp.
+#define ISR_TRACE_ENTER(id) \
+  uint32_t isr_trace_entry_cycles = ISR_TRACE_CYCLES()
+
+// To be placed last in the handler. The latency is in cycles, or
+// ISR_TRACE_NO_LATENCY when the handler cannot tell when the event happened.
+#define ISR_TRACE_EXIT(id, latency)                   \
+  isr_trace_record((id), isr_trace_entry_cycles,      \
+                   ISR_TRACE_CYCLES(), (latency))
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Starts the cycle counter and clears all records and statistics.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void isr_trace_init(void);
+
+/***************************************************************************/ /**
+ * Adds a record to the ring of a handler. It is called by ISR_TRACE_EXIT,
+ * each handler is the only producer of its own ring so no lock is needed.
+ * A record is dropped and counted when the ring is full.
+ *
+ * @param[in] id Handler identifier, below ISR_TRACE_SOURCE_COUNT.
+ * @param[in] entry_cycles Cycle count at entry.
+ * @param[in] exit_cycles Cycle count at exit.
+ * @param[in] latency_cycles Event to entry latency, or ISR_TRACE_NO_LATENCY.
+ * @return none
+ ******************************************************************************/
+void isr_trace_record(uint8_t id,
+                      uint32_t entry_cycles,
+                      uint32_t exit_cycles,
+                      uint32_t latency_cycles);
+
+/***************************************************************************/ /**
+ * Sets the clock frequency of a peripheral timer used by a handler to measure
+ * its latency, from the timer count at the event and the count at entry.
+ *
+ * @param[in] frequency Timer clock frequency, in Hz.
+ * @return none
+ ******************************************************************************/
+void isr_trace_set_timer_frequency(uint32_t frequency);
+
+/***************************************************************************/ /**
+ * Converts peripheral timer counts to core clock cycles.
+ *
+ * @param[in] counts Number of timer counts.
+ * @return number of cycles
+ ******************************************************************************/
+uint32_t isr_trace_timer_to_cycles(uint32_t counts);
+
+/***************************************************************************/ /**
+ * Moves the pending records of all handlers into their statistics. It must
+ * be called from a single context, usually the main loop.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void isr_trace_process(void);
+
+/***************************************************************************/ /**
+ * Copies the statistics of a handler, after isr_trace_process() is called.
+ *
+ * @param[in] id Handler identifier.
+ * @param[out] stats Statistics of the handler.
+ * @return none
+ ******************************************************************************/
+void isr_trace_get_stats(uint8_t id, isr_trace_stats_t *stats);
+
+/***************************************************************************/ /**
+ * Returns the mean of a metric.
+ *
+ * @param[in] metric Metric of a handler.
+ * @return mean in cycles, 0 without samples
+ ******************************************************************************/
+uint32_t isr_trace_get_mean(const isr_trace_metric_t *metric);
+
+/***************************************************************************/ /**
+ * Clears the statistics of a handler.
+ *
+ * @param[in] id Handler identifier.
+ * @return none
+ ******************************************************************************/
+void isr_trace_reset(uint8_t id);
+
+/***************************************************************************/ /**
+ * Prints the statistics of a handler on the debug console, through DLOG:
+ * the lines come out of deferred_log_process().
+ *
+ * @param[in] id Handler identifier.
+ * @param[in] name Name printed with the statistics, a string which is never
+ *                 modified.
+ * @return none
+ ******************************************************************************/
+void isr_trace_print(uint8_t id, const char *name);
+
+#else // ISR_TRACE_ENABLE
+
+#define ISR_TRACE_ENTER(id)
+#define ISR_TRACE_EXIT(id, latency)
+
+#endif // ISR_TRACE_ENABLE
+
+#endif /* ISR_TRACE_H_ */
@@ -0,0 +1,125 @@
+/***************************************************************************/ /**
+ * @file multi_capture.h
+ * @brief Channel-tagged capture of several config timer inputs
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef MULTI_CAPTURE_H_
+#define MULTI_CAPTURE_H_
+
+#include <stdint.h>
+#include "capture_ring.h"
+#include "capture_timebase.h"
+#include "capture_timer.h"
+
+// Counter 0 and counter 1 of the capture timer instance run as two 16-bit
+// counters from the same clock, each capturing its own input. These are the
+// edges captured by default.
+#define MULTI_CAPTURE_CHANNELS       2  // Capture channels of the instance
+#ifndef MULTI_CAPTURE_CHANNEL_0_EVENT
+#define MULTI_CAPTURE_CHANNEL_0_EVENT CAPTURE_TIMER_INPUT_FALLING_EDGE(0) // Edge of SCT_IN_0 captured by counter 0
+#endif
+#ifndef MULTI_CAPTURE_CHANNEL_1_EVENT
+#define MULTI_CAPTURE_CHANNEL_1_EVENT CAPTURE_TIMER_INPUT_FALLING_EDGE(1) // Edge of SCT_IN_1 captured by counter 1
+#endif
+
+// An event is a 64-bit timestamp of counter 0 with the channel and the level
+// of its input after the edge in the top bits, the timestamps need 60 bits
+// for centuries at any timer clock.
+#define MULTI_CAPTURE_CHANNEL_SHIFT  60
+#define MULTI_CAPTURE_CHANNEL_MASK   0x7
+#define MULTI_CAPTURE_LEVEL_SHIFT    63
+#define MULTI_CAPTURE_TIMESTAMP_MASK ((1ULL << MULTI_CAPTURE_CHANNEL_SHIFT) - 1)
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Configures the inputs and the timer, and starts both counters. The
+ * timebase follows counter 0 and is initialized here.
+ *
+ * @param[out] timebase Timebase shared by the channels.
+ * @param[in] channel_0_event Edge of SCT_IN_0 captured by counter 0, such
+ *            as MULTI_CAPTURE_CHANNEL_0_EVENT.
+ * @param[in] channel_1_event Edge of SCT_IN_1 captured by counter 1, such
+ *            as MULTI_CAPTURE_CHANNEL_1_EVENT.
+ * @return none
+ ******************************************************************************/
+void multi_capture_init(capture_timebase_t *timebase,
+                        uint32_t channel_0_event,
+                        uint32_t channel_1_event);
+
+/***************************************************************************/ /**
+ * Measures again the difference between the counters, after counter 1 was
+ * used for something else, such as counting edges, and counts the timer
+ * clock again. The channel 1 interrupt must be disabled.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void multi_capture_resync(void);
+
+/***************************************************************************/ /**
+ * Interrupt handler path. It acknowledges the pending events, reads the
+ * captures of all the channels at once, and queues them as events in time
+ * order. The level of a channel capturing one edge follows from the edge,
+ * the input of a channel capturing both edges is read after its capture. A channel capturing again after its events were acknowledged, but
+ * before its capture is read, overwrites the pending capture: the loss is
+ * counted in the ring and the next queued event is flagged as following a
+ * gap. Two edges of a channel before the handler runs leave no trace in the
+ * timer, the second one is queued alone.
+ *
+ * @param[in,out] timebase Timebase shared by the channels.
+ * @param[in,out] ring Ring receiving the events.
+ * @return events handled
+ ******************************************************************************/
+uint32_t multi_capture_service(capture_timebase_t *timebase,
+                               capture_ring_t *ring);
+
+/***************************************************************************/ /**
+ * Returns the channel of an event.
+ *
+ * @param[in] event Event taken from the ring.
+ * @return channel, below MULTI_CAPTURE_CHANNELS
+ ******************************************************************************/
+__STATIC_INLINE uint8_t multi_capture_get_channel(uint64_t event)
+{
+  return (uint8_t)((event >> MULTI_CAPTURE_CHANNEL_SHIFT)
+                   & MULTI_CAPTURE_CHANNEL_MASK);
+}
+
+/***************************************************************************/ /**
+ * Returns the level of the input of an event after its edge. With both edges
+ * captured, a later edge of the channel before the input is read gives the
+ * level after that edge.
+ *
+ * @param[in] event Event taken from the ring.
+ * @return 1 if high, 0 if low
+ ******************************************************************************/
+__STATIC_INLINE uint8_t multi_capture_get_level(uint64_t event)
+{
+  return (uint8_t)(event >> MULTI_CAPTURE_LEVEL_SHIFT);
+}
+
+/***************************************************************************/ /**
+ * Returns the timestamp of an event, on the shared timebase.
+ *
+ * @param[in] event Event taken from the ring.
+ * @return timestamp, in counts of the timer clock
+ ******************************************************************************/
+__STATIC_INLINE uint64_t multi_capture_get_timestamp(uint64_t event)
+{
+  return event & MULTI_CAPTURE_TIMESTAMP_MASK;
+}
+
+#endif /* MULTI_CAPTURE_H_ */
@@ -0,0 +1,119 @@
+/***************************************************************************/ /**
+ * @file stream_stats.h
+ * @brief Streaming statistics of measured periods
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef STREAM_STATS_H_
+#define STREAM_STATS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "si91x_device.h"
+
+#ifndef STREAM_STATS_HISTOGRAM_BINS
+#define STREAM_STATS_HISTOGRAM_BINS 32 // Bins centered on the first sample, or from 0 below, the end ones also count the outliers
+#endif
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Accumulated statistics, written by a single context. The moments are kept
+// as exact integer sums of the deviations from the first sample, so each
+// sample costs no division or floating point operation and no precision is
+// lost whatever the number of samples. The sums stay exact as long as the
+// number of samples times the largest squared deviation is below 2^64,
+// past that the squared sums saturate and the statistics are flagged.
+typedef struct {
+  volatile uint32_t sequence;         // Odd while the accumulators are updated
+  uint32_t bin_width;                 // Histogram bin width, in sample units
+  uint32_t histogram_start;           // Lower bound of the first bin
+  uint32_t count;                     // Number of samples
+  uint32_t reference;                 // First sample, center of the histogram
+  uint32_t min;                       // Smallest sample
+  uint32_t max;                       // Largest sample
+  uint32_t previous;                  // Last sample, for the jitter
+  uint32_t jitter_max;                // Largest difference of consecutive samples
+  int64_t deviation_sum;              // Sum of the deviations from reference
+  uint64_t deviation_square_sum;      // Sum of the squared deviations
+  uint64_t jitter_square_sum;         // Sum of the squared consecutive differences
+  bool saturated;                     // A squared sum reached UINT64_MAX
+  uint32_t histogram[STREAM_STATS_HISTOGRAM_BINS]; // Samples per bin
+} stream_stats_t;
+
+// Statistics computed from a consistent copy of the accumulators
+typedef struct {
+  uint32_t count;      // Number of samples
+  uint32_t min;        // Smallest sample
+  uint32_t max;        // Largest sample
+  double mean;         // Mean of the samples
+  double std_dev;      // Standard deviation of the samples, 0 if saturated
+  uint32_t jitter_max; // Largest cycle-to-cycle difference
+  double jitter_rms;   // RMS of the cycle-to-cycle differences, 0 if saturated
+  bool saturated;      // The squared sums overflowed, std_dev and jitter_rms are unknown
+  uint32_t histogram_start; // Lower bound of the first bin
+  uint32_t bin_width;  // Width of a bin
+  uint32_t histogram[STREAM_STATS_HISTOGRAM_BINS]; // Samples per bin
+} stream_stats_snapshot_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Initializes the statistics.
+ *
+ * @param[out] stats Statistics to initialize.
+ * @param[in] bin_width Histogram bin width, in sample units, not 0. The
+ *            histogram span, STREAM_STATS_HISTOGRAM_BINS times the width,
+ *            must fit in 32 bits.
+ * @return none
+ ******************************************************************************/
+void stream_stats_init(stream_stats_t *stats, uint32_t bin_width);
+
+/***************************************************************************/ /**
+ * Clears the samples, from the writer context. The next sample becomes the
+ * center of the histogram.
+ *
+ * @param[in,out] stats Statistics to clear.
+ * @return none
+ ******************************************************************************/
+void stream_stats_reset(stream_stats_t *stats);
+
+/***************************************************************************/ /**
+ * Adds a batch of samples, in constant time per sample. The snapshot
+ * sequence is updated once per batch.
+ *
+ * @param[in,out] stats Statistics to update.
+ * @param[in] samples Samples, in order, such as periods in timer counts.
+ * @param[in] count Number of samples.
+ * @return none
+ ******************************************************************************/
+void stream_stats_add_batch(stream_stats_t *stats,
+                            const uint32_t *samples,
+                            uint32_t count);
+
+/***************************************************************************/ /**
+ * Takes a snapshot of the statistics, without locking. The accumulators are
+ * copied and the copy is discarded if the writer updated them meanwhile.
+ * The mean, deviations and RMS are computed from the copy, out of the
+ * writer context.
+ *
+ * @param[in] stats Statistics to read.
+ * @param[out] snapshot Snapshot of the statistics.
+ * @return true if consistent, false if the writer was interrupted while
+ *         updating, the caller can try again later.
+ ******************************************************************************/
+bool stream_stats_get_snapshot(const stream_stats_t *stats,
+                               stream_stats_snapshot_t *snapshot);
+
+#endif /* STREAM_STATS_H_ */
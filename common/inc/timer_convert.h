@@ -0,0 +1,103 @@
+/***************************************************************************/ /**
+ * @file timer_convert.h
+ * @brief Fixed-point conversion of timer counts to time and frequency
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef TIMER_CONVERT_H_
+#define TIMER_CONVERT_H_
+
+#include <stdint.h>
+#include "si91x_device.h"
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Scale factors of a timer clock. They are computed once by
+// timer_convert_init(), when the timer clock is set or changed.
+typedef struct {
+  uint32_t frequency;        // Timer clock frequency, in Hz
+  uint32_t ns_per_count;     // Integer part of the count duration, in ns
+  uint32_t ns_per_count_frac; // Fractional part of the count duration, Q32
+} timer_convert_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Computes the Q32 count duration of a timer clock. This is the only division
+ * of the period conversion.
+ *
+ * @param[out] convert Scale factors to compute.
+ * @param[in] frequency Timer clock frequency, in Hz, not 0.
+ * @return none
+ ******************************************************************************/
+void timer_convert_init(timer_convert_t *convert, uint32_t frequency);
+
+/***************************************************************************/ /**
+ * Converts timer counts to nanoseconds, rounded down, without division.
+ *
+ * @param[in] convert Scale factors of the timer clock.
+ * @param[in] counts Number of timer counts.
+ * @return duration in nanoseconds
+ ******************************************************************************/
+__STATIC_INLINE uint64_t timer_convert_counts_to_ns(
+  const timer_convert_t *convert,
+  uint32_t counts)
+{
+  return ((uint64_t)counts * convert->ns_per_count)
+         + (((uint64_t)counts * convert->ns_per_count_frac) >> 32);
+}
+
+/***************************************************************************/ /**
+ * Converts a 64-bit number of timer counts to nanoseconds, rounded down, for
+ * durations longer than the 32-bit counter range.
+ *
+ * @param[in] convert Scale factors of the timer clock.
+ * @param[in] counts Number of timer counts.
+ * @return duration in nanoseconds
+ ******************************************************************************/
+__STATIC_INLINE uint64_t timer_convert_counts64_to_ns(
+  const timer_convert_t *convert,
+  uint64_t counts)
+{
+  return (counts * convert->ns_per_count)
+         + ((counts >> 32) * convert->ns_per_count_frac)
+         + (((counts & 0xFFFFFFFFULL) * convert->ns_per_count_frac) >> 32);
+}
+
+/***************************************************************************/ /**
+ * Converts the number of timer counts of one period to a frequency.
+ *
+ * @param[in] convert Scale factors of the timer clock.
+ * @param[in] counts Number of timer counts of one period, not 0.
+ * @return frequency in millihertz, rounded to nearest
+ ******************************************************************************/
+uint64_t timer_convert_counts_to_millihz(const timer_convert_t *convert,
+                                        uint32_t counts);
+
+/***************************************************************************/ /**
+ * Converts a block of timer counts to nanoseconds, for capture rings.
+ *
+ * @param[in] convert Scale factors of the timer clock.
+ * @param[in] counts Timer counts to convert.
+ * @param[out] durations_ns Durations in nanoseconds, can be counts' size.
+ * @param[in] length Number of values.
+ * @return none
+ ******************************************************************************/
+void timer_convert_counts_to_ns_batch(const timer_convert_t *convert,
+                                      const uint32_t *counts,
+                                      uint64_t *durations_ns,
+                                      uint32_t length);
+
+#endif /* TIMER_CONVERT_H_ */
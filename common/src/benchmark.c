@@ -0,0 +1,228 @@
+/***************************************************************************/ /**
+ * @file benchmark.c
+ * @brief Cycle-accurate micro-benchmarks with regression thresholds
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "benchmark.h"
+
+#if BENCHMARK_ENABLE
+
+#include <stddef.h>
+#include "rsi_debug.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define CALIBRATION_ITERATIONS 64
+#define HUNDREDTHS             100
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static uint32_t measurement_overhead = 0;
+static uint32_t benchmarks_run = 0;
+static uint32_t benchmarks_failed = 0;
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static void empty_function(void *context);
+static uint32_t measure(benchmark_function_t function, void *context);
+static bool check_and_print(const char *name,
+                            uint32_t iterations,
+                            uint64_t units,
+                            uint64_t total_cycles,
+                            const uint32_t *min_cycles,
+                            const uint32_t *max_cycles,
+                            uint32_t max_cycles_per_unit);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Initializes the benchmarks. The overhead is the smallest cost of measuring
+ * an empty function.
+ ******************************************************************************/
+void benchmark_init(void)
+{
+  uint32_t cycles = 0;
+
+  cycle_counter_init();
+  measurement_overhead = UINT32_MAX;
+  for (uint32_t iteration = 0; iteration < CALIBRATION_ITERATIONS;
+       iteration++) {
+    cycles = measure(empty_function, NULL);
+    if (cycles < measurement_overhead) {
+      measurement_overhead = cycles;
+    }
+  }
+  benchmarks_run = 0;
+  benchmarks_failed = 0;
+}
+
+/*******************************************************************************
+ * Runs a benchmark.
+ ******************************************************************************/
+bool benchmark_run(const char *name,
+                   benchmark_function_t function,
+                   void *context,
+                   uint32_t iterations,
+                   uint32_t units_per_iteration,
+                   uint32_t max_cycles_per_unit)
+{
+  uint64_t total_cycles = 0;
+  uint32_t min_cycles = UINT32_MAX;
+  uint32_t max_cycles = 0;
+  uint32_t cycles = 0;
+
+  for (uint32_t iteration = 0; iteration < iterations; iteration++) {
+    cycles = measure(function, context);
+    cycles = (cycles > measurement_overhead) ? (cycles - measurement_overhead)
+             : 0;
+    total_cycles += cycles;
+    if (cycles < min_cycles) {
+      min_cycles = cycles;
+    }
+    if (cycles > max_cycles) {
+      max_cycles = cycles;
+    }
+  }
+  // The units are counted on 64 bits, a large batch cannot wrap them.
+  return check_and_print(name,
+                         iterations,
+                         (uint64_t)iterations * units_per_iteration,
+                         total_cycles,
+                         (iterations > 0) ? &min_cycles : NULL,
+                         (iterations > 0) ? &max_cycles : NULL,
+                         max_cycles_per_unit);
+}
+
+/*******************************************************************************
+ * Checks an external measurement, the per call values are not known.
+ ******************************************************************************/
+bool benchmark_report(const char *name,
+                      uint32_t units,
+                      uint64_t total_cycles,
+                      uint32_t max_cycles_per_unit)
+{
+  return check_and_print(name, 1, units, total_cycles, NULL, NULL,
+                         max_cycles_per_unit);
+}
+
+/*******************************************************************************
+ * Prints the summary.
+ ******************************************************************************/
+uint32_t benchmark_print_summary(void)
+{
+  DEBUGOUT("{\"benchmarks\":%lu,\"failed\":%lu}\n",
+           (unsigned long)benchmarks_run,
+           (unsigned long)benchmarks_failed);
+  return benchmarks_failed;
+}
+
+/*******************************************************************************
+ * Function measured for the calibration.
+ *
+ * @param[in] context (void) Unused.
+ * @return none
+ ******************************************************************************/
+static void empty_function(void *context)
+{
+  (void)context;
+}
+
+/*******************************************************************************
+ * Function to measure one call with interrupts masked, so the handlers do
+ * not add to the result.
+ *
+ * @param[in] function (benchmark_function_t) Code to measure.
+ * @param[in] context (void) Passed to the function.
+ * @return cycles, measurement overhead included
+ ******************************************************************************/
+static uint32_t measure(benchmark_function_t function, void *context)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint32_t start = 0;
+  uint32_t cycles = 0;
+
+  __disable_irq();
+  start = cycle_counter_get();
+  function(context);
+  cycles = cycle_counter_get() - start;
+  __set_PRIMASK(primask);
+  return cycles;
+}
+
+/*******************************************************************************
+ * Function to compare a result with its threshold and print it as a JSON
+ * line. The cost per unit is printed with two decimals. The per call values
+ * are left out when not known. A result without units, or with more than
+ * the 32 bits printed, is reported as invalid and fails.
+ *
+ * @param[in] name (char) Benchmark name.
+ * @param[in] iterations (uint32_t) Number of measured calls.
+ * @param[in] units (uint64_t) Units processed by all the calls.
+ * @param[in] total_cycles (uint64_t) Cycles of all the calls.
+ * @param[in] min_cycles (uint32_t) Cheapest call, NULL if not known.
+ * @param[in] max_cycles (uint32_t) Most expensive call, NULL if not known.
+ * @param[in] max_cycles_per_unit (uint32_t) Threshold.
+ * @return true if passed, false if regressed or invalid.
+ ******************************************************************************/
+static bool check_and_print(const char *name,
+                            uint32_t iterations,
+                            uint64_t units,
+                            uint64_t total_cycles,
+                            const uint32_t *min_cycles,
+                            const uint32_t *max_cycles,
+                            uint32_t max_cycles_per_unit)
+{
+  uint64_t per_unit_hundredths = 0;
+  uint64_t per_unit = 0;
+  bool valid = (units > 0) && (units <= UINT32_MAX);
+  bool passed = false;
+
+  // The whole cycles and the hundredths are divided apart, so no total can
+  // overflow. A cost past 2^64 hundredths saturates.
+  if (valid) {
+    per_unit = total_cycles / units;
+    per_unit_hundredths = (per_unit > (UINT64_MAX / HUNDREDTHS)) ? UINT64_MAX
+                          : ((per_unit * HUNDREDTHS)
+                             + (((total_cycles % units) * HUNDREDTHS) / units));
+  }
+  passed = valid && (per_unit_hundredths
+                     <= ((uint64_t)max_cycles_per_unit * HUNDREDTHS));
+
+  benchmarks_run++;
+  if (!passed) {
+    benchmarks_failed++;
+  }
+  DEBUGOUT("{\"benchmark\":\"%s\",\"iterations\":%lu,\"units\":%lu,",
+           name,
+           (unsigned long)iterations,
+           (unsigned long)(valid ? units : 0));
+  if ((min_cycles != NULL) && (max_cycles != NULL)) {
+    DEBUGOUT("\"cycles_min\":%lu,\"cycles_max\":%lu,",
+             (unsigned long)*min_cycles,
+             (unsigned long)*max_cycles);
+  }
+  DEBUGOUT("\"cycles_per_unit\":%lu.%02lu,\"threshold\":%lu,"
+           "\"result\":\"%s\"}\n",
+           (unsigned long)(per_unit_hundredths / HUNDREDTHS),
+           (unsigned long)(per_unit_hundredths % HUNDREDTHS),
+           (unsigned long)max_cycles_per_unit,
+           !valid ? "invalid" : (passed ? "pass" : "fail"));
+  return passed;
+}
+
+#endif // BENCHMARK_ENABLE
@@ -0,0 +1,234 @@
+/***************************************************************************/ /**
+ * @file capture_export.c
+ * @brief Compact binary framing of capture timestamps
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "capture_export.h"
+
+#include <string.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SEQUENCE_OFFSET 2 // Header offsets
+#define FLAGS_OFFSET    4
+#define COUNT_OFFSET    5
+#define LENGTH_OFFSET   6
+#define CRC_INIT        0xFFFF
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+// CRC-16/CCITT-FALSE (polynomial 0x1021), one nibble per lookup
+static const uint16_t crc_nibble_table[16] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static void start_frame(capture_export_t *exporter, uint32_t lost);
+static uint32_t put_varint(uint8_t *buffer, uint64_t value);
+static uint16_t crc16(const uint8_t *data, uint32_t length);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Initializes an exporter.
+ ******************************************************************************/
+void capture_export_init(capture_export_t *exporter)
+{
+  exporter->frame_length = 0;
+  exporter->frame_count = 0;
+  exporter->previous = 0;
+  exporter->sequence = 0;
+  exporter->tx_head = 0;
+  exporter->tx_tail = 0;
+  exporter->frames_dropped = 0;
+}
+
+/*******************************************************************************
+ * Adds a timestamp, as a delta to the previous one except first in a frame.
+ ******************************************************************************/
+void capture_export_add(capture_export_t *exporter,
+                        uint64_t timestamp,
+                        uint32_t lost)
+{
+  uint64_t value = timestamp - exporter->previous;
+
+  if ((lost > 0) && (exporter->frame_count > 0)) {
+    capture_export_flush(exporter);
+  }
+  if (exporter->frame_count == 0) {
+    start_frame(exporter, lost);
+    value = timestamp;
+  }
+  exporter->frame_length += put_varint(&exporter->frame[exporter->frame_length],
+                                       value);
+  exporter->frame_count++;
+  exporter->previous = timestamp;
+  // The frame is closed while the largest varint still fits.
+  if ((exporter->frame_count >= CAPTURE_EXPORT_RECORDS_MAX)
+      || ((exporter->frame_length - CAPTURE_EXPORT_HEADER_SIZE)
+          > (CAPTURE_EXPORT_PAYLOAD_MAX - CAPTURE_EXPORT_VARINT_MAX))) {
+    capture_export_flush(exporter);
+  }
+}
+
+/*******************************************************************************
+ * Completes the header and CRC of the current frame and queues it.
+ ******************************************************************************/
+void capture_export_flush(capture_export_t *exporter)
+{
+  uint8_t *frame = exporter->frame;
+  uint32_t length = exporter->frame_length;
+  uint32_t head = exporter->tx_head;
+  uint32_t space = 0;
+  uint32_t first = 0;
+  uint16_t crc = 0;
+
+  if (exporter->frame_count == 0) {
+    return;
+  }
+  frame[SEQUENCE_OFFSET] = (uint8_t)exporter->sequence;
+  frame[SEQUENCE_OFFSET + 1] = (uint8_t)(exporter->sequence >> 8);
+  frame[COUNT_OFFSET] = (uint8_t)exporter->frame_count;
+  frame[LENGTH_OFFSET] = (uint8_t)(length - CAPTURE_EXPORT_HEADER_SIZE);
+  crc = crc16(&frame[SEQUENCE_OFFSET], length - SEQUENCE_OFFSET);
+  frame[length++] = (uint8_t)crc;
+  frame[length++] = (uint8_t)(crc >> 8);
+  exporter->sequence++;
+  exporter->frame_count = 0;
+  exporter->frame_length = 0;
+
+  // A frame is queued whole or not at all.
+  space = CAPTURE_EXPORT_TX_SIZE - (head - exporter->tx_tail);
+  if (length > space) {
+    exporter->frames_dropped++;
+    return;
+  }
+  first = CAPTURE_EXPORT_TX_SIZE - (head & CAPTURE_EXPORT_TX_MASK);
+  if (first > length) {
+    first = length;
+  }
+  memcpy(&exporter->tx[head & CAPTURE_EXPORT_TX_MASK], frame, first);
+  memcpy(exporter->tx, &frame[first], length - first);
+  exporter->tx_head = head + length;
+}
+
+/*******************************************************************************
+ * Returns whether the current frame is not empty.
+ ******************************************************************************/
+bool capture_export_is_pending(const capture_export_t *exporter)
+{
+  return exporter->frame_count > 0;
+}
+
+/*******************************************************************************
+ * Writes the queued bytes, in at most two contiguous pieces.
+ ******************************************************************************/
+uint32_t capture_export_transmit(capture_export_t *exporter,
+                                 capture_export_write_t write,
+                                 uint32_t max_length)
+{
+  uint32_t written = 0;
+  uint32_t offset = 0;
+  uint32_t length = 0;
+
+  while ((written < max_length) && (exporter->tx_tail != exporter->tx_head)) {
+    offset = exporter->tx_tail & CAPTURE_EXPORT_TX_MASK;
+    length = exporter->tx_head - exporter->tx_tail;
+    if (length > (CAPTURE_EXPORT_TX_SIZE - offset)) {
+      length = CAPTURE_EXPORT_TX_SIZE - offset;
+    }
+    if (length > (max_length - written)) {
+      length = max_length - written;
+    }
+    write(&exporter->tx[offset], length);
+    exporter->tx_tail += length;
+    written += length;
+  }
+  return written;
+}
+
+/*******************************************************************************
+ * Returns the number of dropped frames.
+ ******************************************************************************/
+uint32_t capture_export_get_frames_dropped(const capture_export_t *exporter)
+{
+  return exporter->frames_dropped;
+}
+
+/*******************************************************************************
+ * Function to start a frame, the sequence, count and length are set when it
+ * is closed.
+ *
+ * @param[in,out] exporter (capture_export_t) Exporter.
+ * @param[in] lost (uint32_t) Captures lost before the frame.
+ * @return none
+ ******************************************************************************/
+static void start_frame(capture_export_t *exporter, uint32_t lost)
+{
+  uint8_t *frame = exporter->frame;
+
+  frame[0] = CAPTURE_EXPORT_SYNC_0;
+  frame[1] = CAPTURE_EXPORT_SYNC_1;
+  frame[FLAGS_OFFSET] = 0;
+  exporter->frame_length = CAPTURE_EXPORT_HEADER_SIZE;
+  if (lost > 0) {
+    frame[FLAGS_OFFSET] = CAPTURE_EXPORT_FLAG_LOST;
+    exporter->frame_length += put_varint(&frame[exporter->frame_length], lost);
+  }
+}
+
+/*******************************************************************************
+ * Function to encode a varint.
+ *
+ * @param[out] buffer (uint8_t) Destination, CAPTURE_EXPORT_VARINT_MAX bytes.
+ * @param[in] value (uint64_t) Value to encode.
+ * @return number of bytes written
+ ******************************************************************************/
+static uint32_t put_varint(uint8_t *buffer, uint64_t value)
+{
+  uint32_t length = 0;
+
+  while (value >= 0x80) {
+    buffer[length++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  buffer[length++] = (uint8_t)value;
+  return length;
+}
+
+/*******************************************************************************
+ * Function to compute the CRC-16/CCITT-FALSE of a buffer.
+ *
+ * @param[in] data (uint8_t) Bytes to check.
+ * @param[in] length (uint32_t) Number of bytes.
+ * @return CRC
+ ******************************************************************************/
+static uint16_t crc16(const uint8_t *data, uint32_t length)
+{
+  uint16_t crc = CRC_INIT;
+
+  for (uint32_t index = 0; index < length; index++) {
+    crc = (uint16_t)((crc << 4)
+                     ^ crc_nibble_table[((crc >> 12) ^ (data[index] >> 4)) & 0x0F]);
+    crc = (uint16_t)((crc << 4)
+                     ^ crc_nibble_table[((crc >> 12) ^ data[index]) & 0x0F]);
+  }
+  return crc;
+}
@@ -0,0 +1,77 @@
+/***************************************************************************/ /**
+ * @file capture_ring.c
+ * @brief Lock-free ring of timer capture timestamps
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "capture_ring.h"
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Initializes a ring.
+ ******************************************************************************/
+void capture_ring_init(capture_ring_t *ring)
+{
+  ring->head = 0;
+  ring->tail = 0;
+  ring->overruns = 0;
+  ring->gap_pending = false;
+}
+
+/*******************************************************************************
+ * Removes a batch of timestamps.
+ ******************************************************************************/
+uint32_t capture_ring_pop_batch(capture_ring_t *ring,
+                                uint64_t *timestamps,
+                                bool *gaps,
+                                uint32_t max_count)
+{
+  uint32_t tail = ring->tail;
+  uint32_t count = ring->head - tail;
+  uint32_t slot;
+
+  if (count > max_count) {
+    count = max_count;
+  }
+  // The timestamps up to head are complete once the index is read.
+  __DMB();
+  for (uint32_t index = 0; index < count; index++) {
+    slot = (tail + index) & CAPTURE_RING_MASK;
+    timestamps[index] = ring->timestamps[slot];
+    if (gaps != NULL) {
+      gaps[index] = ring->gap[slot];
+    }
+  }
+  // The slots must be read before the producer can reuse them.
+  __DMB();
+  ring->tail = tail + count;
+  return count;
+}
+
+/*******************************************************************************
+ * Returns the number of waiting timestamps.
+ ******************************************************************************/
+uint32_t capture_ring_get_count(const capture_ring_t *ring)
+{
+  return ring->head - ring->tail;
+}
+
+/*******************************************************************************
+ * Returns the number of dropped timestamps.
+ ******************************************************************************/
+uint32_t capture_ring_get_overruns(const capture_ring_t *ring)
+{
+  return ring->overruns;
+}
@@ -0,0 +1,30 @@
+/***************************************************************************/ /**
+ * @file capture_timebase.c
+ * @brief 64-bit extension of timer capture timestamps
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "capture_timebase.h"
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Initializes a timebase.
+ ******************************************************************************/
+void capture_timebase_init(capture_timebase_t *timebase, uint8_t counter_bits)
+{
+  timebase->epoch = 0;
+  timebase->counter_bits = counter_bits;
+  timebase->counter_mask = (uint32_t)((1ULL << counter_bits) - 1);
+}
@@ -0,0 +1,104 @@
+/***************************************************************************/ /**
+ * @file capture_timer.c
+ * @brief Config timer input capture, configured at compile time
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "capture_timer.h"
+
+#include "rsi_rom_egpio.h"
+#include "rsi_egpio.h"
+#include "deferred_log.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_PADS_FIRST_PIN 25 // First pin shared with the host pads
+#define HOST_PADS_LAST_PIN  30 // Last pin shared with the host pads
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Configures the input pin. The pin is known at compile time, the host pads
+ * test of the inlined call is resolved by the compiler.
+ ******************************************************************************/
+void capture_timer_gpio_init(void)
+{
+  capture_timer_input_init(CAPTURE_TIMER_INPUT_PORT,
+                           CAPTURE_TIMER_INPUT_PIN,
+                           CAPTURE_TIMER_INPUT_MUX);
+}
+
+/*******************************************************************************
+ * Configures an input pin.
+ ******************************************************************************/
+void capture_timer_input_init(uint8_t port, uint8_t pin, uint8_t mux)
+{
+  M4CLK->CLK_ENABLE_SET_REG3_b.EGPIO_CLK_ENABLE_b = 1;
+  M4CLK->CLK_ENABLE_SET_REG2_b.EGPIO_PCLK_ENABLE_b = 1;
+
+  if ((pin >= HOST_PADS_FIRST_PIN) && (pin <= HOST_PADS_LAST_PIN)) {
+    RSI_EGPIO_HostPadsGpioModeEnable(pin);
+  }
+
+  RSI_EGPIO_PadReceiverEnable(pin);
+
+  RSI_EGPIO_SetDir(EGPIO, port, pin, EGPIO_CONFIG_DIR_INPUT);
+
+  RSI_EGPIO_SetPinMux(EGPIO, port, pin, mux);
+
+  DLOG("Successfully set pin mode for GPIO_%lu\r\n", (unsigned long)pin);
+}
+
+/*******************************************************************************
+ * Selects the SoC PLL as the config timer clock.
+ ******************************************************************************/
+void capture_timer_clock_init(void)
+{
+  RSI_CLK_CtClkConfig(M4CLK, CT_SOCPLLCLK, SCT_CLOCK_DIV_FACT,
+                      ENABLE_STATIC_CLK);
+}
+
+/*******************************************************************************
+ * Configures and starts counter 0. It counts up to its top value and wraps
+ * to 0, the counter is never reset afterwards.
+ ******************************************************************************/
+void capture_timer_init(uint32_t interrupt_events, uint32_t edge_event)
+{
+  capture_timer_clock_init();
+
+  RSI_CT_SetControl(CAPTURE_TIMER_BASE, CAPTURE_TIMER_CONTROL);
+  DLOG("Successfully set configuration for Config Timer\r\n");
+
+  RSI_CT_PeripheralReset(CAPTURE_TIMER_BASE, (boolean_t)COUNTER_0);
+  RSI_CT_SetCount(CAPTURE_TIMER_BASE, 0);
+  DLOG("Successfully set CT Initial Count\n");
+
+  CAPTURE_TIMER_BASE->CT_MATCH_REG = CAPTURE_TIMER_COUNTER_MASK;
+  DLOG("Successfully set CT Match Count\n");
+
+  RSI_CT_InterruptDisable(CAPTURE_TIMER_BASE, interrupt_events);
+  RSI_CT_InterruptEnable(CAPTURE_TIMER_BASE, interrupt_events);
+  NVIC_EnableIRQ(CAPTURE_TIMER_IRQn);
+  DLOG("Successfully enabled interrupt for Config Timer\r\n");
+
+  RSI_CT_InterruptEventSelect(CAPTURE_TIMER_BASE, edge_event);
+  DLOG("Successfully selected interrupt action event for Config Timer\r\n");
+
+  RSI_CT_CaptureEventSelect(CAPTURE_TIMER_BASE, edge_event);
+  DLOG("Successfully selected capture action event for Config Timer\r\n");
+
+  RSI_CT_StartSoftwareTrig(CAPTURE_TIMER_BASE, COUNTER_0);
+  DLOG("Successfully started Config Timer\r\n");
+}
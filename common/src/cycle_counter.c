@@ -0,0 +1,113 @@
+/***************************************************************************/ /**
+ * @file cycle_counter.c
+ * @brief Cycle counter based delay and timeout service
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "cycle_counter.h"
+#include "sl_si91x_clock_manager.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define MICROSECONDS_PER_SECOND 1000000
+#define MICROSECONDS_PER_MS     1000
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static uint32_t core_clock_frequency = 0;
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Starts the cycle counter.
+ ******************************************************************************/
+void cycle_counter_init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  cycle_counter_update_frequency();
+}
+
+/*******************************************************************************
+ * Reads the core clock frequency.
+ ******************************************************************************/
+void cycle_counter_update_frequency(void)
+{
+  sl_si91x_clock_manager_m4_get_core_clk_src_freq(&core_clock_frequency);
+}
+
+/*******************************************************************************
+ * Returns the core clock frequency.
+ ******************************************************************************/
+uint32_t cycle_counter_get_frequency(void)
+{
+  return core_clock_frequency;
+}
+
+/*******************************************************************************
+ * Converts microseconds to cycles.
+ ******************************************************************************/
+uint32_t cycle_counter_us_to_cycles(uint32_t microseconds)
+{
+  uint64_t cycles = ((uint64_t)microseconds * core_clock_frequency)
+                    / MICROSECONDS_PER_SECOND;
+
+  return (cycles > UINT32_MAX) ? UINT32_MAX : (uint32_t)cycles;
+}
+
+/*******************************************************************************
+ * Converts cycles to microseconds.
+ ******************************************************************************/
+uint32_t cycle_counter_cycles_to_us(uint32_t cycles)
+{
+  if (core_clock_frequency == 0) {
+    return 0;
+  }
+  return (uint32_t)(((uint64_t)cycles * MICROSECONDS_PER_SECOND)
+                    / core_clock_frequency);
+}
+
+/*******************************************************************************
+ * Microsecond delay.
+ ******************************************************************************/
+void cycle_counter_delay_us(uint32_t microseconds)
+{
+  cycle_counter_timeout_t timeout;
+
+  cycle_counter_timeout_start(&timeout, microseconds);
+  while (!cycle_counter_timeout_expired(&timeout)) {
+  }
+}
+
+/*******************************************************************************
+ * Millisecond delay, in 1 ms steps so it never exceeds the counter range.
+ ******************************************************************************/
+void cycle_counter_delay_ms(uint32_t milliseconds)
+{
+  while (milliseconds-- > 0) {
+    cycle_counter_delay_us(MICROSECONDS_PER_MS);
+  }
+}
+
+/*******************************************************************************
+ * Starts a timeout.
+ ******************************************************************************/
+void cycle_counter_timeout_start(cycle_counter_timeout_t *timeout,
+                                 uint32_t microseconds)
+{
+  timeout->cycles = cycle_counter_us_to_cycles(microseconds);
+  timeout->start = cycle_counter_get();
+}
@@ -0,0 +1,160 @@
+/***************************************************************************/ /**
+ * @file deferred_log.c
+ * @brief Deferred lock-free logging
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "deferred_log.h"
+
+#if DEFERRED_LOG_ENABLE
+
+#include <stddef.h>
+#include "rsi_debug.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define DEFERRED_LOG_RING_MASK (DEFERRED_LOG_RING_SIZE - 1)
+#define THREAD_CONTEXT         0
+#define HANDLER_CONTEXT        1
+
+/*******************************************************************************
+ ******************************  Data Types  ***********************************
+ ******************************************************************************/
+// Recorded message, the format is written last and marks the slot complete.
+typedef struct {
+  const char *volatile format;
+  uintptr_t args[DEFERRED_LOG_ARGS_MAX];
+} deferred_log_record_t;
+
+// Ring of one context. Writers claim slots by advancing the head, the main
+// loop reads complete slots and advances the tail.
+typedef struct {
+  deferred_log_record_t records[DEFERRED_LOG_RING_SIZE];
+  volatile uint32_t head;
+  volatile uint32_t tail;
+  volatile uint32_t dropped;
+} deferred_log_ring_t;
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static deferred_log_ring_t rings[DEFERRED_LOG_CONTEXTS];
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static void atomic_increment(volatile uint32_t *value);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Records a message, in a few tens of cycles.
+ ******************************************************************************/
+void deferred_log_write(const char *format,
+                        uintptr_t a0,
+                        uintptr_t a1,
+                        uintptr_t a2,
+                        uintptr_t a3)
+{
+  deferred_log_ring_t *ring =
+    &rings[(__get_IPSR() == 0) ? THREAD_CONTEXT : HANDLER_CONTEXT];
+  deferred_log_record_t *record;
+  uint32_t head;
+
+  // A handler preempting between the load and the store makes the store
+  // fail, and the slot is claimed again.
+  do {
+    head = __LDREXW(&ring->head);
+    if ((head - ring->tail) >= DEFERRED_LOG_RING_SIZE) {
+      __CLREX();
+      atomic_increment(&ring->dropped);
+      return;
+    }
+  } while (__STREXW(head + 1, &ring->head) != 0);
+
+  record = &ring->records[head & DEFERRED_LOG_RING_MASK];
+  record->args[0] = a0;
+  record->args[1] = a1;
+  record->args[2] = a2;
+  record->args[3] = a3;
+  // The arguments must be visible before the main loop can see the format.
+  __DMB();
+  record->format = format;
+}
+
+/*******************************************************************************
+ * Prints the recorded messages. A slot claimed by an interrupted writer is
+ * not complete yet, the messages after it wait for the next call.
+ ******************************************************************************/
+void deferred_log_process(void)
+{
+  uint32_t printed = 0;
+
+  for (uint32_t context = 0; context < DEFERRED_LOG_CONTEXTS; context++) {
+    deferred_log_ring_t *ring = &rings[context];
+
+    while (printed < DEFERRED_LOG_PROCESS_MAX) {
+      deferred_log_record_t *record =
+        &ring->records[ring->tail & DEFERRED_LOG_RING_MASK];
+      const char *format = record->format;
+
+      if ((ring->tail == ring->head) || (format == NULL)) {
+        break;
+      }
+      // The arguments are complete once the format is read.
+      __DMB();
+      DEBUGOUT(format,
+               record->args[0],
+               record->args[1],
+               record->args[2],
+               record->args[3]);
+      record->format = NULL;
+      // The slot must be released before the writers can reuse it.
+      __DMB();
+      ring->tail = ring->tail + 1;
+      printed++;
+    }
+  }
+}
+
+/*******************************************************************************
+ * Returns the number of dropped messages.
+ ******************************************************************************/
+uint32_t deferred_log_get_dropped(void)
+{
+  uint32_t dropped = 0;
+
+  for (uint32_t context = 0; context < DEFERRED_LOG_CONTEXTS; context++) {
+    dropped += rings[context].dropped;
+  }
+  return dropped;
+}
+
+/*******************************************************************************
+ * Function to increment a counter shared by all the interrupt priorities.
+ *
+ * @param[in,out] value (uint32_t) Counter to increment.
+ * @return none
+ ******************************************************************************/
+static void atomic_increment(volatile uint32_t *value)
+{
+  uint32_t current;
+
+  do {
+    current = __LDREXW(value);
+  } while (__STREXW(current + 1, value) != 0);
+}
+
+#endif // DEFERRED_LOG_ENABLE
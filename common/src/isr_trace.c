@@ -0,0 +1,257 @@
+/***************************************************************************/ /**
+ * @file isr_trace.c
+ * @brief Interrupt handler latency and duration tracing
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "isr_trace.h"
+
+#if ISR_TRACE_ENABLE
+
+#include <string.h>
+#include "deferred_log.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define ISR_TRACE_RING_MASK (ISR_TRACE_RING_SIZE - 1)
+#define TIMER_RATIO_SHIFT   16 // Fractional bits of the timer to core clock ratio
+
+/*******************************************************************************
+ ******************************  Data Types  ***********************************
+ ******************************************************************************/
+// Record written by a handler
+typedef struct {
+  uint32_t entry_cycles;   // Cycle count at entry
+  uint32_t duration;       // Entry to exit, in cycles
+  uint32_t latency_cycles; // Event to entry, or ISR_TRACE_NO_LATENCY
+} isr_trace_record_t;
+
+// Ring of one handler. The handler writes the head, the main loop the tail.
+typedef struct {
+  isr_trace_record_t records[ISR_TRACE_RING_SIZE];
+  volatile uint32_t head;
+  volatile uint32_t tail;
+  volatile uint32_t overruns;
+} isr_trace_ring_t;
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static isr_trace_ring_t rings[ISR_TRACE_SOURCE_COUNT];
+static isr_trace_stats_t stats[ISR_TRACE_SOURCE_COUNT];
+static uint32_t timer_cycles_ratio = 1 << TIMER_RATIO_SHIFT;
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static void metric_reset(isr_trace_metric_t *metric);
+static void metric_add(isr_trace_metric_t *metric, uint32_t value);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Initializes the tracing.
+ ******************************************************************************/
+void isr_trace_init(void)
+{
+  cycle_counter_init();
+  for (uint8_t id = 0; id < ISR_TRACE_SOURCE_COUNT; id++) {
+    rings[id].tail = rings[id].head;
+    isr_trace_reset(id);
+  }
+}
+
+/*******************************************************************************
+ * Records one handler execution, called from the handler.
+ ******************************************************************************/
+void isr_trace_record(uint8_t id,
+                      uint32_t entry_cycles,
+                      uint32_t exit_cycles,
+                      uint32_t latency_cycles)
+{
+  isr_trace_ring_t *ring = &rings[id];
+  uint32_t head = ring->head;
+  isr_trace_record_t *record;
+
+  if ((head - ring->tail) >= ISR_TRACE_RING_SIZE) {
+    ring->overruns++;
+    return;
+  }
+  record = &ring->records[head & ISR_TRACE_RING_MASK];
+  record->entry_cycles = entry_cycles;
+  record->duration = exit_cycles - entry_cycles;
+  record->latency_cycles = latency_cycles;
+  // The record must be visible before the main loop can see the index.
+  __DMB();
+  ring->head = head + 1;
+}
+
+/*******************************************************************************
+ * Sets the timer frequency, the ratio is kept with 16 fractional bits.
+ ******************************************************************************/
+void isr_trace_set_timer_frequency(uint32_t frequency)
+{
+  if (frequency != 0) {
+    timer_cycles_ratio =
+      (uint32_t)(((uint64_t)cycle_counter_get_frequency() << TIMER_RATIO_SHIFT)
+                 / frequency);
+  }
+}
+
+/*******************************************************************************
+ * Converts timer counts to cycles.
+ ******************************************************************************/
+uint32_t isr_trace_timer_to_cycles(uint32_t counts)
+{
+  return (uint32_t)(((uint64_t)counts * timer_cycles_ratio)
+                    >> TIMER_RATIO_SHIFT);
+}
+
+/*******************************************************************************
+ * Moves the records into the statistics.
+ ******************************************************************************/
+void isr_trace_process(void)
+{
+  for (uint8_t id = 0; id < ISR_TRACE_SOURCE_COUNT; id++) {
+    isr_trace_ring_t *ring = &rings[id];
+    uint32_t tail = ring->tail;
+    uint32_t head = ring->head;
+
+    // The records up to head are complete once the index is read.
+    __DMB();
+    while (tail != head) {
+      const isr_trace_record_t *record =
+        &ring->records[tail & ISR_TRACE_RING_MASK];
+
+      metric_add(&stats[id].duration, record->duration);
+      if (record->latency_cycles != ISR_TRACE_NO_LATENCY) {
+        metric_add(&stats[id].latency, record->latency_cycles);
+      }
+      tail++;
+    }
+    __DMB();
+    ring->tail = tail;
+    stats[id].overruns = ring->overruns;
+  }
+}
+
+/*******************************************************************************
+ * Copies the statistics of a handler.
+ ******************************************************************************/
+void isr_trace_get_stats(uint8_t id, isr_trace_stats_t *handler_stats)
+{
+  *handler_stats = stats[id];
+}
+
+/*******************************************************************************
+ * Returns the mean of a metric.
+ ******************************************************************************/
+uint32_t isr_trace_get_mean(const isr_trace_metric_t *metric)
+{
+  if (metric->count == 0) {
+    return 0;
+  }
+  return (uint32_t)(metric->total / metric->count);
+}
+
+/*******************************************************************************
+ * Clears the statistics of a handler. The overruns are counted from here.
+ ******************************************************************************/
+void isr_trace_reset(uint8_t id)
+{
+  metric_reset(&stats[id].duration);
+  metric_reset(&stats[id].latency);
+  rings[id].overruns = 0;
+  stats[id].overruns = 0;
+}
+
+/*******************************************************************************
+ * Prints the statistics of a handler.
+ ******************************************************************************/
+void isr_trace_print(uint8_t id, const char *name)
+{
+  const isr_trace_stats_t *handler_stats = &stats[id];
+  const uint32_t *histogram = handler_stats->duration.histogram;
+
+  // DLOG takes four arguments, the longer lines are recorded in parts.
+  DLOG("%s: %lu runs, duration min %lu mean %lu",
+       name,
+       (unsigned long)handler_stats->duration.count,
+       (unsigned long)handler_stats->duration.min,
+       (unsigned long)isr_trace_get_mean(&handler_stats->duration));
+  DLOG(" max %lu cycles, %lu lost \n",
+       (unsigned long)handler_stats->duration.max,
+       (unsigned long)handler_stats->overruns);
+  if (handler_stats->latency.count > 0) {
+    DLOG("%s: latency min %lu mean %lu max %lu cycles \n",
+         name,
+         (unsigned long)handler_stats->latency.min,
+         (unsigned long)isr_trace_get_mean(&handler_stats->latency),
+         (unsigned long)handler_stats->latency.max);
+  }
+  DLOG("%s: duration histogram", name);
+  for (uint32_t bin = 0; bin < ISR_TRACE_HISTOGRAM_BINS; bin += 4) {
+    DLOG(" %lu %lu %lu %lu",
+         (unsigned long)histogram[bin],
+         (unsigned long)histogram[bin + 1],
+         (unsigned long)histogram[bin + 2],
+         (unsigned long)histogram[bin + 3]);
+  }
+  DLOG(" \n");
+}
+
+/*******************************************************************************
+ * Function to clear a metric.
+ *
+ * @param[out] metric (isr_trace_metric_t) Metric to clear.
+ * @return none
+ ******************************************************************************/
+static void metric_reset(isr_trace_metric_t *metric)
+{
+  memset(metric, 0, sizeof(*metric));
+  metric->min = UINT32_MAX;
+}
+
+/*******************************************************************************
+ * Function to add a sample to a metric.
+ * The histogram bin is the position of the most significant bit, the last
+ * bin also counts the larger values.
+ *
+ * @param[in,out] metric (isr_trace_metric_t) Metric to update.
+ * @param[in] value (uint32_t) Sample, in cycles.
+ * @return none
+ ******************************************************************************/
+static void metric_add(isr_trace_metric_t *metric, uint32_t value)
+{
+  uint32_t bin = 0;
+
+  metric->count++;
+  metric->total += value;
+  if (value < metric->min) {
+    metric->min = value;
+  }
+  if (value > metric->max) {
+    metric->max = value;
+  }
+  if (value > 0) {
+    bin = 31 - __CLZ(value);
+  }
+  if (bin >= ISR_TRACE_HISTOGRAM_BINS) {
+    bin = ISR_TRACE_HISTOGRAM_BINS - 1;
+  }
+  metric->histogram[bin]++;
+}
+
+#endif // ISR_TRACE_ENABLE
@@ -0,0 +1,255 @@
+/***************************************************************************/ /**
+ * @file multi_capture.c
+ * @brief Channel-tagged capture of several config timer inputs
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "multi_capture.h"
+
+#include "deferred_log.h"
+#include "rsi_rom_egpio.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define COUNTER_1_SHIFT      16     // Counter 1 fields are the upper halves
+#define COUNTER_16BIT_MASK   0xFFFF
+#define COUNTER_16BIT_BITS   16
+#define COUNTER_16BIT_HALF   0x8000
+#define MULTI_CAPTURE_CONTROL \
+  (PERIODIC_ENCOUNTER_0 | COUNTER0_UP | PERIODIC_ENCOUNTER_1 | COUNTER1_UP)
+#define CHANNEL_0_EVENT      RSI_CT_EVENT_INTR_0_l
+#define CHANNEL_1_EVENT      RSI_CT_EVENT_INTR_1_l
+#define WRAP_EVENT           RSI_CT_EVENT_COUNTER_0_IS_PEAK_l
+#define CHANNEL_1_TAG        (1ULL << MULTI_CAPTURE_CHANNEL_SHIFT)
+#define LEVEL_TAG            (1ULL << MULTI_CAPTURE_LEVEL_SHIFT)
+
+/*******************************************************************************
+ **********************  Local variables   *************************************
+ ******************************************************************************/
+// Counter 0 minus counter 1, constant once both counters run
+static uint32_t counter_1_offset = 0;
+// Channel events whose input is read, the channels capturing both edges
+static uint32_t sampled_events = 0;
+// Level of each channel after its last edge, as a tag of its events
+static uint64_t level_tags[MULTI_CAPTURE_CHANNELS];
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static uint32_t find_overwritten(uint32_t events,
+                                 uint32_t counters,
+                                 uint32_t captures);
+static void init_level(uint8_t channel, uint32_t event, uint32_t channel_event);
+static void sample_levels(uint32_t events);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Configures CT0 in 16-bit mode. Both counters count the timer clock and wrap
+ * at 0xFFFF, counter 0 captures SCT_IN_0 and counter 1 SCT_IN_1.
+ ******************************************************************************/
+void multi_capture_init(capture_timebase_t *timebase,
+                        uint32_t channel_0_event,
+                        uint32_t channel_1_event)
+{
+  uint32_t interrupt_events = CHANNEL_0_EVENT | CHANNEL_1_EVENT | WRAP_EVENT;
+  uint32_t edge_events = channel_0_event
+                         | (channel_1_event << COUNTER_1_SHIFT);
+
+  capture_timer_input_init(RTE_SCT_IN_0_PORT, RTE_SCT_IN_0_PIN,
+                           RTE_SCT_IN_0_MUX);
+  capture_timer_input_init(RTE_SCT_IN_1_PORT, RTE_SCT_IN_1_PIN,
+                           RTE_SCT_IN_1_MUX);
+  capture_timer_clock_init();
+  capture_timebase_init(timebase, COUNTER_16BIT_BITS);
+  sampled_events = 0;
+  init_level(0, channel_0_event, CHANNEL_0_EVENT);
+  init_level(1, channel_1_event, CHANNEL_1_EVENT);
+
+  RSI_CT_SetControl(CAPTURE_TIMER_BASE, MULTI_CAPTURE_CONTROL);
+  RSI_CT_PeripheralReset(CAPTURE_TIMER_BASE, (boolean_t)COUNTER_0);
+  RSI_CT_PeripheralReset(CAPTURE_TIMER_BASE, (boolean_t)COUNTER_1);
+  RSI_CT_SetCount(CAPTURE_TIMER_BASE, 0);
+  // Both counters wrap after 0xFFFF.
+  CAPTURE_TIMER_BASE->CT_MATCH_REG =
+    COUNTER_16BIT_MASK | (COUNTER_16BIT_MASK << COUNTER_1_SHIFT);
+
+  RSI_CT_InterruptDisable(CAPTURE_TIMER_BASE, interrupt_events);
+  RSI_CT_InterruptEnable(CAPTURE_TIMER_BASE, interrupt_events);
+  NVIC_EnableIRQ(CAPTURE_TIMER_IRQn);
+
+  RSI_CT_InterruptEventSelect(CAPTURE_TIMER_BASE, edge_events);
+  RSI_CT_CaptureEventSelect(CAPTURE_TIMER_BASE, edge_events);
+
+  RSI_CT_StartSoftwareTrig(CAPTURE_TIMER_BASE, COUNTER_0);
+  RSI_CT_StartSoftwareTrig(CAPTURE_TIMER_BASE, COUNTER_1);
+  multi_capture_resync();
+  DLOG("Successfully started %lu capture channels\r\n",
+       (unsigned long)MULTI_CAPTURE_CHANNELS);
+}
+
+/*******************************************************************************
+ * The counters count the same clock, with the same top value, but were not
+ * started together. Their difference is read in one access, it moves the
+ * counter 1 captures onto the counter 0 timebase.
+ ******************************************************************************/
+void multi_capture_resync(void)
+{
+  uint32_t counters = CAPTURE_TIMER_BASE->CT_COUNTER_REG;
+
+  counter_1_offset =
+    ((counters & COUNTER_16BIT_MASK) - (counters >> COUNTER_1_SHIFT))
+    & COUNTER_16BIT_MASK;
+}
+
+/*******************************************************************************
+ * Handles the capture events. The status and the captures are read once for
+ * all the channels. The edges of one run are sorted here, the edges of a
+ * later run came after the status was read, so the queue is in time order.
+ *
+ * The counters are read after the events are acknowledged and before the
+ * captures. A pending channel whose capture is later than its counter was
+ * captured again by an edge which is pending once more: the edge of the
+ * status is lost, and the new one is queued by the next run.
+ ******************************************************************************/
+uint32_t multi_capture_service(capture_timebase_t *timebase,
+                               capture_ring_t *ring)
+{
+  uint32_t events = RSI_CT_GetInterruptStatus(CAPTURE_TIMER_BASE);
+  bool wrap_pending = (events & WRAP_EVENT) != 0;
+  uint32_t counters = 0;
+  uint32_t captures = 0;
+  uint32_t overwritten = 0;
+  uint64_t edge_0 = 0;
+  uint64_t edge_1 = 0;
+
+  RSI_CT_InterruptClear(CAPTURE_TIMER_BASE, events);
+  if (events & (CHANNEL_0_EVENT | CHANNEL_1_EVENT)) {
+    counters = CAPTURE_TIMER_BASE->CT_COUNTER_REG;
+    captures = CAPTURE_TIMER_BASE->CT_CAPTURE_REG;
+    overwritten = find_overwritten(events, counters, captures);
+    sample_levels(events & ~overwritten);
+  }
+  if (overwritten & CHANNEL_0_EVENT) {
+    capture_ring_mark_lost(ring);
+  }
+  if (overwritten & CHANNEL_1_EVENT) {
+    capture_ring_mark_lost(ring);
+  }
+  if ((events & ~overwritten) & CHANNEL_0_EVENT) {
+    edge_0 = capture_timebase_extend(timebase,
+                                     captures & COUNTER_16BIT_MASK,
+                                     wrap_pending);
+  }
+  if ((events & ~overwritten) & CHANNEL_1_EVENT) {
+    edge_1 = capture_timebase_extend(timebase,
+                                     ((captures >> COUNTER_1_SHIFT)
+                                      + counter_1_offset)
+                                     & COUNTER_16BIT_MASK,
+                                     wrap_pending);
+  }
+  switch ((events & ~overwritten) & (CHANNEL_0_EVENT | CHANNEL_1_EVENT)) {
+    case CHANNEL_0_EVENT:
+      capture_ring_push(ring, edge_0 | level_tags[0]);
+      break;
+    case CHANNEL_1_EVENT:
+      capture_ring_push(ring, edge_1 | CHANNEL_1_TAG | level_tags[1]);
+      break;
+    case CHANNEL_0_EVENT | CHANNEL_1_EVENT:
+      // On equal timestamps, channel 0 comes first.
+      if (edge_1 < edge_0) {
+        capture_ring_push(ring, edge_1 | CHANNEL_1_TAG | level_tags[1]);
+        capture_ring_push(ring, edge_0 | level_tags[0]);
+      } else {
+        capture_ring_push(ring, edge_0 | level_tags[0]);
+        capture_ring_push(ring, edge_1 | CHANNEL_1_TAG | level_tags[1]);
+      }
+      break;
+    default:
+      break;
+  }
+  if (wrap_pending) {
+    capture_timebase_wrap(timebase);
+  }
+  return events;
+}
+
+/*******************************************************************************
+ * Function to find the pending channels whose capture was replaced after the
+ * events were acknowledged. A capture read before its handler is at most half
+ * a counter range older than the counter, a later one is at most as recent
+ * as the capture register read.
+ *
+ * @param[in] events (uint32_t) Pending events, acknowledged.
+ * @param[in] counters (uint32_t) Counter register, read after the acknowledge.
+ * @param[in] captures (uint32_t) Capture register, read after the counters.
+ * @return channel events whose capture was replaced
+ ******************************************************************************/
+static uint32_t find_overwritten(uint32_t events,
+                                 uint32_t counters,
+                                 uint32_t captures)
+{
+  uint32_t overwritten = 0;
+
+  if ((events & CHANNEL_0_EVENT)
+      && (((captures - counters) & COUNTER_16BIT_MASK) < COUNTER_16BIT_HALF)) {
+    overwritten |= CHANNEL_0_EVENT;
+  }
+  if ((events & CHANNEL_1_EVENT)
+      && ((((captures >> COUNTER_1_SHIFT) - (counters >> COUNTER_1_SHIFT))
+           & COUNTER_16BIT_MASK) < COUNTER_16BIT_HALF)) {
+    overwritten |= CHANNEL_1_EVENT;
+  }
+  return overwritten;
+}
+
+/*******************************************************************************
+ * Function to set how the level of a channel is known. A rising edge leaves
+ * its input high and a falling edge low, the input of a channel capturing
+ * both edges is read by the handler.
+ *
+ * @param[in] channel (uint8_t) Channel, its input has the same number.
+ * @param[in] event (uint32_t) Edge captured by the channel.
+ * @param[in] channel_event (uint32_t) Interrupt event of the channel.
+ * @return none
+ ******************************************************************************/
+static void init_level(uint8_t channel, uint32_t event, uint32_t channel_event)
+{
+  level_tags[channel] =
+    (event == (uint32_t)CAPTURE_TIMER_INPUT_RISING_EDGE(channel)) ? LEVEL_TAG : 0;
+  if (event == (uint32_t)CAPTURE_TIMER_INPUT_BOTH_EDGES(channel)) {
+    sampled_events |= channel_event;
+  }
+}
+
+/*******************************************************************************
+ * Function to read the inputs of the captured channels which capture both
+ * edges. It runs after the captures are read, an edge changing an input
+ * since then is pending again.
+ *
+ * @param[in] events (uint32_t) Channel events whose capture is queued.
+ * @return none
+ ******************************************************************************/
+static void sample_levels(uint32_t events)
+{
+  if (events & sampled_events & CHANNEL_0_EVENT) {
+    level_tags[0] = RSI_EGPIO_GetPin(EGPIO, RTE_SCT_IN_0_PORT,
+                                     RTE_SCT_IN_0_PIN) ? LEVEL_TAG : 0;
+  }
+  if (events & sampled_events & CHANNEL_1_EVENT) {
+    level_tags[1] = RSI_EGPIO_GetPin(EGPIO, RTE_SCT_IN_1_PORT,
+                                     RTE_SCT_IN_1_PIN) ? LEVEL_TAG : 0;
+  }
+}
@@ -0,0 +1,215 @@
+/***************************************************************************/ /**
+ * @file stream_stats.c
+ * @brief Streaming statistics of measured periods
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "stream_stats.h"
+
+#include <math.h>
+#include <string.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SNAPSHOT_ATTEMPTS 4 // Copies tried before giving up on a busy writer
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static void add_sample(stream_stats_t *stats, uint32_t sample);
+static void add_square(stream_stats_t *stats, uint64_t *sum, uint64_t square);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Initializes the statistics.
+ ******************************************************************************/
+void stream_stats_init(stream_stats_t *stats, uint32_t bin_width)
+{
+  memset(stats, 0, sizeof(*stats));
+  stats->bin_width = bin_width;
+  stats->min = UINT32_MAX;
+}
+
+/*******************************************************************************
+ * Clears the samples, the bin width is kept.
+ ******************************************************************************/
+void stream_stats_reset(stream_stats_t *stats)
+{
+  uint32_t sequence = stats->sequence;
+
+  stats->sequence = sequence + 1;
+  __DMB();
+  stats->count = 0;
+  stats->min = UINT32_MAX;
+  stats->max = 0;
+  stats->jitter_max = 0;
+  stats->deviation_sum = 0;
+  stats->deviation_square_sum = 0;
+  stats->jitter_square_sum = 0;
+  stats->saturated = false;
+  memset(stats->histogram, 0, sizeof(stats->histogram));
+  __DMB();
+  stats->sequence = sequence + 2;
+}
+
+/*******************************************************************************
+ * Adds a batch of samples.
+ ******************************************************************************/
+void stream_stats_add_batch(stream_stats_t *stats,
+                            const uint32_t *samples,
+                            uint32_t count)
+{
+  uint32_t sequence = stats->sequence;
+
+  if (count == 0) {
+    return;
+  }
+  // A reader seeing an odd sequence, or a different one after its copy,
+  // discards the copy.
+  stats->sequence = sequence + 1;
+  __DMB();
+  for (uint32_t index = 0; index < count; index++) {
+    add_sample(stats, samples[index]);
+  }
+  __DMB();
+  stats->sequence = sequence + 2;
+}
+
+/*******************************************************************************
+ * Takes a snapshot of the statistics.
+ ******************************************************************************/
+bool stream_stats_get_snapshot(const stream_stats_t *stats,
+                               stream_stats_snapshot_t *snapshot)
+{
+  stream_stats_t copy;
+  uint32_t sequence = 0;
+  bool consistent = false;
+  double count = 0;
+  double mean_deviation = 0;
+  double variance = 0;
+
+  // The writer may be the interrupted context, so the number of attempts is
+  // bounded.
+  for (uint32_t attempt = 0; (attempt < SNAPSHOT_ATTEMPTS) && !consistent;
+       attempt++) {
+    sequence = stats->sequence;
+    __DMB();
+    memcpy(&copy, (const void *)stats, sizeof(copy));
+    __DMB();
+    consistent = ((sequence & 1) == 0) && (sequence == stats->sequence);
+  }
+  if (!consistent) {
+    return false;
+  }
+
+  memset(snapshot, 0, sizeof(*snapshot));
+  snapshot->count = copy.count;
+  snapshot->bin_width = copy.bin_width;
+  snapshot->histogram_start = copy.histogram_start;
+  memcpy(snapshot->histogram, copy.histogram, sizeof(snapshot->histogram));
+  if (copy.count == 0) {
+    return true;
+  }
+  snapshot->min = copy.min;
+  snapshot->max = copy.max;
+  snapshot->jitter_max = copy.jitter_max;
+  count = (double)copy.count;
+  mean_deviation = (double)copy.deviation_sum / count;
+  snapshot->mean = (double)copy.reference + mean_deviation;
+  snapshot->saturated = copy.saturated;
+  if ((copy.count > 1) && !copy.saturated) {
+    variance = ((double)copy.deviation_square_sum
+                - (mean_deviation * (double)copy.deviation_sum))
+               / (count - 1);
+    snapshot->std_dev = (variance > 0) ? sqrt(variance) : 0;
+    snapshot->jitter_rms = sqrt((double)copy.jitter_square_sum / (count - 1));
+  }
+  return true;
+}
+
+/*******************************************************************************
+ * Function to add one sample, called with the sequence odd.
+ * The histogram is centered on the first sample, or starts at 0 when the
+ * first sample is below half its span. The end bins also count the samples
+ * out of range.
+ *
+ * @param[in,out] stats (stream_stats_t) Statistics to update.
+ * @param[in] sample (uint32_t) Sample to add.
+ * @return none
+ ******************************************************************************/
+static void add_sample(stream_stats_t *stats, uint32_t sample)
+{
+  int64_t deviation = 0;
+  uint64_t magnitude = 0;
+  int64_t offset = 0;
+  uint32_t jitter = 0;
+  uint32_t bin = 0;
+  uint32_t half_span = (STREAM_STATS_HISTOGRAM_BINS / 2) * stats->bin_width;
+
+  if (stats->count == 0) {
+    stats->reference = sample;
+    stats->histogram_start = (sample > half_span) ? (sample - half_span) : 0;
+  } else {
+    jitter = (sample > stats->previous) ? (sample - stats->previous)
+             : (stats->previous - sample);
+    if (jitter > stats->jitter_max) {
+      stats->jitter_max = jitter;
+    }
+    add_square(stats, &stats->jitter_square_sum, (uint64_t)jitter * jitter);
+  }
+  stats->previous = sample;
+  stats->count++;
+
+  if (sample < stats->min) {
+    stats->min = sample;
+  }
+  if (sample > stats->max) {
+    stats->max = sample;
+  }
+
+  deviation = (int64_t)sample - stats->reference;
+  magnitude = (deviation < 0) ? (uint64_t)-deviation : (uint64_t)deviation;
+  stats->deviation_sum += deviation;
+  add_square(stats, &stats->deviation_square_sum, magnitude * magnitude);
+
+  // The range check keeps the division on 32 bits.
+  offset = (int64_t)sample - stats->histogram_start;
+  if (offset >= ((int64_t)STREAM_STATS_HISTOGRAM_BINS * stats->bin_width)) {
+    bin = STREAM_STATS_HISTOGRAM_BINS - 1;
+  } else if (offset > 0) {
+    bin = (uint32_t)offset / stats->bin_width;
+  }
+  stats->histogram[bin]++;
+}
+
+/*******************************************************************************
+ * Function to add a square to a sum, saturating at UINT64_MAX instead of
+ * wrapping, which would silently give a wrong deviation.
+ *
+ * @param[in,out] stats (stream_stats_t) Statistics to flag on saturation.
+ * @param[in,out] sum (uint64_t *) Sum of squares to update.
+ * @param[in] square (uint64_t) Square to add.
+ * @return none
+ ******************************************************************************/
+static void add_square(stream_stats_t *stats, uint64_t *sum, uint64_t square)
+{
+  if (square > (UINT64_MAX - *sum)) {
+    *sum = UINT64_MAX;
+    stats->saturated = true;
+  } else {
+    *sum += square;
+  }
+}
@@ -0,0 +1,62 @@
+/***************************************************************************/ /**
+ * @file timer_convert.c
+ * @brief Fixed-point conversion of timer counts to time and frequency
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "timer_convert.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define NANOSECONDS_PER_SECOND 1000000000ULL
+#define MILLIHERTZ_PER_HERTZ   1000ULL
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Computes the count duration, 1e9 / frequency ns in Q32, rounded to nearest.
+ ******************************************************************************/
+void timer_convert_init(timer_convert_t *convert, uint32_t frequency)
+{
+  uint64_t ns_per_count_q32 = ((NANOSECONDS_PER_SECOND << 32) + (frequency / 2))
+                              / frequency;
+
+  convert->frequency = frequency;
+  convert->ns_per_count = (uint32_t)(ns_per_count_q32 >> 32);
+  convert->ns_per_count_frac = (uint32_t)ns_per_count_q32;
+}
+
+/*******************************************************************************
+ * Converts a period to a frequency.
+ ******************************************************************************/
+uint64_t timer_convert_counts_to_millihz(const timer_convert_t *convert,
+                                        uint32_t counts)
+{
+  return (((uint64_t)convert->frequency * MILLIHERTZ_PER_HERTZ) + (counts / 2))
+         / counts;
+}
+
+/*******************************************************************************
+ * Converts a block of counts to nanoseconds.
+ ******************************************************************************/
+void timer_convert_counts_to_ns_batch(const timer_convert_t *convert,
+                                      const uint32_t *counts,
+                                      uint64_t *durations_ns,
+                                      uint32_t length)
+{
+  for (uint32_t index = 0; index < length; index++) {
+    durations_ns[index] = timer_convert_counts_to_ns(convert, counts[index]);
+  }
+}
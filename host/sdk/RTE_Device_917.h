@@ -0,0 +1,46 @@
+/***************************************************************************/ /**
+ * @file RTE_Device_917.h
+ * @brief Host replacement of the pin configuration of the examples
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef RTE_DEVICE_917_H_
+#define RTE_DEVICE_917_H_
+
+// Config timer inputs, on the host pads shared with the M4
+#define RTE_SCT_IN_0_PORT 0
+#define RTE_SCT_IN_0_PIN  25
+#define RTE_SCT_IN_0_MUX  9
+#define RTE_SCT_IN_0_PAD  0
+#define RTE_SCT_IN_1_PORT 0
+#define RTE_SCT_IN_1_PIN  26
+#define RTE_SCT_IN_1_MUX  9
+#define RTE_SCT_IN_1_PAD  1
+#define RTE_SCT_IN_2_PORT 0
+#define RTE_SCT_IN_2_PIN  27
+#define RTE_SCT_IN_2_MUX  9
+#define RTE_SCT_IN_2_PAD  2
+#define RTE_SCT_IN_3_PORT 0
+#define RTE_SCT_IN_3_PIN  28
+#define RTE_SCT_IN_3_MUX  9
+#define RTE_SCT_IN_3_PAD  3
+
+// ULP_I2C pins, on the ULP GPIO block
+#define RTE_I2C2_SCL_PORT 0
+#define RTE_I2C2_SCL_PIN  7
+#define RTE_I2C2_SCL_MUX  4
+#define RTE_I2C2_SDA_PORT 0
+#define RTE_I2C2_SDA_PIN  6
+#define RTE_I2C2_SDA_MUX  4
+
+#endif /* RTE_DEVICE_917_H_ */
@@ -0,0 +1,66 @@
+/***************************************************************************/ /**
+ * @file rsi_ct.h
+ * @brief Host replacement of the config timer driver
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef RSI_CT_H_
+#define RSI_CT_H_
+
+#include "si91x_device.h"
+
+// Counters
+#define COUNTER_0 0
+#define COUNTER_1 1
+
+// CT_GEN_CTRL_SET_REG bits, the counter 1 bits are the upper halves
+#define COUNTER32_BITMODE    BIT(0)
+#define SOFT_RESET_COUNTER_0 BIT(1)
+#define PERIODIC_ENCOUNTER_0 BIT(2)
+#define COUNTER0_TRIG        BIT(3)
+#define COUNTER0_UP          BIT(4)
+#define COUNTER0_DOWN        BIT(5)
+#define COUNTER0_UP_DOWN     (BIT(4) | BIT(5))
+#define COUNTER0_SYNC_TRIG   BIT(6)
+#define SOFT_RESET_COUNTER_1 BIT(17)
+#define PERIODIC_ENCOUNTER_1 BIT(18)
+#define COUNTER1_TRIG        BIT(19)
+#define COUNTER1_UP          BIT(20)
+#define COUNTER1_DOWN        BIT(21)
+#define COUNTER1_UP_DOWN     (BIT(20) | BIT(21))
+#define COUNTER1_SYNC_TRIG   BIT(22)
+
+// Interrupt events of CT_INTR_STS, CT_INTR_MASK and CT_INTR_ACK
+#define RSI_CT_EVENT_INTR_0_l             BIT(0)
+#define RSI_CT_EVENT_FIFO_0_FULL_l        BIT(1)
+#define RSI_CT_EVENT_COUNTER_0_IS_ZERO_l  BIT(2)
+#define RSI_CT_EVENT_COUNTER_0_IS_PEAK_l  BIT(3)
+#define RSI_CT_EVENT_INTR_1_l             BIT(16)
+#define RSI_CT_EVENT_FIFO_1_FULL_l        BIT(17)
+#define RSI_CT_EVENT_COUNTER_1_IS_ZERO_l  BIT(18)
+#define RSI_CT_EVENT_COUNTER_1_IS_PEAK_l  BIT(19)
+
+void RSI_CT_SetControl(CT0_Type *ptr, uint32_t value);
+void RSI_CT_ClearControl(CT0_Type *ptr, uint32_t value);
+void RSI_CT_PeripheralReset(CT0_Type *ptr, boolean_t counter);
+void RSI_CT_SetCount(CT0_Type *ptr, uint32_t count);
+void RSI_CT_StartSoftwareTrig(CT0_Type *ptr, boolean_t counter);
+void RSI_CT_InterruptEnable(CT0_Type *ptr, uint32_t flags);
+void RSI_CT_InterruptDisable(CT0_Type *ptr, uint32_t flags);
+void RSI_CT_InterruptClear(CT0_Type *ptr, uint32_t flags);
+uint32_t RSI_CT_GetInterruptStatus(const CT0_Type *ptr);
+void RSI_CT_InterruptEventSelect(CT0_Type *ptr, uint32_t value);
+void RSI_CT_CaptureEventSelect(CT0_Type *ptr, uint32_t value);
+void RSI_CT_IncrementEventSelect(CT0_Type *ptr, uint32_t value);
+
+#endif /* RSI_CT_H_ */
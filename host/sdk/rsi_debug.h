@@ -0,0 +1,28 @@
+/***************************************************************************/ /**
+ * @file rsi_debug.h
+ * @brief Host replacement of the debug console
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef RSI_DEBUG_H_
+#define RSI_DEBUG_H_
+
+#include <stdio.h>
+
+// The console output goes to stdout and is kept for the tests.
+void sim_console_printf(const char *format, ...)
+__attribute__((format(printf, 1, 2)));
+
+#define DEBUGOUT(...) sim_console_printf(__VA_ARGS__)
+
+#endif /* RSI_DEBUG_H_ */
@@ -0,0 +1,22 @@
+/***************************************************************************/ /**
+ * @file rsi_egpio.h
+ * @brief Host replacement of the GPIO register definitions
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef RSI_EGPIO_H_
+#define RSI_EGPIO_H_
+
+#include "rsi_rom_egpio.h"
+
+#endif /* RSI_EGPIO_H_ */
@@ -0,0 +1,53 @@
+/***************************************************************************/ /**
+ * @file rsi_rom_clks.h
+ * @brief Host replacement of the M4 clock driver
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef RSI_ROM_CLKS_H_
+#define RSI_ROM_CLKS_H_
+
+#include "si91x_device.h"
+
+// Peripherals of RSI_CLK_GetBaseClock()
+#define M4_CT 5
+
+// Config timer clock sources
+#define CT_ULPREFCLK  0
+#define CT_INTFPLLCLK 1
+#define CT_SOCPLLCLK  2
+#define CT_M4SOCCLK   3
+
+#define SCT_CLOCK_DIV_FACT 1 // Config timer clock division factor
+#define ENABLE_STATIC_CLK  1 // Clock gated by software only
+
+// I2C instances of RSI_CLK_I2CClkConfig()
+#define I2C1_INSTAN 0
+#define I2C2_INSTAN 1
+
+// Power domains
+#define M4SS_PWRGATE_ULP_EFUSE_PERI BIT(0)
+#define M4SS_PWRGATE_ULP_PERI1      BIT(1)
+#define M4SS_PWRGATE_ULP_PERI3      BIT(2)
+#define ULPSS_PWRGATE_ULP_I2C       BIT(3)
+
+uint32_t RSI_CLK_GetBaseClock(uint32_t peripheral);
+uint32_t RSI_CLK_CtClkConfig(M4CLK_Type *clock,
+                             uint32_t source,
+                             uint32_t divider,
+                             uint32_t gating);
+uint32_t RSI_CLK_I2CClkConfig(M4CLK_Type *clock, boolean_t enable, uint32_t instance);
+void RSI_PS_M4ssPeriPowerUp(uint32_t domains);
+void RSI_PS_UlpssPeriPowerUp(uint32_t domains);
+
+#endif /* RSI_ROM_CLKS_H_ */
@@ -0,0 +1,33 @@
+/***************************************************************************/ /**
+ * @file rsi_rom_egpio.h
+ * @brief Host replacement of the GPIO driver
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef RSI_ROM_EGPIO_H_
+#define RSI_ROM_EGPIO_H_
+
+#include "si91x_device.h"
+
+#define EGPIO_CONFIG_DIR_OUTPUT 0
+#define EGPIO_CONFIG_DIR_INPUT  1
+
+void RSI_EGPIO_SetPinMux(EGPIO_Type *block, uint8_t port, uint8_t pin, uint8_t mux);
+void RSI_EGPIO_SetDir(EGPIO_Type *block, uint8_t port, uint8_t pin, boolean_t direction);
+void RSI_EGPIO_SetPin(EGPIO_Type *block, uint8_t port, uint8_t pin, uint8_t level);
+boolean_t RSI_EGPIO_GetPin(EGPIO_Type *block, uint8_t port, uint8_t pin);
+void RSI_EGPIO_PadReceiverEnable(uint8_t pin);
+void RSI_EGPIO_UlpPadReceiverEnable(uint8_t pin);
+void RSI_EGPIO_HostPadsGpioModeEnable(uint8_t pin);
+
+#endif /* RSI_ROM_EGPIO_H_ */
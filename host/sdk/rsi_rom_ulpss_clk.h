@@ -0,0 +1,37 @@
+/***************************************************************************/ /**
+ * @file rsi_rom_ulpss_clk.h
+ * @brief Host replacement of the ULP clock driver
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef RSI_ROM_ULPSS_CLK_H_
+#define RSI_ROM_ULPSS_CLK_H_
+
+#include "si91x_device.h"
+
+#define ULP_I2C_CLK      0 // ULP_I2C clock of RSI_ULPSS_PeripheralEnable()
+#define ULP_PROC_SOC_CLK 3 // SoC clock as the ULP processor clock
+
+uint32_t RSI_ULPSS_PeripheralEnable(ULPCLK_Type *clock,
+                                    uint32_t peripheral,
+                                    uint32_t gating);
+uint32_t RSI_ULPSS_ClockConfig(M4CLK_Type *clock,
+                               boolean_t enable,
+                               uint16_t divider,
+                               boolean_t odd_divider);
+uint32_t RSI_ULPSS_UlpProcClkConfig(ULPCLK_Type *clock,
+                                    uint32_t source,
+                                    uint16_t divider,
+                                    uint32_t delay);
+
+#endif /* RSI_ROM_ULPSS_CLK_H_ */
@@ -0,0 +1,262 @@
+/***************************************************************************/ /**
+ * @file si91x_device.h
+ * @brief Host replacement of the SiWx91x device header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef SI91X_DEVICE_H_
+#define SI91X_DEVICE_H_
+
+// Only the parts of the device header used by the examples are provided. The
+// peripherals are simulated by host/sim: CT0 and ULP_I2C are mapped at their
+// device addresses and every access to them is trapped, the other register
+// blocks are plain memory. The core intrinsics and the NVIC drive a virtual
+// core clock and the interrupt dispatch of the simulation.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "RTE_Device_917.h"
+
+#ifndef BIT
+#define BIT(x) (1UL << (x))
+#endif
+#ifndef ENABLE
+#define ENABLE  1
+#define DISABLE 0
+#endif
+
+typedef int boolean_t;
+
+// -----------------------------------------------------------------------------
+// Interrupts
+
+typedef enum {
+  ULPSS_UDMA_IRQn = 10, // ULP DMA, the completion callbacks
+  I2C2_IRQn       = 13, // ULP_I2C
+  SYSRTC_IRQn     = 28, // Sleep timer
+  CT_IRQn         = 34, // Config timer 0
+} IRQn_Type;
+
+#define SIM_IRQ_COUNT 64 // Interrupt lines of the simulated NVIC
+
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_SetPendingIRQ(IRQn_Type irq);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+uint32_t NVIC_GetPriority(IRQn_Type irq);
+
+// -----------------------------------------------------------------------------
+// Core intrinsics
+
+#define __STATIC_INLINE static inline
+#define __IM  volatile const
+#define __OM  volatile
+#define __IOM volatile
+
+// Memory barriers only order the compiler, the simulation is single threaded.
+#define __DMB() __asm__ volatile ("" ::: "memory")
+#define __DSB() __DMB()
+#define __ISB() __DMB()
+#define __NOP() sim_core_nop()
+#define __WFI() sim_core_wait_for_interrupt()
+#define __CLZ(value) ((uint32_t)((value) ? __builtin_clz(value) : 32))
+
+void sim_core_nop(void);
+void sim_core_wait_for_interrupt(void);
+void __enable_irq(void);
+void __disable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+uint32_t __get_IPSR(void);
+// The exclusive monitor is cleared by every exception entry and return, as
+// on the core, so a store interrupted by a handler fails and is retried.
+uint32_t __LDREXW(volatile uint32_t *address);
+uint32_t __STREXW(uint32_t value, volatile uint32_t *address);
+void __CLREX(void);
+
+// -----------------------------------------------------------------------------
+// Debug unit, every read of DWT advances the virtual core clock
+
+typedef struct {
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+  volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk     (1UL << 0)
+
+DWT_Type *sim_core_dwt(void);
+extern CoreDebug_Type sim_core_debug;
+#define DWT       (sim_core_dwt())
+#define CoreDebug (&sim_core_debug)
+
+// -----------------------------------------------------------------------------
+// Config timer
+
+typedef struct {
+  volatile uint32_t CT_GEN_CTRL_SET_REG;           // 0x00
+  volatile uint32_t CT_GEN_CTRL_RESET_REG;         // 0x04
+  volatile uint32_t CT_INTR_STS;                   // 0x08
+  volatile uint32_t CT_INTR_MASK;                  // 0x0C
+  volatile uint32_t CT_INTR_UNMASK;                // 0x10
+  volatile uint32_t CT_INTR_ACK;                   // 0x14
+  volatile uint32_t CT_MATCH_REG;                  // 0x18
+  volatile uint32_t CT_MATCH_BUF_REG;              // 0x1C
+  volatile uint32_t CT_CAPTURE_REG;                // 0x20
+  volatile uint32_t CT_COUNTER_REG;                // 0x24
+  volatile uint32_t CT_OCU_CTRL_REG;               // 0x28
+  volatile uint32_t CT_OCU_COMPARE_REG;            // 0x2C
+  volatile uint32_t CT_OCU_COMPARE2_REG;           // 0x30
+  volatile uint32_t CT_OCU_SYNC_REG;               // 0x34
+  volatile uint32_t CT_OCU_COMPARE_NXT_REG;        // 0x38
+  volatile uint32_t CT_WFG_CTRL_REG;               // 0x3C
+  volatile uint32_t CT_OCU_DMA_CTRL_REG;           // 0x40
+  volatile uint32_t CT_OCU_ADDR_REG;               // 0x44
+  volatile uint32_t CT_OCU_DATA_REG;               // 0x48
+  volatile uint32_t CT_START_COUNTER_EVENT_SEL;    // 0x4C
+  volatile uint32_t CT_START_COUNTER_AND_EVENT;    // 0x50
+  volatile uint32_t CT_START_COUNTER_OR_EVENT;     // 0x54
+  volatile uint32_t CT_CONTINUE_COUNTER_EVENT_SEL; // 0x58
+  volatile uint32_t CT_CONTINUE_COUNTER_AND_EVENT; // 0x5C
+  volatile uint32_t CT_CONTINUE_COUNTER_OR_EVENT;  // 0x60
+  volatile uint32_t CT_STOP_COUNTER_EVENT_SEL;     // 0x64
+  volatile uint32_t CT_STOP_COUNTER_AND_EVENT;     // 0x68
+  volatile uint32_t CT_STOP_COUNTER_OR_EVENT;      // 0x6C
+  volatile uint32_t CT_HALT_COUNTER_EVENT_SEL;     // 0x70
+  volatile uint32_t CT_HALT_COUNTER_AND_EVENT;     // 0x74
+  volatile uint32_t CT_HALT_COUNTER_OR_EVENT;      // 0x78
+  volatile uint32_t CT_INCREMENT_COUNTER_EVENT_SEL; // 0x7C
+  volatile uint32_t CT_INCREMENT_COUNTER_AND_EVENT; // 0x80
+  volatile uint32_t CT_INCREMENT_COUNTER_OR_EVENT; // 0x84
+  volatile uint32_t CT_CAPTURE_COUNTER_EVENT_SEL;  // 0x88
+  volatile uint32_t CT_CAPTURE_COUNTER_AND_EVENT;  // 0x8C
+  volatile uint32_t CT_CAPTURE_COUNTER_OR_EVENT;   // 0x90
+  volatile uint32_t CT_OUTPUT_EVENT1_ADC_SEL;      // 0x94
+  volatile uint32_t CT_OUTPUT_EVENT2_ADC_SEL;      // 0x98
+  volatile uint32_t CT_INTR_EVENT_SEL;             // 0x9C
+  volatile uint32_t CT_INTR_AND_EVENT;             // 0xA0
+  volatile uint32_t CT_INTR_OR_EVENT;              // 0xA4
+  volatile uint32_t CT_RE_START_COUNTER_EVENT_SEL; // 0xA8
+  volatile uint32_t CT_RE_START_COUNTER_AND_EVENT; // 0xAC
+  volatile uint32_t CT_RE_START_COUNTER_OR_EVENT;  // 0xB0
+} CT0_Type;
+
+#define CT0_BASE 0x45060000UL
+#define CT0      ((CT0_Type *)CT0_BASE)
+
+// -----------------------------------------------------------------------------
+// ULP_I2C, DesignWare register map
+
+typedef struct {
+  volatile uint32_t IC_CON;                // 0x00
+  volatile uint32_t IC_TAR;                // 0x04
+  volatile uint32_t IC_SAR;                // 0x08
+  volatile uint32_t IC_HS_MADDR;           // 0x0C
+  union {
+    volatile uint32_t IC_DATA_CMD;         // 0x10
+    struct {
+      volatile uint32_t DAT : 8;           // Data byte
+      volatile uint32_t CMD : 1;           // Read command
+      volatile uint32_t STOP : 1;          // Stop after the byte
+      volatile uint32_t RESTART : 1;       // Restart before the byte
+      volatile uint32_t FIRST_DATA_BYTE : 1;
+      uint32_t : 20;
+    } IC_DATA_CMD_b;
+  };
+  volatile uint32_t IC_SS_SCL_HCNT;        // 0x14
+  volatile uint32_t IC_SS_SCL_LCNT;        // 0x18
+  volatile uint32_t IC_FS_SCL_HCNT;        // 0x1C
+  volatile uint32_t IC_FS_SCL_LCNT;        // 0x20
+  volatile uint32_t IC_HS_SCL_HCNT;        // 0x24
+  volatile uint32_t IC_HS_SCL_LCNT;        // 0x28
+  volatile uint32_t IC_INTR_STAT;          // 0x2C
+  volatile uint32_t IC_INTR_MASK;          // 0x30
+  volatile uint32_t IC_RAW_INTR_STAT;      // 0x34
+  volatile uint32_t IC_RX_TL;              // 0x38
+  volatile uint32_t IC_TX_TL;              // 0x3C
+  volatile uint32_t IC_CLR_INTR;           // 0x40
+  volatile uint32_t IC_CLR_RX_UNDER;       // 0x44
+  volatile uint32_t IC_CLR_RX_OVER;        // 0x48
+  volatile uint32_t IC_CLR_TX_OVER;        // 0x4C
+  volatile uint32_t IC_CLR_RD_REQ;         // 0x50
+  volatile uint32_t IC_CLR_TX_ABRT;        // 0x54
+  volatile uint32_t IC_CLR_RX_DONE;        // 0x58
+  volatile uint32_t IC_CLR_ACTIVITY;       // 0x5C
+  volatile uint32_t IC_CLR_STOP_DET;       // 0x60
+  volatile uint32_t IC_CLR_START_DET;      // 0x64
+  volatile uint32_t IC_CLR_GEN_CALL;       // 0x68
+  volatile uint32_t IC_ENABLE;             // 0x6C
+  volatile uint32_t IC_STATUS;             // 0x70
+  volatile uint32_t IC_TXFLR;              // 0x74
+  volatile uint32_t IC_RXFLR;              // 0x78
+  volatile uint32_t IC_SDA_HOLD;           // 0x7C
+  volatile uint32_t IC_TX_ABRT_SOURCE;     // 0x80
+  volatile uint32_t IC_SLV_DATA_NACK_ONLY; // 0x84
+  volatile uint32_t IC_DMA_CR;             // 0x88
+  volatile uint32_t IC_DMA_TDLR;           // 0x8C
+  volatile uint32_t IC_DMA_RDLR;           // 0x90
+} I2C0_Type;
+
+typedef I2C0_Type I2C_TypeDef;
+
+// Only ULP_I2C is simulated, the other instances are never accessed.
+#define I2C0_BASE     0x44010000UL
+#define I2C1_BASE     0x47040000UL
+#define I2C2_BASE     0x24040000UL
+#define ULP_I2C_BASE  I2C2_BASE
+#define I2C0          ((I2C0_Type *)I2C0_BASE)
+#define I2C1          ((I2C0_Type *)I2C1_BASE)
+#define ULP_I2C       ((I2C0_Type *)ULP_I2C_BASE)
+
+// -----------------------------------------------------------------------------
+// GPIO and clocks, plain memory
+
+typedef struct {
+  uint32_t pin_mode[4][64]; // Pin mux mode written by the driver
+} EGPIO_Type;
+
+typedef struct {
+  struct {
+    volatile uint32_t EGPIO_PCLK_ENABLE_b : 1;
+  } CLK_ENABLE_SET_REG2_b;
+  struct {
+    volatile uint32_t EGPIO_CLK_ENABLE_b : 1;
+  } CLK_ENABLE_SET_REG3_b;
+} M4CLK_Type;
+
+typedef struct {
+  volatile uint32_t ULP_I2C_CLK_ENABLE;
+} ULPCLK_Type;
+
+extern EGPIO_Type sim_egpio_blocks[2];
+extern M4CLK_Type sim_m4clk;
+extern ULPCLK_Type sim_ulpclk;
+#define EGPIO  (&sim_egpio_blocks[0])
+#define EGPIO1 (&sim_egpio_blocks[1])
+#define M4CLK  (&sim_m4clk)
+#define ULPCLK (&sim_ulpclk)
+
+// Clock frequencies read by the drivers
+struct system_clocks_s {
+  uint32_t soc_clock;
+  uint32_t ulpss_ref_clk;
+};
+extern struct system_clocks_s system_clocks;
+
+#endif /* SI91X_DEVICE_H_ */
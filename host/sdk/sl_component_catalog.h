@@ -0,0 +1,23 @@
+/***************************************************************************/ /**
+ * @file sl_component_catalog.h
+ * @brief Host replacement of the component catalog
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef SL_COMPONENT_CATALOG_H_
+#define SL_COMPONENT_CATALOG_H_
+
+// No kernel is simulated. The power manager is left out, a test defines
+// SL_CATALOG_POWER_MANAGER_PRESENT to sleep in the super loop.
+
+#endif /* SL_COMPONENT_CATALOG_H_ */
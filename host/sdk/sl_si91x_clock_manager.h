@@ -0,0 +1,25 @@
+/***************************************************************************/ /**
+ * @file sl_si91x_clock_manager.h
+ * @brief Host replacement of the clock manager
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef SL_SI91X_CLOCK_MANAGER_H_
+#define SL_SI91X_CLOCK_MANAGER_H_
+
+#include "si91x_device.h"
+#include "sl_status.h"
+
+sl_status_t sl_si91x_clock_manager_m4_get_core_clk_src_freq(uint32_t *frequency);
+
+#endif /* SL_SI91X_CLOCK_MANAGER_H_ */
@@ -0,0 +1,91 @@
+/***************************************************************************/ /**
+ * @file sl_si91x_dma.h
+ * @brief Host replacement of the DMA driver
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef SL_SI91X_DMA_H_
+#define SL_SI91X_DMA_H_
+
+#include <stdint.h>
+#include "si91x_device.h"
+#include "sl_status.h"
+
+#define SL_DMA_CHANNEL_COUNT 32 // Channels of an instance
+
+// ULP DMA channels of the ULP_I2C FIFOs, as used by the SDK I2C driver. Each
+// request is wired to one channel and the signal of a transfer is its
+// channel number.
+#define SL_ULP_I2C_DMA_TX_CHANNEL 5
+#define SL_ULP_I2C_DMA_RX_CHANNEL 4
+
+// Transfer types
+#define SL_DMA_MEMORY_TO_MEMORY     0
+#define SL_DMA_MEMORY_TO_PERIPHERAL 1
+#define SL_DMA_PERIPHERAL_TO_MEMORY 2
+
+// Address increments
+#define SRC_INC_8     0
+#define SRC_INC_16    1
+#define SRC_INC_32    2
+#define SRC_INC_NONE  3
+#define DST_INC_8     0
+#define DST_INC_16    1
+#define DST_INC_32    2
+#define DST_INC_NONE  3
+
+// Element sizes
+#define SRC_SIZE_8  0
+#define SRC_SIZE_16 1
+#define SRC_SIZE_32 2
+
+// Modes
+#define UDMA_MODE_BASIC    1
+#define UDMA_MODE_PINGPONG 3
+
+typedef struct {
+  uint32_t dma_number; // DMA instance, 0 for the M4 DMA, 1 for the ULP DMA
+} sl_dma_init_t;
+
+typedef void (*sl_dma_callback_t_fn)(uint32_t channel, void *data);
+
+typedef struct {
+  sl_dma_callback_t_fn transfer_complete_cb; // Called once the transfer is done
+  sl_dma_callback_t_fn error_cb;             // Called on a bus error
+} sl_dma_callback_t;
+
+typedef struct {
+  uint32_t *src_addr;      // Source address
+  uint32_t *dest_addr;     // Destination address
+  uint8_t src_inc;         // Source increment
+  uint8_t dst_inc;         // Destination increment
+  uint8_t xfer_size;       // Element size
+  uint32_t transfer_count; // Number of elements
+  uint8_t transfer_type;   // Memory or peripheral flow
+  uint8_t dma_mode;        // Basic or ping-pong
+  uint8_t signal;          // Peripheral request served by the channel
+} sl_dma_xfer_t;
+
+sl_status_t sl_si91x_dma_init(sl_dma_init_t *dma_init);
+sl_status_t sl_si91x_dma_allocate_channel(uint32_t dma_number,
+                                          uint32_t *channel_no,
+                                          uint32_t priority);
+sl_status_t sl_si91x_dma_register_callbacks(uint32_t dma_number,
+                                            uint32_t channel_no,
+                                            sl_dma_callback_t *callbacks);
+sl_status_t sl_si91x_dma_transfer(uint32_t dma_number,
+                                  uint32_t channel_no,
+                                  sl_dma_xfer_t *dma_transfer);
+sl_status_t sl_si91x_dma_stop_transfer(uint32_t dma_number, uint32_t channel_no);
+
+#endif /* SL_SI91X_DMA_H_ */
@@ -0,0 +1,84 @@
+/***************************************************************************/ /**
+ * @file sl_si91x_peripheral_i2c.h
+ * @brief Host replacement of the I2C peripheral driver
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef SL_SI91X_PERIPHERAL_I2C_H_
+#define SL_SI91X_PERIPHERAL_I2C_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "si91x_device.h"
+#include "sl_status.h"
+
+// Interrupt events, the bits of IC_INTR_MASK and IC_INTR_STAT
+#define SL_I2C_EVENT_RECEIVE_UNDER      BIT(0)
+#define SL_I2C_EVENT_RECEIVE_OVER       BIT(1)
+#define SL_I2C_EVENT_RECEIVE_FULL       BIT(2)
+#define SL_I2C_EVENT_TRANSMIT_OVER      BIT(3)
+#define SL_I2C_EVENT_TRANSMIT_EMPTY     BIT(4)
+#define SL_I2C_EVENT_READ_REQ           BIT(5)
+#define SL_I2C_EVENT_TRANSMIT_ABORT     BIT(6)
+#define SL_I2C_EVENT_RECEIVE_DONE       BIT(7)
+#define SL_I2C_EVENT_ACTIVITY_ON_BUS    BIT(8)
+#define SL_I2C_EVENT_STOP_DETECT        BIT(9)
+#define SL_I2C_EVENT_START_DETECT       BIT(10)
+#define SL_I2C_EVENT_GENERAL_CALL       BIT(11)
+#define SL_I2C_EVENT_RESTART_DET        BIT(12)
+#define SL_I2C_EVENT_MST_ON_HOLD        BIT(13)
+#define SL_I2C_EVENT_SCL_STUCK_AT_LOW   BIT(14)
+
+// Bus speeds
+typedef enum {
+  SL_I2C_STANDARD_BUS_SPEED,  // 100 kHz
+  SL_I2C_FAST_BUS_SPEED,      // 400 kHz
+  SL_I2C_FAST_PLUS_BUS_SPEED, // 1 MHz
+  SL_I2C_HIGH_BUS_SPEED,      // 3.4 MHz
+} sl_i2c_bus_speed_t;
+
+// Modes
+#define SL_I2C_LEADER_MODE   1
+#define SL_I2C_FOLLOWER_MODE 0
+
+typedef struct {
+  uint32_t clhr; // Bus speed, sl_i2c_bus_speed_t
+  uint32_t freq; // Reference clock of the controller, in Hz
+  uint32_t mode; // Leader or follower
+} sl_i2c_init_params_t;
+
+// Pin configuration
+typedef struct {
+  uint8_t port;
+  uint8_t pin;
+  uint8_t mode;
+  uint8_t pad_sel;
+} const I2C_PIN;
+
+void sl_si91x_i2c_init(I2C0_Type *i2c, const sl_i2c_init_params_t *params);
+void sl_si91x_i2c_enable(I2C0_Type *i2c);
+void sl_si91x_i2c_disable(I2C0_Type *i2c);
+void sl_si91x_i2c_abort_transfer(I2C0_Type *i2c);
+void sl_si91x_i2c_set_follower_address(I2C0_Type *i2c,
+                                       uint16_t address,
+                                       bool is_10bit_addr);
+void sl_si91x_i2c_set_tx_threshold(I2C0_Type *i2c, uint8_t threshold);
+void sl_si91x_i2c_set_rx_threshold(I2C0_Type *i2c, uint8_t threshold);
+void sl_si91x_i2c_set_interrupts(I2C0_Type *i2c, uint32_t flags);
+void sl_si91x_i2c_enable_interrupts(I2C0_Type *i2c, uint32_t flags);
+void sl_si91x_i2c_disable_interrupts(I2C0_Type *i2c, uint32_t flags);
+void sl_si91x_i2c_clear_interrupts(I2C0_Type *i2c, uint32_t flags);
+void sl_si91x_i2c_tx(I2C0_Type *i2c, uint8_t data);
+uint8_t sl_si91x_i2c_rx(I2C0_Type *i2c);
+
+#endif /* SL_SI91X_PERIPHERAL_I2C_H_ */
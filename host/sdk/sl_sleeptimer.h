@@ -0,0 +1,51 @@
+/***************************************************************************/ /**
+ * @file sl_sleeptimer.h
+ * @brief Host replacement of the sleep timer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef SL_SLEEPTIMER_H_
+#define SL_SLEEPTIMER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sl_status.h"
+
+typedef struct sl_sleeptimer_timer_handle sl_sleeptimer_timer_handle_t;
+
+typedef void (*sl_sleeptimer_timer_callback_t)(sl_sleeptimer_timer_handle_t *handle,
+                                               void *data);
+
+struct sl_sleeptimer_timer_handle {
+  void *callback_data;
+  sl_sleeptimer_timer_callback_t callback;
+  uint64_t expiry;                       // Virtual core cycle of the expiry
+  bool running;
+  sl_sleeptimer_timer_handle_t *next;
+};
+
+// The timer counts a 32768 Hz clock, a delay in milliseconds is truncated to
+// whole ticks, counted from the current tick.
+#define SL_SLEEPTIMER_FREQUENCY 32768
+
+sl_status_t sl_sleeptimer_restart_timer_ms(sl_sleeptimer_timer_handle_t *handle,
+                                           uint32_t timeout_ms,
+                                           sl_sleeptimer_timer_callback_t callback,
+                                           void *callback_data,
+                                           uint8_t priority,
+                                           uint16_t option_flags);
+sl_status_t sl_sleeptimer_stop_timer(sl_sleeptimer_timer_handle_t *handle);
+sl_status_t sl_sleeptimer_is_timer_running(sl_sleeptimer_timer_handle_t *handle,
+                                           bool *running);
+
+#endif /* SL_SLEEPTIMER_H_ */
@@ -0,0 +1,38 @@
+/***************************************************************************/ /**
+ * @file sl_status.h
+ * @brief Host replacement of the status codes
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef SL_STATUS_H_
+#define SL_STATUS_H_
+
+#include <stdint.h>
+
+typedef uint32_t sl_status_t;
+
+#define SL_STATUS_OK                 0x0000
+#define SL_STATUS_FAIL               0x0001
+#define SL_STATUS_INVALID_STATE      0x0002
+#define SL_STATUS_NOT_READY          0x0003
+#define SL_STATUS_BUSY               0x0004
+#define SL_STATUS_ABORT              0x0006
+#define SL_STATUS_TIMEOUT            0x0007
+#define SL_STATUS_EMPTY              0x000A
+#define SL_STATUS_FULL               0x000B
+#define SL_STATUS_NOT_INITIALIZED    0x0011
+#define SL_STATUS_INVALID_PARAMETER  0x0021
+#define SL_STATUS_BUS_ERROR          0x0043
+#define SL_STATUS_TRANSMIT           0x0048
+
+#endif /* SL_STATUS_H_ */
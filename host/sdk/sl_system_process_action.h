@@ -0,0 +1,22 @@
+/***************************************************************************/ /**
+ * @file sl_system_process_action.h
+ * @brief Host replacement of the system process action interface
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef SL_SYSTEM_PROCESS_ACTION_H_
+#define SL_SYSTEM_PROCESS_ACTION_H_
+
+void sl_system_process_action(void);
+
+#endif /* SL_SYSTEM_PROCESS_ACTION_H_ */
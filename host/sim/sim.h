@@ -0,0 +1,154 @@
+/***************************************************************************/ /**
+ * @file sim.h
+ * @brief Host simulation of the SiWx917 peripherals used by the examples
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef SIM_H_
+#define SIM_H_
+
+// The simulation runs the unmodified example and common sources on the host.
+// Time is a virtual core clock: it advances with every modelled register
+// access, driver call, interrupt entry and exit and cycle counter read, and
+// while the core waits for an interrupt. The costs are modelled, not
+// measured, the cycle figures of a simulation only compare code paths.
+//
+// Interrupts are dispatched at the points where the examples can observe
+// them: cycle counter reads, driver and NVIC calls, unmasking and waiting.
+// They follow the NVIC priorities and PRIMASK, and the lines of the
+// peripherals are level sensitive.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "si91x_device.h"
+
+// -----------------------------------------------------------------------------
+// Defines
+
+#define SIM_CORE_FREQUENCY     180000000UL // Default core clock, in Hz
+#define SIM_CT_FREQUENCY       40000000UL  // Default config timer clock, in Hz
+#define SIM_ULPSS_REF_FREQUENCY 40000000UL // ULP reference clock, in Hz
+#define SIM_PS_PER_SECOND      1000000000000ULL
+#define SIM_NEVER              UINT64_MAX
+#define SIM_WAIT_LIMIT_US      1000        // Longest wait for an interrupt, WFI returns after it
+
+// Modelled costs, in core cycles
+#define SIM_CYCLES_ISR_ENTRY       12 // Exception entry, registers stacked
+#define SIM_CYCLES_ISR_EXIT        12 // Exception return
+#define SIM_CYCLES_REGISTER_ACCESS 2  // Peripheral register access
+#define SIM_CYCLES_DRIVER_CALL     8  // Driver function call
+#define SIM_CYCLES_DWT_READ        1  // Cycle counter read
+
+#define SIM_CT_INPUTS          4    // SCT_IN_0 to SCT_IN_3
+#define SIM_I2C_FOLLOWER_SIZE  4096 // Bytes of the simulated I2C follower
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Next edge of the config timer inputs, in time order. Each edge toggles the
+// level of its input. Returns false when no edge follows.
+typedef bool (*sim_ct_edge_source_t)(void *context,
+                                     uint64_t *time_ps,
+                                     uint8_t *input);
+
+// Square wave on one input, see sim_ct_square_wave()
+typedef struct {
+  uint8_t input;      // Config timer input
+  uint64_t high_ps;   // High time
+  uint64_t low_ps;    // Low time
+  uint64_t next_ps;   // Time of the next edge
+  bool level;         // Level after the next edge is the opposite
+} sim_square_wave_t;
+
+// Called once per pass of the super loop, from sl_system_process_action().
+// The loop stops when it returns false.
+typedef bool (*sim_main_hook_t)(void *context, uint32_t pass);
+
+// I2C bus activity, one entry per condition or byte
+typedef enum {
+  SIM_I2C_START,   // Start, then the address byte, value is the address << 1 | read
+  SIM_I2C_RESTART, // Repeated start, then the address byte
+  SIM_I2C_WRITE,   // Data byte written to the follower
+  SIM_I2C_READ,    // Data byte read from the follower
+  SIM_I2C_NACK,    // Address not acknowledged
+  SIM_I2C_STOP,    // Stop
+} sim_i2c_log_type_t;
+
+typedef struct {
+  sim_i2c_log_type_t type;
+  uint8_t value;
+} sim_i2c_log_entry_t;
+
+// Faults injected in the I2C follower
+typedef struct {
+  bool absent;               // The address is not acknowledged
+  uint32_t stall_after_bytes; // Bytes transferred before SCL is held low, 0 for never
+  uint32_t sda_stuck_clocks; // After a stall, SCL pulses needed before SDA is released
+} sim_i2c_faults_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+// Clocks, set before the example is initialized. The core clock may change
+// later for a test of the core alone, the peripherals and sim_get_time_ps()
+// assume it never changes.
+void sim_set_core_frequency(uint32_t frequency);
+void sim_set_ct_frequency(uint32_t frequency);
+uint32_t sim_get_core_frequency(void);
+uint32_t sim_get_ct_frequency(void);
+
+// Virtual time
+uint64_t sim_get_cycles(void);
+uint64_t sim_get_time_ps(void);
+uint64_t sim_us_to_cycles(uint64_t microseconds);
+void sim_advance(uint64_t cycles);
+void sim_advance_us(uint64_t microseconds);
+
+// Super loop. The build renames the main() of the example, sim_run_main()
+// runs it until the hook stops the loop and then returns.
+void sim_run_main(int (*entry)(void), sim_main_hook_t hook, void *context);
+uint32_t sim_get_sleep_count(void);
+uint64_t sim_get_sleep_cycles(void);
+
+// Interrupts
+uint64_t sim_get_isr_cycles(void);
+uint32_t sim_get_irq_count(IRQn_Type irq);
+void sim_clear_isr_stats(void);
+
+// Config timer inputs. The levels are set before the first edge.
+void sim_ct_set_input_level(uint8_t input, bool level);
+bool sim_ct_get_input_level(uint8_t input);
+void sim_ct_set_edge_source(sim_ct_edge_source_t source, void *context);
+void sim_ct_square_wave(sim_square_wave_t *wave,
+                        uint8_t input,
+                        uint64_t period_ps,
+                        uint64_t high_ps,
+                        uint64_t start_ps);
+bool sim_ct_square_wave_source(void *context, uint64_t *time_ps, uint8_t *input);
+
+// I2C follower and bus
+void sim_i2c_set_follower_address(uint8_t address);
+void sim_i2c_set_faults(const sim_i2c_faults_t *faults);
+const uint8_t *sim_i2c_get_follower_memory(void);
+size_t sim_i2c_get_log(const sim_i2c_log_entry_t **entries);
+void sim_i2c_clear_log(void);
+// Calls to the configuration functions of the I2C driver: enable, disable,
+// follower address, FIFO thresholds and interrupt masks. Never cleared.
+uint32_t sim_i2c_get_config_writes(void);
+
+// Console
+const char *sim_console_get(void);
+void sim_console_clear(void);
+
+#endif /* SIM_H_ */
@@ -0,0 +1,968 @@
+/***************************************************************************/ /**
+ * @file sim_core.c
+ * @brief Simulated core: virtual clock, NVIC, intrinsics and register traps
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#define _GNU_SOURCE
+#include <setjmp.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+#include "sim_internal.h"
+#include "rsi_debug.h"
+#include "rsi_rom_clks.h"
+#include "rsi_rom_ulpss_clk.h"
+#include "sl_power_manager.h"
+#include "sl_si91x_clock_manager.h"
+#include "sl_sleeptimer.h"
+#include "sl_system_init.h"
+#include "sl_system_kernel.h"
+#include "sl_system_process_action.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define PAGE_SIZE             4096
+#define EFLAGS_TRAP           0x100 // Single step after the trapped access
+#define PAGE_FAULT_WRITE      0x2   // Page fault error code of a write
+#define NO_PRIORITY           0x100 // Below every interrupt priority
+#define NVIC_ACCESS_CYCLES    SIM_CYCLES_REGISTER_ACCESS
+#define EXCEPTION_NUMBER_BASE 16    // IPSR of IRQ 0
+#define CONSOLE_CHUNK         4096
+
+/*******************************************************************************
+ ******************************  Data Types  ***********************************
+ ******************************************************************************/
+// Register block mapped at its device address, every access is trapped
+typedef struct {
+  uintptr_t base;
+  uint32_t (*read)(uint32_t offset, bool side_effects);
+  void (*write)(uint32_t offset, uint32_t value);
+} register_block_t;
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+uint64_t sim_now = 0;
+
+static uint32_t core_frequency = SIM_CORE_FREQUENCY;
+static uint32_t ct_frequency = SIM_CT_FREQUENCY;
+
+static const register_block_t register_blocks[] = {
+  { CT0_BASE, sim_ct_read, sim_ct_write },
+  { ULP_I2C_BASE, sim_i2c_read, sim_i2c_write },
+};
+static const register_block_t *trapped_block = NULL;
+static uint32_t trapped_offset = 0;
+static bool trapped_write = false;
+
+static bool irq_enabled[SIM_IRQ_COUNT];
+static bool irq_pending[SIM_IRQ_COUNT];
+static uint32_t irq_priority[SIM_IRQ_COUNT];
+static uint32_t irq_count[SIM_IRQ_COUNT];
+static IRQn_Type active_irqs[SIM_IRQ_COUNT];
+static uint32_t active_depth = 0;
+static uint32_t primask = 0;
+static uint64_t isr_cycles = 0;
+static uint64_t isr_start = 0;
+static volatile uint32_t *exclusive_address = NULL;
+
+static sl_sleeptimer_timer_handle_t *sleeptimers = NULL;
+
+static jmp_buf main_exit;
+static sim_main_hook_t main_hook = NULL;
+static void *main_context = NULL;
+static uint32_t main_pass = 0;
+static uint32_t sleep_count = 0;
+static uint64_t sleep_cycles = 0;
+
+static char *console = NULL;
+static size_t console_length = 0;
+static size_t console_size = 0;
+
+DWT_Type sim_dwt;
+CoreDebug_Type sim_core_debug;
+EGPIO_Type sim_egpio_blocks[2];
+M4CLK_Type sim_m4clk;
+ULPCLK_Type sim_ulpclk;
+struct system_clocks_s system_clocks = { SIM_CORE_FREQUENCY,
+                                         SIM_ULPSS_REF_FREQUENCY };
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static void map_register_blocks(void) __attribute__((constructor));
+static void on_access_fault(int signal_number, siginfo_t *info, void *context);
+static void on_access_step(int signal_number, siginfo_t *info, void *context);
+static bool irq_line(IRQn_Type irq);
+static void run_handler(IRQn_Type irq);
+static uint32_t current_priority(void);
+static int find_pending_irq(uint32_t below_priority);
+static uint64_t next_event(void);
+static void sleeptimer_remove(sl_sleeptimer_timer_handle_t *handle);
+static bool sleeptimer_line(void);
+static void sleeptimer_irq_handler(void);
+
+void IRQ034_Handler(void) __attribute__((weak));
+void I2C2_IRQHandler(void) __attribute__((weak));
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Default handlers, an example without the handler leaves its line disabled.
+ ******************************************************************************/
+void IRQ034_Handler(void)
+{
+  NVIC_DisableIRQ(CT_IRQn);
+}
+
+void I2C2_IRQHandler(void)
+{
+  NVIC_DisableIRQ(I2C2_IRQn);
+}
+
+/*******************************************************************************
+ * Clocks
+ ******************************************************************************/
+void sim_set_core_frequency(uint32_t frequency)
+{
+  core_frequency = frequency;
+  system_clocks.soc_clock = frequency;
+}
+
+void sim_set_ct_frequency(uint32_t frequency)
+{
+  sim_core_sync();
+  ct_frequency = frequency;
+}
+
+uint32_t sim_get_core_frequency(void)
+{
+  return core_frequency;
+}
+
+uint32_t sim_get_ct_frequency(void)
+{
+  return ct_frequency;
+}
+
+uint64_t sim_ps_to_cycles_ceil(uint64_t ps)
+{
+  unsigned __int128 scaled = (unsigned __int128)ps * core_frequency;
+
+  return (uint64_t)((scaled + SIM_PS_PER_SECOND - 1) / SIM_PS_PER_SECOND);
+}
+
+uint64_t sim_cycles_to_ticks(uint64_t cycles)
+{
+  return (uint64_t)(((unsigned __int128)cycles * ct_frequency)
+                    / core_frequency);
+}
+
+uint64_t sim_ticks_to_cycles_ceil(uint64_t ticks)
+{
+  unsigned __int128 scaled = (unsigned __int128)ticks * core_frequency;
+
+  return (uint64_t)((scaled + ct_frequency - 1) / ct_frequency);
+}
+
+uint64_t sim_ps_to_ticks(uint64_t ps)
+{
+  return (uint64_t)(((unsigned __int128)ps * ct_frequency)
+                    / SIM_PS_PER_SECOND);
+}
+
+/*******************************************************************************
+ * Virtual time
+ ******************************************************************************/
+uint64_t sim_get_cycles(void)
+{
+  return sim_now;
+}
+
+uint64_t sim_get_time_ps(void)
+{
+  return (uint64_t)(((unsigned __int128)sim_now * SIM_PS_PER_SECOND)
+                    / core_frequency);
+}
+
+uint64_t sim_us_to_cycles(uint64_t microseconds)
+{
+  return (microseconds * core_frequency) / 1000000;
+}
+
+void sim_core_sync(void)
+{
+  sim_ct_sync(sim_now);
+  sim_i2c_sync(sim_now);
+}
+
+void sim_core_spend(uint32_t cycles)
+{
+  sim_now += cycles;
+  sim_core_sync();
+}
+
+void sim_core_driver_entry(void)
+{
+  sim_core_spend(SIM_CYCLES_DRIVER_CALL);
+}
+
+void sim_core_driver_exit(void)
+{
+  sim_core_dispatch();
+}
+
+/*******************************************************************************
+ * Runs the code elsewhere for the given time, the interrupts are taken as
+ * their events happen.
+ ******************************************************************************/
+void sim_advance(uint64_t cycles)
+{
+  uint64_t target = sim_now + cycles;
+  uint64_t next = 0;
+
+  sim_core_dispatch();
+  while (sim_now < target) {
+    next = next_event();
+    if (next > target) {
+      next = target;
+    }
+    if (next <= sim_now) {
+      next = sim_now + 1;
+    }
+    sim_now = next;
+    sim_core_sync();
+    sim_core_dispatch();
+  }
+}
+
+void sim_advance_us(uint64_t microseconds)
+{
+  sim_advance(sim_us_to_cycles(microseconds));
+}
+
+/*******************************************************************************
+ * Interrupt statistics
+ ******************************************************************************/
+uint64_t sim_get_isr_cycles(void)
+{
+  return isr_cycles;
+}
+
+uint32_t sim_get_irq_count(IRQn_Type irq)
+{
+  return irq_count[irq];
+}
+
+void sim_clear_isr_stats(void)
+{
+  isr_cycles = 0;
+  memset(irq_count, 0, sizeof(irq_count));
+}
+
+/*******************************************************************************
+ * Dispatches the highest priority pending interrupt until none can preempt
+ * the running code. A lower priority number preempts.
+ ******************************************************************************/
+void sim_core_dispatch(void)
+{
+  int irq = 0;
+
+  while (primask == 0) {
+    irq = find_pending_irq(current_priority());
+    if (irq < 0) {
+      return;
+    }
+    run_handler((IRQn_Type)irq);
+  }
+}
+
+/*******************************************************************************
+ * NVIC
+ ******************************************************************************/
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+  sim_core_spend(NVIC_ACCESS_CYCLES);
+  irq_enabled[irq] = true;
+  sim_core_dispatch();
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq)
+{
+  sim_core_spend(NVIC_ACCESS_CYCLES);
+  irq_enabled[irq] = false;
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type irq)
+{
+  sim_core_spend(NVIC_ACCESS_CYCLES);
+  irq_pending[irq] = true;
+  sim_core_dispatch();
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irq)
+{
+  sim_core_spend(NVIC_ACCESS_CYCLES);
+  irq_pending[irq] = false;
+}
+
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority)
+{
+  sim_core_spend(NVIC_ACCESS_CYCLES);
+  irq_priority[irq] = priority;
+}
+
+uint32_t NVIC_GetPriority(IRQn_Type irq)
+{
+  return irq_priority[irq];
+}
+
+/*******************************************************************************
+ * Intrinsics
+ ******************************************************************************/
+void sim_core_nop(void)
+{
+  sim_core_spend(1);
+}
+
+/*******************************************************************************
+ * Waits for an interrupt able to preempt, even with PRIMASK set, the time
+ * jumps from one peripheral event to the next. The wait is bounded, as an
+ * event the simulation does not model would end it.
+ ******************************************************************************/
+void sim_core_wait_for_interrupt(void)
+{
+  uint64_t limit = sim_now + sim_us_to_cycles(SIM_WAIT_LIMIT_US);
+  uint64_t start = 0;
+  uint64_t next = 0;
+
+  sim_core_spend(1);
+  start = sim_now;
+  sleep_count++;
+  while ((find_pending_irq(current_priority()) < 0) && (sim_now < limit)) {
+    next = next_event();
+    if (next > limit) {
+      next = limit;
+    }
+    if (next <= sim_now) {
+      next = sim_now + 1;
+    }
+    sim_now = next;
+    sim_core_sync();
+  }
+  sleep_cycles += sim_now - start;
+  sim_core_dispatch();
+}
+
+uint32_t sim_get_sleep_count(void)
+{
+  return sleep_count;
+}
+
+uint64_t sim_get_sleep_cycles(void)
+{
+  return sleep_cycles;
+}
+
+void __enable_irq(void)
+{
+  primask = 0;
+  sim_core_dispatch();
+}
+
+void __disable_irq(void)
+{
+  primask = 1;
+}
+
+uint32_t __get_PRIMASK(void)
+{
+  return primask;
+}
+
+void __set_PRIMASK(uint32_t value)
+{
+  primask = value & 1;
+  sim_core_dispatch();
+}
+
+uint32_t __get_IPSR(void)
+{
+  if (active_depth == 0) {
+    return 0;
+  }
+  return (uint32_t)active_irqs[active_depth - 1] + EXCEPTION_NUMBER_BASE;
+}
+
+uint32_t __LDREXW(volatile uint32_t *address)
+{
+  exclusive_address = address;
+  return *address;
+}
+
+/*******************************************************************************
+ * A pending interrupt is taken before the store, its entry clears the
+ * monitor and the store fails, as when it preempts between the two
+ * instructions.
+ ******************************************************************************/
+uint32_t __STREXW(uint32_t value, volatile uint32_t *address)
+{
+  sim_core_dispatch();
+  if (exclusive_address != address) {
+    return 1;
+  }
+  *address = value;
+  exclusive_address = NULL;
+  return 0;
+}
+
+void __CLREX(void)
+{
+  exclusive_address = NULL;
+}
+
+/*******************************************************************************
+ * Every read of the cycle counter is a dispatch point.
+ ******************************************************************************/
+DWT_Type *sim_core_dwt(void)
+{
+  sim_core_spend(SIM_CYCLES_DWT_READ);
+  sim_core_dispatch();
+  sim_dwt.CYCCNT = (uint32_t)sim_now;
+  return &sim_dwt;
+}
+
+/*******************************************************************************
+ * Clocks and power, the frequencies are the simulated ones.
+ ******************************************************************************/
+uint32_t RSI_CLK_GetBaseClock(uint32_t peripheral)
+{
+  if (peripheral == M4_CT) {
+    return ct_frequency;
+  }
+  return core_frequency;
+}
+
+uint32_t RSI_CLK_CtClkConfig(M4CLK_Type *clock,
+                             uint32_t source,
+                             uint32_t divider,
+                             uint32_t gating)
+{
+  (void)clock;
+  (void)source;
+  (void)divider;
+  (void)gating;
+  sim_core_driver_entry();
+  return 0;
+}
+
+uint32_t RSI_CLK_I2CClkConfig(M4CLK_Type *clock, boolean_t enable, uint32_t instance)
+{
+  (void)clock;
+  (void)enable;
+  (void)instance;
+  sim_core_driver_entry();
+  return 0;
+}
+
+void RSI_PS_M4ssPeriPowerUp(uint32_t domains)
+{
+  (void)domains;
+  sim_core_driver_entry();
+}
+
+void RSI_PS_UlpssPeriPowerUp(uint32_t domains)
+{
+  (void)domains;
+  sim_core_driver_entry();
+}
+
+uint32_t RSI_ULPSS_PeripheralEnable(ULPCLK_Type *clock,
+                                    uint32_t peripheral,
+                                    uint32_t gating)
+{
+  (void)peripheral;
+  (void)gating;
+  sim_core_driver_entry();
+  clock->ULP_I2C_CLK_ENABLE = 1;
+  return 0;
+}
+
+uint32_t RSI_ULPSS_ClockConfig(M4CLK_Type *clock,
+                               boolean_t enable,
+                               uint16_t divider,
+                               boolean_t odd_divider)
+{
+  (void)clock;
+  (void)enable;
+  (void)divider;
+  (void)odd_divider;
+  sim_core_driver_entry();
+  return 0;
+}
+
+uint32_t RSI_ULPSS_UlpProcClkConfig(ULPCLK_Type *clock,
+                                    uint32_t source,
+                                    uint16_t divider,
+                                    uint32_t delay)
+{
+  (void)clock;
+  (void)source;
+  (void)divider;
+  (void)delay;
+  sim_core_driver_entry();
+  return 0;
+}
+
+sl_status_t sl_si91x_clock_manager_m4_get_core_clk_src_freq(uint32_t *frequency)
+{
+  *frequency = core_frequency;
+  return SL_STATUS_OK;
+}
+
+/*******************************************************************************
+ * System, the super loop runs against the virtual clock. The hook is called
+ * at the start of each pass, the loop is left with a long jump as the main()
+ * of an example never returns.
+ ******************************************************************************/
+void sim_run_main(int (*entry)(void), sim_main_hook_t hook, void *context)
+{
+  main_hook = hook;
+  main_context = context;
+  main_pass = 0;
+  if (setjmp(main_exit) == 0) {
+    (void)entry();
+    fprintf(stderr, "sim: main returned\n");
+    abort();
+  }
+  main_hook = NULL;
+}
+
+void sl_system_init(void)
+{
+}
+
+void sl_system_process_action(void)
+{
+  sim_core_driver_entry();
+  if ((main_hook != NULL) && !main_hook(main_context, main_pass++)) {
+    longjmp(main_exit, 1);
+  }
+  sim_core_driver_exit();
+}
+
+void sl_system_kernel_start(void)
+{
+  fprintf(stderr, "sim: no kernel in the host build\n");
+  abort();
+}
+
+void sl_power_manager_sleep(void)
+{
+  sim_core_wait_for_interrupt();
+}
+
+/*******************************************************************************
+ * Sleep timer, a 32768 Hz count. The delay is truncated to whole ticks and
+ * counted from the current tick, so a timer may expire up to one tick and
+ * the truncation before the delay asked for, as on the device.
+ ******************************************************************************/
+sl_status_t sl_sleeptimer_restart_timer_ms(sl_sleeptimer_timer_handle_t *handle,
+                                           uint32_t timeout_ms,
+                                           sl_sleeptimer_timer_callback_t callback,
+                                           void *callback_data,
+                                           uint8_t priority,
+                                           uint16_t option_flags)
+{
+  uint64_t ticks = ((uint64_t)timeout_ms * SL_SLEEPTIMER_FREQUENCY) / 1000;
+  uint64_t now_tick = 0;
+  unsigned __int128 expiry = 0;
+
+  (void)priority;
+  (void)option_flags;
+  if ((handle == NULL) || (callback == NULL)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  sim_core_driver_entry();
+  sleeptimer_remove(handle);
+  now_tick = (uint64_t)(((unsigned __int128)sim_now * SL_SLEEPTIMER_FREQUENCY)
+                        / core_frequency);
+  expiry = (unsigned __int128)(now_tick + ticks) * core_frequency;
+  handle->expiry = (uint64_t)((expiry + SL_SLEEPTIMER_FREQUENCY - 1)
+                              / SL_SLEEPTIMER_FREQUENCY);
+  handle->callback = callback;
+  handle->callback_data = callback_data;
+  handle->running = true;
+  handle->next = sleeptimers;
+  sleeptimers = handle;
+  sim_core_driver_exit();
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_sleeptimer_stop_timer(sl_sleeptimer_timer_handle_t *handle)
+{
+  if (handle == NULL) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  sim_core_driver_entry();
+  if (!handle->running) {
+    return SL_STATUS_INVALID_STATE;
+  }
+  sleeptimer_remove(handle);
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_sleeptimer_is_timer_running(sl_sleeptimer_timer_handle_t *handle,
+                                           bool *running)
+{
+  if ((handle == NULL) || (running == NULL)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  *running = handle->running;
+  return SL_STATUS_OK;
+}
+
+/*******************************************************************************
+ * Console, printed and kept for the tests.
+ ******************************************************************************/
+void sim_console_printf(const char *format, ...)
+{
+  va_list args;
+  int length = 0;
+
+  va_start(args, format);
+  length = vsnprintf(NULL, 0, format, args);
+  va_end(args);
+  if (length < 0) {
+    return;
+  }
+  if ((console_length + (size_t)length + 1) > console_size) {
+    console_size = console_length + (size_t)length + 1 + CONSOLE_CHUNK;
+    console = realloc(console, console_size);
+    if (console == NULL) {
+      abort();
+    }
+  }
+  va_start(args, format);
+  vsnprintf(console + console_length, (size_t)length + 1, format, args);
+  va_end(args);
+  fputs(console + console_length, stdout);
+  console_length += (size_t)length;
+}
+
+const char *sim_console_get(void)
+{
+  return (console != NULL) ? console : "";
+}
+
+void sim_console_clear(void)
+{
+  console_length = 0;
+  if (console != NULL) {
+    console[0] = '\0';
+  }
+}
+
+/*******************************************************************************
+ * Function to map the trapped register blocks at their device addresses.
+ * The pages are never accessible, an access faults, is emulated on the page
+ * and stepped over.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void map_register_blocks(void)
+{
+  struct sigaction action;
+
+  for (size_t index = 0; index < (sizeof(register_blocks) / sizeof(register_blocks[0])); index++) {
+    void *page = mmap((void *)register_blocks[index].base,
+                      PAGE_SIZE,
+                      PROT_NONE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                      -1,
+                      0);
+
+    if (page != (void *)register_blocks[index].base) {
+      fprintf(stderr, "sim: cannot map the registers at 0x%lx\n",
+              (unsigned long)register_blocks[index].base);
+      exit(EXIT_FAILURE);
+    }
+  }
+  memset(&action, 0, sizeof(action));
+  action.sa_flags = SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  action.sa_sigaction = on_access_fault;
+  sigaction(SIGSEGV, &action, NULL);
+  action.sa_sigaction = on_access_step;
+  sigaction(SIGTRAP, &action, NULL);
+  irq_enabled[ULPSS_UDMA_IRQn] = true;
+  irq_enabled[SYSRTC_IRQn] = true;
+}
+
+/*******************************************************************************
+ * Function to emulate the access to a register. The register value is placed
+ * on the page, which is opened for the faulting instruction only.
+ *
+ * @param[in] signal_number (int) SIGSEGV.
+ * @param[in] info (siginfo_t) Faulting address.
+ * @param[in,out] context (ucontext_t) Faulting context.
+ * @return none
+ ******************************************************************************/
+static void on_access_fault(int signal_number, siginfo_t *info, void *context)
+{
+  ucontext_t *ucontext = context;
+  uintptr_t address = (uintptr_t)info->si_addr;
+  const register_block_t *block = NULL;
+  uint32_t value = 0;
+
+  for (size_t index = 0; index < (sizeof(register_blocks) / sizeof(register_blocks[0])); index++) {
+    if ((address >= register_blocks[index].base)
+        && (address < (register_blocks[index].base + PAGE_SIZE))) {
+      block = &register_blocks[index];
+    }
+  }
+  if ((block == NULL) || (trapped_block != NULL)) {
+    // A real fault, it is taken again with the default action.
+    signal(signal_number, SIG_DFL);
+    return;
+  }
+  trapped_block = block;
+  trapped_offset = (uint32_t)(address - block->base) & ~3u;
+  trapped_write = (ucontext->uc_mcontext.gregs[REG_ERR] & PAGE_FAULT_WRITE) != 0;
+  sim_core_spend(SIM_CYCLES_REGISTER_ACCESS);
+  value = block->read(trapped_offset, !trapped_write);
+  mprotect((void *)block->base, PAGE_SIZE, PROT_READ | PROT_WRITE);
+  *(volatile uint32_t *)(block->base + trapped_offset) = value;
+  ucontext->uc_mcontext.gregs[REG_EFL] |= EFLAGS_TRAP;
+}
+
+/*******************************************************************************
+ * Function to complete the access after the instruction, a write is applied
+ * to the register and the page is closed again.
+ *
+ * @param[in] signal_number (int) SIGTRAP.
+ * @param[in] info (siginfo_t) Unused.
+ * @param[in,out] context (ucontext_t) Context after the access.
+ * @return none
+ ******************************************************************************/
+static void on_access_step(int signal_number, siginfo_t *info, void *context)
+{
+  ucontext_t *ucontext = context;
+  const register_block_t *block = trapped_block;
+
+  (void)info;
+  if (block == NULL) {
+    signal(signal_number, SIG_DFL);
+    raise(signal_number);
+    return;
+  }
+  ucontext->uc_mcontext.gregs[REG_EFL] &= ~EFLAGS_TRAP;
+  if (trapped_write) {
+    uint32_t value = *(volatile uint32_t *)(block->base + trapped_offset);
+
+    mprotect((void *)block->base, PAGE_SIZE, PROT_NONE);
+    trapped_block = NULL;
+    block->write(trapped_offset, value);
+    return;
+  }
+  mprotect((void *)block->base, PAGE_SIZE, PROT_NONE);
+  trapped_block = NULL;
+}
+
+/*******************************************************************************
+ * Function to tell if an interrupt line is asserted by its peripheral.
+ *
+ * @param[in] irq (IRQn_Type) Interrupt line.
+ * @return true if asserted
+ ******************************************************************************/
+static bool irq_line(IRQn_Type irq)
+{
+  switch (irq) {
+    case CT_IRQn:
+      return sim_ct_irq_line();
+    case I2C2_IRQn:
+      return sim_i2c_irq_line();
+    case ULPSS_UDMA_IRQn:
+      return sim_dma_irq_line();
+    case SYSRTC_IRQn:
+      return sleeptimer_line();
+    default:
+      return false;
+  }
+}
+
+/*******************************************************************************
+ * Function to return the priority of the running code, NO_PRIORITY in
+ * thread mode.
+ *
+ * @param none
+ * @return priority
+ ******************************************************************************/
+static uint32_t current_priority(void)
+{
+  if (active_depth == 0) {
+    return NO_PRIORITY;
+  }
+  return irq_priority[active_irqs[active_depth - 1]];
+}
+
+/*******************************************************************************
+ * Function to find the enabled interrupt to take, pending or with its line
+ * asserted, with the highest priority above the given one.
+ *
+ * @param[in] below_priority (uint32_t) Priority to preempt.
+ * @return interrupt number, or -1 if none
+ ******************************************************************************/
+static int find_pending_irq(uint32_t below_priority)
+{
+  int found = -1;
+
+  for (int irq = 0; irq < SIM_IRQ_COUNT; irq++) {
+    if (!irq_enabled[irq] || (irq_priority[irq] >= below_priority)) {
+      continue;
+    }
+    if (!irq_pending[irq] && !irq_line((IRQn_Type)irq)) {
+      continue;
+    }
+    if ((found < 0) || (irq_priority[irq] < irq_priority[found])) {
+      found = irq;
+    }
+  }
+  return found;
+}
+
+/*******************************************************************************
+ * Function to take an interrupt. The handler time, entry and exit included,
+ * counts as interrupt time, nested handlers once.
+ *
+ * @param[in] irq (IRQn_Type) Interrupt to take.
+ * @return none
+ ******************************************************************************/
+static void run_handler(IRQn_Type irq)
+{
+  void (*handler)(void) = NULL;
+
+  switch (irq) {
+    case CT_IRQn:
+      handler = IRQ034_Handler;
+      break;
+    case I2C2_IRQn:
+      handler = I2C2_IRQHandler;
+      break;
+    case ULPSS_UDMA_IRQn:
+      handler = sim_dma_irq_handler;
+      break;
+    case SYSRTC_IRQn:
+      handler = sleeptimer_irq_handler;
+      break;
+    default:
+      break;
+  }
+  irq_pending[irq] = false;
+  if (handler == NULL) {
+    irq_enabled[irq] = false;
+    return;
+  }
+  if (active_depth == 0) {
+    isr_start = sim_now;
+  }
+  active_irqs[active_depth++] = irq;
+  irq_count[irq]++;
+  exclusive_address = NULL;
+  sim_core_spend(SIM_CYCLES_ISR_ENTRY);
+  handler();
+  sim_core_spend(SIM_CYCLES_ISR_EXIT);
+  exclusive_address = NULL;
+  active_depth--;
+  if (active_depth == 0) {
+    isr_cycles += sim_now - isr_start;
+  }
+}
+
+/*******************************************************************************
+ * Function to return the time of the next peripheral event.
+ *
+ * @param none
+ * @return time in cycles, SIM_NEVER if none
+ ******************************************************************************/
+static uint64_t next_event(void)
+{
+  uint64_t next = sim_ct_next_event();
+  uint64_t event = sim_i2c_next_event();
+
+  if (event < next) {
+    next = event;
+  }
+  for (sl_sleeptimer_timer_handle_t *timer = sleeptimers;
+       timer != NULL;
+       timer = timer->next) {
+    if (timer->expiry < next) {
+      next = timer->expiry;
+    }
+  }
+  return next;
+}
+
+/*******************************************************************************
+ * Sleep timer helpers, the expired timers assert the line and their
+ * callbacks run from its handler.
+ ******************************************************************************/
+static void sleeptimer_remove(sl_sleeptimer_timer_handle_t *handle)
+{
+  for (sl_sleeptimer_timer_handle_t **link = &sleeptimers;
+       *link != NULL;
+       link = &(*link)->next) {
+    if (*link == handle) {
+      *link = handle->next;
+      break;
+    }
+  }
+  handle->running = false;
+  handle->next = NULL;
+}
+
+static bool sleeptimer_line(void)
+{
+  for (sl_sleeptimer_timer_handle_t *timer = sleeptimers;
+       timer != NULL;
+       timer = timer->next) {
+    if (timer->expiry <= sim_now) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void sleeptimer_irq_handler(void)
+{
+  sl_sleeptimer_timer_handle_t *timer = sleeptimers;
+
+  while (timer != NULL) {
+    if (timer->expiry <= sim_now) {
+      sleeptimer_remove(timer);
+      timer->callback(timer, timer->callback_data);
+      timer = sleeptimers;
+    } else {
+      timer = timer->next;
+    }
+  }
+}
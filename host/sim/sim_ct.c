@@ -0,0 +1,535 @@
+/***************************************************************************/ /**
+ * @file sim_ct.c
+ * @brief Simulated config timer 0
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "sim_internal.h"
+#include "rsi_ct.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define COUNTERS            2
+#define COUNTER_1_SHIFT     16
+#define HALF_MASK           0xFFFF
+#define REGISTER_COUNT      (0x100 / 4)
+#define EVENT_RISING_EDGE   0x01 // Rising edge of input 0, input n is + n
+#define EVENT_FALLING_EDGE  0x05
+#define EVENT_BOTH_EDGES    0x09
+#define INTR_EVENT(counter) ((counter) ? RSI_CT_EVENT_INTR_1_l : RSI_CT_EVENT_INTR_0_l)
+#define PEAK_EVENT(counter) ((counter) ? RSI_CT_EVENT_COUNTER_1_IS_PEAK_l \
+                             : RSI_CT_EVENT_COUNTER_0_IS_PEAK_l)
+
+#define REG_GEN_CTRL_SET    0x00
+#define REG_GEN_CTRL_RESET  0x04
+#define REG_INTR_STS        0x08
+#define REG_INTR_MASK       0x0C
+#define REG_INTR_UNMASK     0x10
+#define REG_INTR_ACK        0x14
+#define REG_MATCH           0x18
+#define REG_CAPTURE         0x20
+#define REG_COUNTER         0x24
+#define REG_INCREMENT_SEL   0x7C
+#define REG_CAPTURE_SEL     0x88
+#define REG_INTR_EVENT_SEL  0x9C
+
+/*******************************************************************************
+ ******************************  Data Types  ***********************************
+ ******************************************************************************/
+typedef struct {
+  uint32_t value; // Count at synced_tick
+  bool running;   // Started by software
+} counter_t;
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static counter_t counters[COUNTERS];
+static uint64_t synced_tick = 0;
+static uint32_t control = 0;
+static uint32_t match = 0;
+static uint32_t capture = 0;
+static uint32_t raw_status = 0;
+static uint32_t unmasked = 0;
+static uint32_t interrupt_select = 0;
+static uint32_t capture_select = 0;
+static uint32_t increment_select = 0;
+static uint32_t registers[REGISTER_COUNT];
+
+static bool levels[SIM_CT_INPUTS];
+static sim_ct_edge_source_t edge_source = NULL;
+static void *edge_context = NULL;
+static bool edge_valid = false;
+static uint64_t edge_ps = 0;
+static uint8_t edge_input = 0;
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static bool is_32bit(void);
+static uint32_t counter_mask(void);
+static uint32_t counter_match(uint32_t counter);
+static uint32_t select_half(uint32_t select, uint32_t counter);
+static uint32_t active_counters(void);
+static bool counts_clock(uint32_t counter);
+static void advance_ticks(uint64_t tick);
+static void apply_edge(uint8_t input, bool level);
+static bool edge_matches(uint32_t event, uint8_t input, bool level);
+static void fetch_edge(void);
+static uint32_t read_counter_register(void);
+static void write_counter_register(uint32_t value);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Inputs
+ ******************************************************************************/
+void sim_ct_set_input_level(uint8_t input, bool level)
+{
+  sim_core_sync();
+  levels[input] = level;
+}
+
+bool sim_ct_get_input_level(uint8_t input)
+{
+  sim_core_sync();
+  return levels[input];
+}
+
+void sim_ct_set_edge_source(sim_ct_edge_source_t source, void *context)
+{
+  sim_core_sync();
+  edge_source = source;
+  edge_context = context;
+  fetch_edge();
+}
+
+void sim_ct_square_wave(sim_square_wave_t *wave,
+                        uint8_t input,
+                        uint64_t period_ps,
+                        uint64_t high_ps,
+                        uint64_t start_ps)
+{
+  wave->input = input;
+  wave->high_ps = high_ps;
+  wave->low_ps = period_ps - high_ps;
+  wave->next_ps = start_ps;
+  wave->level = sim_ct_get_input_level(input);
+}
+
+bool sim_ct_square_wave_source(void *context, uint64_t *time_ps, uint8_t *input)
+{
+  sim_square_wave_t *wave = context;
+
+  *time_ps = wave->next_ps;
+  *input = wave->input;
+  wave->level = !wave->level;
+  wave->next_ps += wave->level ? wave->high_ps : wave->low_ps;
+  return true;
+}
+
+/*******************************************************************************
+ * Brings the counters to the given time, the input edges before it are
+ * applied in order.
+ ******************************************************************************/
+void sim_ct_sync(uint64_t cycles)
+{
+  uint64_t edge_tick = 0;
+
+  while (edge_valid && (sim_ps_to_cycles_ceil(edge_ps) <= cycles)) {
+    edge_tick = sim_ps_to_ticks(edge_ps);
+    if (edge_tick > synced_tick) {
+      advance_ticks(edge_tick);
+    }
+    levels[edge_input] = !levels[edge_input];
+    apply_edge(edge_input, levels[edge_input]);
+    fetch_edge();
+  }
+  advance_ticks(sim_cycles_to_ticks(cycles));
+}
+
+/*******************************************************************************
+ * Returns the time of the next input edge or counter peak.
+ ******************************************************************************/
+uint64_t sim_ct_next_event(void)
+{
+  uint64_t next = SIM_NEVER;
+  uint64_t event = 0;
+  uint32_t distance = 0;
+  uint32_t top = 0;
+
+  if (edge_valid) {
+    next = sim_ps_to_cycles_ceil(edge_ps);
+  }
+  for (uint32_t counter = 0; counter < active_counters(); counter++) {
+    if (!counts_clock(counter)) {
+      continue;
+    }
+    top = counter_match(counter);
+    if (counters[counter].value < top) {
+      distance = top - counters[counter].value;
+    } else if (counters[counter].value == top) {
+      distance = top + 1;
+    } else {
+      distance = (counter_mask() - counters[counter].value) + 1 + top;
+    }
+    event = sim_ticks_to_cycles_ceil(synced_tick + (uint64_t)distance);
+    if (event < next) {
+      next = event;
+    }
+  }
+  return next;
+}
+
+bool sim_ct_irq_line(void)
+{
+  return (raw_status & unmasked) != 0;
+}
+
+/*******************************************************************************
+ * Register accesses
+ ******************************************************************************/
+uint32_t sim_ct_read(uint32_t offset, bool side_effects)
+{
+  (void)side_effects;
+  switch (offset) {
+    case REG_GEN_CTRL_SET:
+      return control;
+    case REG_INTR_STS:
+      return raw_status;
+    case REG_INTR_MASK:
+      return ~unmasked;
+    case REG_MATCH:
+      return match;
+    case REG_CAPTURE:
+      return capture;
+    case REG_COUNTER:
+      return read_counter_register();
+    case REG_INCREMENT_SEL:
+      return increment_select;
+    case REG_CAPTURE_SEL:
+      return capture_select;
+    case REG_INTR_EVENT_SEL:
+      return interrupt_select;
+    default:
+      return registers[offset / 4];
+  }
+}
+
+void sim_ct_write(uint32_t offset, uint32_t value)
+{
+  switch (offset) {
+    case REG_GEN_CTRL_SET:
+      control |= value;
+      break;
+    case REG_GEN_CTRL_RESET:
+      control &= ~value;
+      break;
+    case REG_INTR_MASK:
+      unmasked &= ~value;
+      break;
+    case REG_INTR_UNMASK:
+      unmasked |= value;
+      break;
+    case REG_INTR_ACK:
+      raw_status &= ~value;
+      break;
+    case REG_MATCH:
+      match = value;
+      break;
+    case REG_COUNTER:
+      write_counter_register(value);
+      break;
+    case REG_INCREMENT_SEL:
+      increment_select = value;
+      break;
+    case REG_CAPTURE_SEL:
+      capture_select = value;
+      break;
+    case REG_INTR_EVENT_SEL:
+      interrupt_select = value;
+      break;
+    default:
+      registers[offset / 4] = value;
+      break;
+  }
+}
+
+/*******************************************************************************
+ * Driver functions
+ ******************************************************************************/
+void RSI_CT_SetControl(CT0_Type *ptr, uint32_t value)
+{
+  (void)ptr;
+  sim_core_driver_entry();
+  sim_ct_write(REG_GEN_CTRL_SET, value);
+  sim_core_driver_exit();
+}
+
+void RSI_CT_ClearControl(CT0_Type *ptr, uint32_t value)
+{
+  (void)ptr;
+  sim_core_driver_entry();
+  sim_ct_write(REG_GEN_CTRL_RESET, value);
+  sim_core_driver_exit();
+}
+
+void RSI_CT_PeripheralReset(CT0_Type *ptr, boolean_t counter)
+{
+  (void)ptr;
+  sim_core_driver_entry();
+  counters[counter ? 1 : 0].value = 0;
+  counters[counter ? 1 : 0].running = false;
+  sim_core_driver_exit();
+}
+
+void RSI_CT_SetCount(CT0_Type *ptr, uint32_t count)
+{
+  (void)ptr;
+  sim_core_driver_entry();
+  write_counter_register(count);
+  sim_core_driver_exit();
+}
+
+void RSI_CT_StartSoftwareTrig(CT0_Type *ptr, boolean_t counter)
+{
+  (void)ptr;
+  sim_core_driver_entry();
+  counters[counter ? 1 : 0].running = true;
+  sim_core_driver_exit();
+}
+
+void RSI_CT_InterruptEnable(CT0_Type *ptr, uint32_t flags)
+{
+  (void)ptr;
+  sim_core_driver_entry();
+  sim_ct_write(REG_INTR_UNMASK, flags);
+  sim_core_driver_exit();
+}
+
+void RSI_CT_InterruptDisable(CT0_Type *ptr, uint32_t flags)
+{
+  (void)ptr;
+  sim_core_driver_entry();
+  sim_ct_write(REG_INTR_MASK, flags);
+  sim_core_driver_exit();
+}
+
+void RSI_CT_InterruptClear(CT0_Type *ptr, uint32_t flags)
+{
+  (void)ptr;
+  sim_core_driver_entry();
+  sim_ct_write(REG_INTR_ACK, flags);
+  sim_core_driver_exit();
+}
+
+uint32_t RSI_CT_GetInterruptStatus(const CT0_Type *ptr)
+{
+  uint32_t status = 0;
+
+  (void)ptr;
+  sim_core_driver_entry();
+  status = raw_status;
+  sim_core_driver_exit();
+  return status;
+}
+
+void RSI_CT_InterruptEventSelect(CT0_Type *ptr, uint32_t value)
+{
+  (void)ptr;
+  sim_core_driver_entry();
+  sim_ct_write(REG_INTR_EVENT_SEL, value);
+  sim_core_driver_exit();
+}
+
+void RSI_CT_CaptureEventSelect(CT0_Type *ptr, uint32_t value)
+{
+  (void)ptr;
+  sim_core_driver_entry();
+  sim_ct_write(REG_CAPTURE_SEL, value);
+  sim_core_driver_exit();
+}
+
+void RSI_CT_IncrementEventSelect(CT0_Type *ptr, uint32_t value)
+{
+  (void)ptr;
+  sim_core_driver_entry();
+  sim_ct_write(REG_INCREMENT_SEL, value);
+  sim_core_driver_exit();
+}
+
+/*******************************************************************************
+ * Counter helpers. In 32-bit mode counter 0 is the whole register, in 16-bit
+ * mode each counter is one half of it.
+ ******************************************************************************/
+static bool is_32bit(void)
+{
+  return (control & COUNTER32_BITMODE) != 0;
+}
+
+static uint32_t counter_mask(void)
+{
+  return is_32bit() ? UINT32_MAX : HALF_MASK;
+}
+
+static uint32_t counter_match(uint32_t counter)
+{
+  if (is_32bit()) {
+    return match;
+  }
+  return (match >> (counter * COUNTER_1_SHIFT)) & HALF_MASK;
+}
+
+static uint32_t select_half(uint32_t select, uint32_t counter)
+{
+  return (select >> (counter * COUNTER_1_SHIFT)) & HALF_MASK;
+}
+
+static uint32_t active_counters(void)
+{
+  return is_32bit() ? 1 : COUNTERS;
+}
+
+static bool counts_clock(uint32_t counter)
+{
+  return counters[counter].running
+         && (select_half(increment_select, counter) == 0);
+}
+
+/*******************************************************************************
+ * Function to advance the counters counting the clock to the given tick. A
+ * counter reaching its match raises its peak event and restarts from 0 on
+ * the next tick.
+ *
+ * @param[in] tick (uint64_t) Timer tick to reach.
+ * @return none
+ ******************************************************************************/
+static void advance_ticks(uint64_t tick)
+{
+  uint64_t elapsed = tick - synced_tick;
+  uint64_t remaining = 0;
+  uint64_t period = 0;
+  uint64_t distance = 0;
+  uint32_t top = 0;
+
+  if (tick <= synced_tick) {
+    return;
+  }
+  for (uint32_t counter = 0; counter < active_counters(); counter++) {
+    if (!counts_clock(counter)) {
+      continue;
+    }
+    top = counter_match(counter);
+    remaining = elapsed;
+    if (counters[counter].value > top) {
+      // Above a lowered match, the counter runs to its top and wraps.
+      distance = (uint64_t)(counter_mask() - counters[counter].value) + 1;
+      if (remaining < distance) {
+        counters[counter].value += (uint32_t)remaining;
+        continue;
+      }
+      remaining -= distance;
+      counters[counter].value = 0;
+      if (top == 0) {
+        raw_status |= PEAK_EVENT(counter);
+      }
+    }
+    period = (uint64_t)top + 1;
+    distance = (counters[counter].value == top)
+               ? period : (uint64_t)(top - counters[counter].value);
+    if (remaining >= distance) {
+      raw_status |= PEAK_EVENT(counter);
+    }
+    counters[counter].value =
+      (uint32_t)(((uint64_t)counters[counter].value + remaining) % period);
+  }
+  synced_tick = tick;
+}
+
+/*******************************************************************************
+ * Function to apply an input edge to the counters: capture, increment and
+ * interrupt, each as selected for the counter.
+ *
+ * @param[in] input (uint8_t) Input with the edge.
+ * @param[in] level (bool) Level after the edge.
+ * @return none
+ ******************************************************************************/
+static void apply_edge(uint8_t input, bool level)
+{
+  uint32_t shift = 0;
+
+  for (uint32_t counter = 0; counter < active_counters(); counter++) {
+    if (edge_matches(select_half(capture_select, counter), input, level)) {
+      if (is_32bit()) {
+        capture = counters[counter].value;
+      } else {
+        shift = counter * COUNTER_1_SHIFT;
+        capture = (capture & ~(HALF_MASK << shift))
+                  | (counters[counter].value << shift);
+      }
+    }
+    if (counters[counter].running
+        && edge_matches(select_half(increment_select, counter), input, level)) {
+      if (counters[counter].value == counter_match(counter)) {
+        counters[counter].value = 0;
+      } else {
+        counters[counter].value = (counters[counter].value + 1) & counter_mask();
+      }
+      if (counters[counter].value == counter_match(counter)) {
+        raw_status |= PEAK_EVENT(counter);
+      }
+    }
+    if (edge_matches(select_half(interrupt_select, counter), input, level)) {
+      raw_status |= INTR_EVENT(counter);
+    }
+  }
+}
+
+static bool edge_matches(uint32_t event, uint8_t input, bool level)
+{
+  if (event == 0) {
+    return false;
+  }
+  if (event == (uint32_t)(EVENT_BOTH_EDGES + input)) {
+    return true;
+  }
+  return event == (uint32_t)((level ? EVENT_RISING_EDGE : EVENT_FALLING_EDGE)
+                             + input);
+}
+
+static void fetch_edge(void)
+{
+  edge_valid = (edge_source != NULL)
+               && edge_source(edge_context, &edge_ps, &edge_input);
+}
+
+static uint32_t read_counter_register(void)
+{
+  if (is_32bit()) {
+    return counters[0].value;
+  }
+  return (counters[0].value & HALF_MASK)
+         | ((counters[1].value & HALF_MASK) << COUNTER_1_SHIFT);
+}
+
+static void write_counter_register(uint32_t value)
+{
+  if (is_32bit()) {
+    counters[0].value = value;
+    return;
+  }
+  counters[0].value = value & HALF_MASK;
+  counters[1].value = value >> COUNTER_1_SHIFT;
+}
@@ -0,0 +1,272 @@
+/***************************************************************************/ /**
+ * @file sim/sim_dma.c
+ * @brief Simulated DMA, channels served by the simulated peripheral requests
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <string.h>
+
+#include "sim_internal.h"
+#include "sl_si91x_dma.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define INSTANCES     2
+#define ANY_CHANNEL   0 // Channel number asking for any free channel
+
+/*******************************************************************************
+ ******************************  Data Types  ***********************************
+ ******************************************************************************/
+typedef struct {
+  bool allocated;
+  bool active;
+  bool done;
+  sl_dma_callback_t callbacks;
+  sl_dma_xfer_t transfer;
+  uint32_t remaining;
+  uint8_t *source;
+  uint8_t *destination;
+} channel_t;
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+// Channels are numbered from 1, index 0 is unused
+static channel_t channels[INSTANCES][SL_DMA_CHANNEL_COUNT + 1];
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static channel_t *find_channel(uint8_t signal, uint8_t transfer_type);
+static uint32_t element_size(uint8_t xfer_size);
+static uint32_t increment(uint8_t inc);
+static void complete_element(channel_t *channel);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+sl_status_t sl_si91x_dma_init(sl_dma_init_t *dma_init)
+{
+  sim_core_driver_entry();
+  if (dma_init->dma_number >= INSTANCES) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_si91x_dma_allocate_channel(uint32_t dma_number,
+                                          uint32_t *channel_no,
+                                          uint32_t priority)
+{
+  (void)priority;
+  sim_core_driver_entry();
+  if ((dma_number >= INSTANCES) || (*channel_no > SL_DMA_CHANNEL_COUNT)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  if (*channel_no == ANY_CHANNEL) {
+    for (uint32_t channel = 1; channel <= SL_DMA_CHANNEL_COUNT; channel++) {
+      if (!channels[dma_number][channel].allocated) {
+        *channel_no = channel;
+        break;
+      }
+    }
+    if (*channel_no == ANY_CHANNEL) {
+      return SL_STATUS_FAIL;
+    }
+  } else if (channels[dma_number][*channel_no].allocated) {
+    return SL_STATUS_FAIL;
+  }
+  channels[dma_number][*channel_no].allocated = true;
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_si91x_dma_register_callbacks(uint32_t dma_number,
+                                            uint32_t channel_no,
+                                            sl_dma_callback_t *callbacks)
+{
+  sim_core_driver_entry();
+  if ((dma_number >= INSTANCES) || (channel_no == ANY_CHANNEL)
+      || (channel_no > SL_DMA_CHANNEL_COUNT)
+      || !channels[dma_number][channel_no].allocated) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  channels[dma_number][channel_no].callbacks = *callbacks;
+  return SL_STATUS_OK;
+}
+
+/*******************************************************************************
+ * A memory to memory transfer completes at once, the peripheral flows wait
+ * for the request wired to their channel.
+ ******************************************************************************/
+sl_status_t sl_si91x_dma_transfer(uint32_t dma_number,
+                                  uint32_t channel_no,
+                                  sl_dma_xfer_t *dma_transfer)
+{
+  channel_t *channel = NULL;
+
+  sim_core_driver_entry();
+  if ((dma_number >= INSTANCES) || (channel_no == ANY_CHANNEL)
+      || (channel_no > SL_DMA_CHANNEL_COUNT)
+      || !channels[dma_number][channel_no].allocated) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  channel = &channels[dma_number][channel_no];
+  if (channel->active) {
+    return SL_STATUS_BUSY;
+  }
+  channel->transfer = *dma_transfer;
+  channel->remaining = dma_transfer->transfer_count;
+  channel->source = (uint8_t *)dma_transfer->src_addr;
+  channel->destination = (uint8_t *)dma_transfer->dest_addr;
+  channel->done = false;
+  channel->active = (channel->remaining > 0);
+  if (dma_transfer->transfer_type == SL_DMA_MEMORY_TO_MEMORY) {
+    while (channel->active) {
+      memcpy(channel->destination, channel->source,
+             element_size(channel->transfer.xfer_size));
+      complete_element(channel);
+    }
+  }
+  // The peripheral may already be requesting.
+  sim_core_sync();
+  sim_core_driver_exit();
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_si91x_dma_stop_transfer(uint32_t dma_number, uint32_t channel_no)
+{
+  sim_core_driver_entry();
+  if ((dma_number >= INSTANCES) || (channel_no == ANY_CHANNEL)
+      || (channel_no > SL_DMA_CHANNEL_COUNT)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  channels[dma_number][channel_no].active = false;
+  channels[dma_number][channel_no].done = false;
+  return SL_STATUS_OK;
+}
+
+/*******************************************************************************
+ * Peripheral side
+ ******************************************************************************/
+bool sim_dma_peripheral_read(uint8_t signal, uint32_t *value)
+{
+  channel_t *channel = find_channel(signal, SL_DMA_MEMORY_TO_PERIPHERAL);
+  uint32_t size = 0;
+
+  if (channel == NULL) {
+    return false;
+  }
+  size = element_size(channel->transfer.xfer_size);
+  *value = 0;
+  memcpy(value, channel->source, size);
+  complete_element(channel);
+  return true;
+}
+
+bool sim_dma_peripheral_write(uint8_t signal, uint32_t value)
+{
+  channel_t *channel = find_channel(signal, SL_DMA_PERIPHERAL_TO_MEMORY);
+
+  if (channel == NULL) {
+    return false;
+  }
+  memcpy(channel->destination, &value, element_size(channel->transfer.xfer_size));
+  complete_element(channel);
+  return true;
+}
+
+bool sim_dma_has_request(uint8_t signal)
+{
+  return find_channel(signal, SL_DMA_PERIPHERAL_TO_MEMORY) != NULL;
+}
+
+bool sim_dma_irq_line(void)
+{
+  for (uint32_t instance = 0; instance < INSTANCES; instance++) {
+    for (uint32_t channel = 1; channel <= SL_DMA_CHANNEL_COUNT; channel++) {
+      if (channels[instance][channel].done) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void sim_dma_irq_handler(void)
+{
+  channel_t *channel = NULL;
+
+  for (uint32_t instance = 0; instance < INSTANCES; instance++) {
+    for (uint32_t number = 1; number <= SL_DMA_CHANNEL_COUNT; number++) {
+      channel = &channels[instance][number];
+      if (!channel->done) {
+        continue;
+      }
+      channel->done = false;
+      if (channel->callbacks.transfer_complete_cb != NULL) {
+        channel->callbacks.transfer_complete_cb(number, NULL);
+      }
+    }
+  }
+}
+
+/*******************************************************************************
+ * Function helpers
+ ******************************************************************************/
+/*******************************************************************************
+ * Function to find the active channel serving a peripheral request. Each
+ * request is wired to the channel of the same number, which must be armed
+ * with that signal.
+ *
+ * @param[in] signal (uint8_t) Peripheral request.
+ * @param[in] transfer_type (uint8_t) Flow of the request.
+ * @return channel, NULL if none is armed
+ ******************************************************************************/
+static channel_t *find_channel(uint8_t signal, uint8_t transfer_type)
+{
+  channel_t *channel = NULL;
+
+  if ((signal == 0) || (signal > SL_DMA_CHANNEL_COUNT)) {
+    return NULL;
+  }
+  for (uint32_t instance = 0; instance < INSTANCES; instance++) {
+    channel = &channels[instance][signal];
+    if (channel->active && (channel->transfer.signal == signal)
+        && (channel->transfer.transfer_type == transfer_type)) {
+      return channel;
+    }
+  }
+  return NULL;
+}
+
+static uint32_t element_size(uint8_t xfer_size)
+{
+  return 1U << xfer_size;
+}
+
+static uint32_t increment(uint8_t inc)
+{
+  return (inc == SRC_INC_NONE) ? 0 : (1U << inc);
+}
+
+static void complete_element(channel_t *channel)
+{
+  channel->source += increment(channel->transfer.src_inc);
+  channel->destination += increment(channel->transfer.dst_inc);
+  channel->remaining--;
+  if (channel->remaining == 0) {
+    channel->active = false;
+    channel->done = true;
+  }
+}
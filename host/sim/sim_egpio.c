@@ -0,0 +1,143 @@
+/***************************************************************************/ /**
+ * @file sim/sim_egpio.c
+ * @brief Simulated GPIO pads, the config timer inputs and the I2C lines
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "sim_internal.h"
+#include "rsi_egpio.h"
+#include "RTE_Device_917.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define BLOCKS            2
+#define PORTS             4
+#define PINS              64
+#define GPIO_MODE         0
+#define CT_FIRST_PIN      RTE_SCT_IN_0_PIN
+#define CT_LAST_PIN       RTE_SCT_IN_3_PIN
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+// Directions start as inputs, as out of reset
+static bool output_enabled[BLOCKS][PORTS][PINS];
+static bool output_level[BLOCKS][PORTS][PINS];
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static uint32_t block_index(const EGPIO_Type *block);
+static bool drives_low(const EGPIO_Type *block, uint8_t port, uint8_t pin);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+void RSI_EGPIO_SetPinMux(EGPIO_Type *block, uint8_t port, uint8_t pin, uint8_t mux)
+{
+  sim_core_driver_entry();
+  block->pin_mode[port][pin] = mux;
+  sim_core_driver_exit();
+}
+
+/*******************************************************************************
+ * Releasing SCL after driving it low is a clock pulse for the follower.
+ ******************************************************************************/
+void RSI_EGPIO_SetDir(EGPIO_Type *block, uint8_t port, uint8_t pin, boolean_t direction)
+{
+  bool was_low = false;
+
+  sim_core_driver_entry();
+  was_low = drives_low(block, port, pin);
+  output_enabled[block_index(block)][port][pin] = (direction == EGPIO_CONFIG_DIR_OUTPUT);
+  if ((block == EGPIO1) && (port == RTE_I2C2_SCL_PORT) && (pin == RTE_I2C2_SCL_PIN)
+      && was_low && !drives_low(block, port, pin)) {
+    sim_i2c_scl_pulse();
+  }
+  sim_core_driver_exit();
+}
+
+void RSI_EGPIO_SetPin(EGPIO_Type *block, uint8_t port, uint8_t pin, uint8_t level)
+{
+  sim_core_driver_entry();
+  output_level[block_index(block)][port][pin] = (level != 0);
+  sim_core_driver_exit();
+}
+
+/*******************************************************************************
+ * The config timer inputs read the simulated signals, the I2C lines are open
+ * drain: low if the pad or the follower pulls them down.
+ ******************************************************************************/
+boolean_t RSI_EGPIO_GetPin(EGPIO_Type *block, uint8_t port, uint8_t pin)
+{
+  boolean_t level = 1;
+  uint32_t index = block_index(block);
+
+  sim_core_driver_entry();
+  if ((block == EGPIO) && (port == RTE_SCT_IN_0_PORT)
+      && (pin >= CT_FIRST_PIN) && (pin <= CT_LAST_PIN)) {
+    level = sim_ct_get_input_level((uint8_t)(pin - CT_FIRST_PIN));
+  } else if ((block == EGPIO1) && (port == RTE_I2C2_SCL_PORT)
+             && ((pin == RTE_I2C2_SCL_PIN) || (pin == RTE_I2C2_SDA_PIN))) {
+    level = !drives_low(block, port, pin)
+            && sim_i2c_follower_line(pin == RTE_I2C2_SCL_PIN);
+  } else if (output_enabled[index][port][pin]) {
+    level = output_level[index][port][pin];
+  }
+  sim_core_driver_exit();
+  return level;
+}
+
+void RSI_EGPIO_PadReceiverEnable(uint8_t pin)
+{
+  (void)pin;
+  sim_core_driver_entry();
+}
+
+void RSI_EGPIO_UlpPadReceiverEnable(uint8_t pin)
+{
+  (void)pin;
+  sim_core_driver_entry();
+}
+
+void RSI_EGPIO_HostPadsGpioModeEnable(uint8_t pin)
+{
+  (void)pin;
+  sim_core_driver_entry();
+}
+
+/*******************************************************************************
+ * Function helpers
+ ******************************************************************************/
+static uint32_t block_index(const EGPIO_Type *block)
+{
+  return (block == EGPIO1) ? 1 : 0;
+}
+
+/*******************************************************************************
+ * Function to check whether a pad muxed as a GPIO drives its line low.
+ *
+ * @param[in] block (const EGPIO_Type *) GPIO block.
+ * @param[in] port (uint8_t) Port.
+ * @param[in] pin (uint8_t) Pin.
+ * @return true if the line is driven low
+ ******************************************************************************/
+static bool drives_low(const EGPIO_Type *block, uint8_t port, uint8_t pin)
+{
+  uint32_t index = block_index(block);
+
+  return (block->pin_mode[port][pin] == GPIO_MODE)
+         && output_enabled[index][port][pin]
+         && !output_level[index][port][pin];
+}
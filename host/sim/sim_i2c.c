@@ -0,0 +1,732 @@
+/***************************************************************************/ /**
+ * @file sim_i2c.c
+ * @brief Simulated ULP_I2C controller and follower
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_internal.h"
+#include "sl_si91x_dma.h"
+#include "sl_si91x_peripheral_i2c.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define FIFO_DEPTH           8
+#define REGISTER_COUNT       (0x100 / 4)
+#define DEFAULT_FOLLOWER     0x50
+#define BITS_PER_ADDRESS     10   // Start and address byte with its acknowledge
+#define BITS_PER_BYTE        9    // Data byte with its acknowledge
+#define BITS_PER_STOP        1
+#define LOG_CHUNK            1024
+
+#define CMD_READ             BIT(8)
+#define CMD_STOP             BIT(9)
+#define CMD_RESTART          BIT(10)
+#define DATA_MASK            0xFF
+#define ENABLE_BIT           BIT(0)
+#define ENABLE_ABORT         BIT(1)
+#define DMA_RX_ENABLE        BIT(0)
+#define DMA_TX_ENABLE        BIT(1)
+#define ABRT_7B_ADDR_NOACK   BIT(0)
+#define ABRT_USER_ABRT       BIT(16)
+#define STATUS_ACTIVITY      BIT(0)
+#define STATUS_TFNF          BIT(1)
+#define STATUS_TFE           BIT(2)
+#define STATUS_RFNE          BIT(3)
+#define LATCHED_EVENTS       (SL_I2C_EVENT_RECEIVE_OVER | SL_I2C_EVENT_TRANSMIT_OVER \
+                              | SL_I2C_EVENT_TRANSMIT_ABORT | SL_I2C_EVENT_STOP_DETECT)
+
+#define REG_CON              0x00
+#define REG_TAR              0x04
+#define REG_DATA_CMD         0x10
+#define REG_INTR_STAT        0x2C
+#define REG_INTR_MASK        0x30
+#define REG_RAW_INTR_STAT    0x34
+#define REG_RX_TL            0x38
+#define REG_TX_TL            0x3C
+#define REG_CLR_INTR         0x40
+#define REG_CLR_RX_OVER      0x48
+#define REG_CLR_TX_OVER      0x4C
+#define REG_CLR_TX_ABRT      0x54
+#define REG_CLR_STOP_DET     0x60
+#define REG_ENABLE           0x6C
+#define REG_STATUS           0x70
+#define REG_TXFLR            0x74
+#define REG_RXFLR            0x78
+#define REG_TX_ABRT_SOURCE   0x80
+#define REG_DMA_CR           0x88
+#define REG_DMA_TDLR         0x8C
+#define REG_DMA_RDLR         0x90
+
+/*******************************************************************************
+ ******************************  Data Types  ***********************************
+ ******************************************************************************/
+// Bus phase being shifted
+typedef enum {
+  PHASE_IDLE,    // Nothing on the bus, or the bus held waiting for a command
+  PHASE_ADDRESS, // Start or repeated start and the address byte
+  PHASE_DATA,    // Data byte
+  PHASE_STOP,    // Stop condition
+} phase_t;
+
+typedef struct {
+  uint32_t entries[FIFO_DEPTH];
+  uint32_t head;
+  uint32_t count;
+} fifo_t;
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static uint32_t registers[REGISTER_COUNT];
+static bool enabled = false;
+static fifo_t tx_fifo;
+static fifo_t rx_fifo;
+static uint32_t latched = 0;
+static uint32_t abort_source = 0;
+static uint32_t interrupt_mask = 0;
+static uint32_t tx_threshold = 0;
+static uint32_t rx_threshold = 0;
+static uint32_t dma_control = 0;
+static uint32_t dma_tx_level = 0;
+static uint32_t dma_rx_level = 0;
+static uint32_t bus_frequency = 100000;
+static uint16_t target_address = 0;
+
+static uint64_t engine_time = 0;
+static phase_t phase = PHASE_IDLE;
+static uint64_t phase_end = 0;
+static uint32_t command = 0;
+static bool in_transfer = false;
+static bool transfer_read = false;
+static bool stalled = false;
+
+static uint8_t follower_address = DEFAULT_FOLLOWER;
+static uint8_t follower_memory[SIM_I2C_FOLLOWER_SIZE];
+static uint32_t follower_pointer = 0;
+static uint32_t follower_bytes = 0;
+static sim_i2c_faults_t faults;
+static uint32_t sda_stuck_clocks = 0;
+
+static sim_i2c_log_entry_t *bus_log = NULL;
+static size_t bus_log_length = 0;
+static size_t bus_log_size = 0;
+static uint32_t config_writes = 0;
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static void fifo_push(fifo_t *fifo, uint32_t value);
+static uint32_t fifo_pop(fifo_t *fifo);
+static void push_command(uint32_t value);
+static uint32_t raw_status(void);
+static void serve_dma(void);
+static bool start_phase(void);
+static void end_phase(void);
+static void begin(phase_t next, uint32_t bits);
+static void abort_transfer(uint32_t source);
+static void disable(void);
+static void log_bus(sim_i2c_log_type_t type, uint8_t value);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Follower and bus log
+ ******************************************************************************/
+void sim_i2c_set_follower_address(uint8_t address)
+{
+  follower_address = address;
+}
+
+// The stall counts the bytes from the time the faults are set.
+void sim_i2c_set_faults(const sim_i2c_faults_t *new_faults)
+{
+  faults = *new_faults;
+  follower_bytes = 0;
+}
+
+const uint8_t *sim_i2c_get_follower_memory(void)
+{
+  return follower_memory;
+}
+
+size_t sim_i2c_get_log(const sim_i2c_log_entry_t **entries)
+{
+  *entries = bus_log;
+  return bus_log_length;
+}
+
+void sim_i2c_clear_log(void)
+{
+  bus_log_length = 0;
+}
+
+uint32_t sim_i2c_get_config_writes(void)
+{
+  return config_writes;
+}
+
+bool sim_i2c_follower_line(bool scl)
+{
+  if (scl) {
+    return !stalled;
+  }
+  return sda_stuck_clocks == 0;
+}
+
+void sim_i2c_scl_pulse(void)
+{
+  if (sda_stuck_clocks > 0) {
+    sda_stuck_clocks--;
+  }
+}
+
+/*******************************************************************************
+ * Runs the bus up to the given time. The DMA requests are served between
+ * the phases, as soon as the FIFO levels allow them.
+ ******************************************************************************/
+void sim_i2c_sync(uint64_t cycles)
+{
+  for (;;) {
+    serve_dma();
+    if (phase == PHASE_IDLE) {
+      if (!start_phase()) {
+        break;
+      }
+      continue;
+    }
+    if (stalled || (phase_end > cycles)) {
+      break;
+    }
+    engine_time = phase_end;
+    end_phase();
+  }
+  if (cycles > engine_time) {
+    engine_time = cycles;
+  }
+}
+
+uint64_t sim_i2c_next_event(void)
+{
+  if ((phase == PHASE_IDLE) || stalled) {
+    return SIM_NEVER;
+  }
+  return phase_end;
+}
+
+bool sim_i2c_irq_line(void)
+{
+  return (raw_status() & interrupt_mask) != 0;
+}
+
+/*******************************************************************************
+ * Register accesses
+ ******************************************************************************/
+uint32_t sim_i2c_read(uint32_t offset, bool side_effects)
+{
+  uint32_t value = 0;
+
+  switch (offset) {
+    case REG_DATA_CMD:
+      if (side_effects && (rx_fifo.count > 0)) {
+        value = fifo_pop(&rx_fifo);
+        sim_i2c_sync(sim_now);
+      }
+      return value;
+    case REG_INTR_STAT:
+      return raw_status() & interrupt_mask;
+    case REG_INTR_MASK:
+      return interrupt_mask;
+    case REG_RAW_INTR_STAT:
+      return raw_status();
+    case REG_RX_TL:
+      return rx_threshold;
+    case REG_TX_TL:
+      return tx_threshold;
+    case REG_CLR_INTR:
+      if (side_effects) {
+        latched = 0;
+        abort_source = 0;
+      }
+      return 0;
+    case REG_CLR_RX_OVER:
+      if (side_effects) {
+        latched &= ~SL_I2C_EVENT_RECEIVE_OVER;
+      }
+      return 0;
+    case REG_CLR_TX_OVER:
+      if (side_effects) {
+        latched &= ~SL_I2C_EVENT_TRANSMIT_OVER;
+      }
+      return 0;
+    case REG_CLR_TX_ABRT:
+      if (side_effects) {
+        latched &= ~SL_I2C_EVENT_TRANSMIT_ABORT;
+        abort_source = 0;
+      }
+      return 0;
+    case REG_CLR_STOP_DET:
+      if (side_effects) {
+        latched &= ~SL_I2C_EVENT_STOP_DETECT;
+      }
+      return 0;
+    case REG_ENABLE:
+      return enabled ? ENABLE_BIT : 0;
+    case REG_STATUS:
+      value = (tx_fifo.count < FIFO_DEPTH) ? STATUS_TFNF : 0;
+      value |= (tx_fifo.count == 0) ? STATUS_TFE : 0;
+      value |= (rx_fifo.count > 0) ? STATUS_RFNE : 0;
+      value |= in_transfer ? STATUS_ACTIVITY : 0;
+      return value;
+    case REG_TXFLR:
+      return tx_fifo.count;
+    case REG_RXFLR:
+      return rx_fifo.count;
+    case REG_TX_ABRT_SOURCE:
+      return abort_source;
+    case REG_DMA_CR:
+      return dma_control;
+    case REG_DMA_TDLR:
+      return dma_tx_level;
+    case REG_DMA_RDLR:
+      return dma_rx_level;
+    default:
+      return registers[offset / 4];
+  }
+}
+
+void sim_i2c_write(uint32_t offset, uint32_t value)
+{
+  switch (offset) {
+    case REG_TAR:
+      target_address = (uint16_t)(value & 0x3FF);
+      break;
+    case REG_DATA_CMD:
+      push_command(value);
+      break;
+    case REG_INTR_MASK:
+      interrupt_mask = value;
+      break;
+    case REG_RX_TL:
+      rx_threshold = value;
+      break;
+    case REG_TX_TL:
+      tx_threshold = value;
+      break;
+    case REG_ENABLE:
+      if (value & ENABLE_ABORT) {
+        abort_transfer(ABRT_USER_ABRT);
+      }
+      if (value & ENABLE_BIT) {
+        enabled = true;
+      } else {
+        disable();
+      }
+      break;
+    case REG_DMA_CR:
+      dma_control = value;
+      break;
+    case REG_DMA_TDLR:
+      dma_tx_level = value;
+      break;
+    case REG_DMA_RDLR:
+      dma_rx_level = value;
+      break;
+    default:
+      registers[offset / 4] = value;
+      break;
+  }
+  sim_i2c_sync(sim_now);
+}
+
+/*******************************************************************************
+ * Driver functions
+ ******************************************************************************/
+void sl_si91x_i2c_init(I2C0_Type *i2c, const sl_i2c_init_params_t *params)
+{
+  static const uint32_t frequencies[] = { 100000, 400000, 1000000, 3400000 };
+
+  (void)i2c;
+  sim_core_driver_entry();
+  disable();
+  if (params->clhr < (sizeof(frequencies) / sizeof(frequencies[0]))) {
+    bus_frequency = frequencies[params->clhr];
+  }
+  registers[REG_CON / 4] = params->mode;
+  interrupt_mask = 0;
+  latched = 0;
+  abort_source = 0;
+  tx_threshold = 0;
+  rx_threshold = 0;
+  sim_core_driver_exit();
+}
+
+void sl_si91x_i2c_enable(I2C0_Type *i2c)
+{
+  (void)i2c;
+  sim_core_driver_entry();
+  config_writes++;
+  sim_i2c_write(REG_ENABLE, ENABLE_BIT);
+  sim_core_driver_exit();
+}
+
+void sl_si91x_i2c_disable(I2C0_Type *i2c)
+{
+  (void)i2c;
+  sim_core_driver_entry();
+  config_writes++;
+  sim_i2c_write(REG_ENABLE, 0);
+  sim_core_driver_exit();
+}
+
+void sl_si91x_i2c_abort_transfer(I2C0_Type *i2c)
+{
+  (void)i2c;
+  sim_core_driver_entry();
+  abort_transfer(ABRT_USER_ABRT);
+  sim_core_driver_exit();
+}
+
+void sl_si91x_i2c_set_follower_address(I2C0_Type *i2c,
+                                       uint16_t address,
+                                       bool is_10bit_addr)
+{
+  (void)i2c;
+  (void)is_10bit_addr;
+  sim_core_driver_entry();
+  config_writes++;
+  target_address = address;
+  sim_core_driver_exit();
+}
+
+void sl_si91x_i2c_set_tx_threshold(I2C0_Type *i2c, uint8_t threshold)
+{
+  (void)i2c;
+  sim_core_driver_entry();
+  config_writes++;
+  tx_threshold = threshold;
+  sim_core_driver_exit();
+}
+
+void sl_si91x_i2c_set_rx_threshold(I2C0_Type *i2c, uint8_t threshold)
+{
+  (void)i2c;
+  sim_core_driver_entry();
+  config_writes++;
+  rx_threshold = threshold;
+  sim_core_driver_exit();
+}
+
+void sl_si91x_i2c_set_interrupts(I2C0_Type *i2c, uint32_t flags)
+{
+  (void)i2c;
+  sim_core_driver_entry();
+  config_writes++;
+  interrupt_mask |= flags;
+  sim_core_driver_exit();
+}
+
+void sl_si91x_i2c_enable_interrupts(I2C0_Type *i2c, uint32_t flags)
+{
+  (void)i2c;
+  sim_core_driver_entry();
+  config_writes++;
+  interrupt_mask |= flags;
+  NVIC_EnableIRQ(I2C2_IRQn);
+  sim_core_driver_exit();
+}
+
+void sl_si91x_i2c_disable_interrupts(I2C0_Type *i2c, uint32_t flags)
+{
+  (void)i2c;
+  sim_core_driver_entry();
+  config_writes++;
+  interrupt_mask = flags;
+  sim_core_driver_exit();
+}
+
+void sl_si91x_i2c_clear_interrupts(I2C0_Type *i2c, uint32_t flags)
+{
+  (void)i2c;
+  sim_core_driver_entry();
+  latched &= ~flags;
+  if (flags & SL_I2C_EVENT_TRANSMIT_ABORT) {
+    abort_source = 0;
+  }
+  sim_core_driver_exit();
+}
+
+void sl_si91x_i2c_tx(I2C0_Type *i2c, uint8_t data)
+{
+  (void)i2c;
+  sim_core_driver_entry();
+  push_command(data);
+  sim_i2c_sync(sim_now);
+  sim_core_driver_exit();
+}
+
+uint8_t sl_si91x_i2c_rx(I2C0_Type *i2c)
+{
+  uint8_t data = 0;
+
+  (void)i2c;
+  sim_core_driver_entry();
+  data = (uint8_t)sim_i2c_read(REG_DATA_CMD, true);
+  sim_core_driver_exit();
+  return data;
+}
+
+/*******************************************************************************
+ * Function helpers
+ ******************************************************************************/
+static void fifo_push(fifo_t *fifo, uint32_t value)
+{
+  fifo->entries[(fifo->head + fifo->count) % FIFO_DEPTH] = value;
+  fifo->count++;
+}
+
+static uint32_t fifo_pop(fifo_t *fifo)
+{
+  uint32_t value = fifo->entries[fifo->head];
+
+  fifo->head = (fifo->head + 1) % FIFO_DEPTH;
+  fifo->count--;
+  return value;
+}
+
+/*******************************************************************************
+ * Function to queue a command word, a full FIFO drops it.
+ *
+ * @param[in] value (uint32_t) IC_DATA_CMD word.
+ * @return none
+ ******************************************************************************/
+static void push_command(uint32_t value)
+{
+  if (!enabled) {
+    return;
+  }
+  if (tx_fifo.count >= FIFO_DEPTH) {
+    latched |= SL_I2C_EVENT_TRANSMIT_OVER;
+    return;
+  }
+  fifo_push(&tx_fifo, value);
+}
+
+/*******************************************************************************
+ * Function to compute the raw interrupt status, the FIFO levels against
+ * their thresholds and the latched events.
+ *
+ * @param none
+ * @return raw status
+ ******************************************************************************/
+static uint32_t raw_status(void)
+{
+  uint32_t status = latched;
+
+  if (enabled && (tx_fifo.count <= tx_threshold)) {
+    status |= SL_I2C_EVENT_TRANSMIT_EMPTY;
+  }
+  if (rx_fifo.count > rx_threshold) {
+    status |= SL_I2C_EVENT_RECEIVE_FULL;
+  }
+  return status;
+}
+
+/*******************************************************************************
+ * Function to serve the DMA handshake. The requests of the FIFOs are wired to
+ * the channels of sl_si91x_dma.h, a channel armed with another signal never
+ * moves.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void serve_dma(void)
+{
+  uint32_t value = 0;
+
+  if ((dma_control & DMA_TX_ENABLE) && (tx_fifo.count <= dma_tx_level)) {
+    while ((tx_fifo.count < FIFO_DEPTH)
+           && sim_dma_peripheral_read(SL_ULP_I2C_DMA_TX_CHANNEL, &value)) {
+      push_command(value);
+    }
+  }
+  if ((dma_control & DMA_RX_ENABLE) && (rx_fifo.count > dma_rx_level)) {
+    while ((rx_fifo.count > 0)
+           && sim_dma_has_request(SL_ULP_I2C_DMA_RX_CHANNEL)) {
+      sim_dma_peripheral_write(SL_ULP_I2C_DMA_RX_CHANNEL, fifo_pop(&rx_fifo));
+    }
+  }
+}
+
+/*******************************************************************************
+ * Function to start the next phase on an idle bus. The command is taken from
+ * the TX FIFO when its byte starts, a change of direction or the restart bit
+ * inserts a repeated start.
+ *
+ * @param none
+ * @return true if a phase started
+ ******************************************************************************/
+static bool start_phase(void)
+{
+  bool read = false;
+
+  if (!enabled || stalled || (tx_fifo.count == 0)) {
+    return false;
+  }
+  command = fifo_pop(&tx_fifo);
+  read = (command & CMD_READ) != 0;
+  if (!in_transfer) {
+    in_transfer = true;
+    transfer_read = read;
+    log_bus(SIM_I2C_START, (uint8_t)((target_address << 1) | read));
+    begin(PHASE_ADDRESS, BITS_PER_ADDRESS);
+  } else if ((read != transfer_read) || (command & CMD_RESTART)) {
+    transfer_read = read;
+    log_bus(SIM_I2C_RESTART, (uint8_t)((target_address << 1) | read));
+    begin(PHASE_ADDRESS, BITS_PER_ADDRESS);
+  } else {
+    begin(PHASE_DATA, BITS_PER_BYTE);
+  }
+  return true;
+}
+
+/*******************************************************************************
+ * Function to complete the phase shifted until engine_time.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void end_phase(void)
+{
+  uint8_t data = 0;
+
+  switch (phase) {
+    case PHASE_ADDRESS:
+      if (faults.absent || (target_address != follower_address)) {
+        log_bus(SIM_I2C_NACK, (uint8_t)((target_address << 1) | transfer_read));
+        abort_transfer(ABRT_7B_ADDR_NOACK);
+        return;
+      }
+      follower_pointer = 0;
+      begin(PHASE_DATA, BITS_PER_BYTE);
+      return;
+    case PHASE_DATA:
+      if (transfer_read) {
+        data = follower_memory[follower_pointer++ % SIM_I2C_FOLLOWER_SIZE];
+        log_bus(SIM_I2C_READ, data);
+        if (rx_fifo.count < FIFO_DEPTH) {
+          fifo_push(&rx_fifo, data);
+        } else {
+          latched |= SL_I2C_EVENT_RECEIVE_OVER;
+        }
+      } else {
+        data = (uint8_t)(command & DATA_MASK);
+        follower_memory[follower_pointer++ % SIM_I2C_FOLLOWER_SIZE] = data;
+        log_bus(SIM_I2C_WRITE, data);
+      }
+      follower_bytes++;
+      if ((faults.stall_after_bytes != 0)
+          && (follower_bytes == faults.stall_after_bytes)) {
+        // The follower holds SCL low, the bus never moves again.
+        faults.stall_after_bytes = 0;
+        stalled = true;
+        phase = PHASE_IDLE;
+        return;
+      }
+      if (command & CMD_STOP) {
+        begin(PHASE_STOP, BITS_PER_STOP);
+        return;
+      }
+      phase = PHASE_IDLE;
+      return;
+    case PHASE_STOP:
+      log_bus(SIM_I2C_STOP, 0);
+      latched |= SL_I2C_EVENT_STOP_DETECT;
+      in_transfer = false;
+      phase = PHASE_IDLE;
+      return;
+    default:
+      phase = PHASE_IDLE;
+      return;
+  }
+}
+
+static void begin(phase_t next, uint32_t bits)
+{
+  uint64_t bit_cycles = (sim_get_core_frequency() + bus_frequency - 1)
+                        / bus_frequency;
+
+  phase = next;
+  phase_end = engine_time + (bits * bit_cycles);
+}
+
+/*******************************************************************************
+ * Function to abort the transfer: the TX FIFO is flushed and a stop follows.
+ * An idle controller has nothing to abort.
+ *
+ * @param[in] source (uint32_t) IC_TX_ABRT_SOURCE bits.
+ * @return none
+ ******************************************************************************/
+static void abort_transfer(uint32_t source)
+{
+  if (!in_transfer) {
+    return;
+  }
+  tx_fifo.count = 0;
+  abort_source |= source;
+  latched |= SL_I2C_EVENT_TRANSMIT_ABORT;
+  if (stalled) {
+    // The stop cannot be sent while the follower holds SCL.
+    phase = PHASE_IDLE;
+    return;
+  }
+  begin(PHASE_STOP, BITS_PER_STOP);
+}
+
+/*******************************************************************************
+ * Function to disable the controller, the FIFOs are flushed and the bus is
+ * released. A stalled follower releases SCL and may keep SDA low.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void disable(void)
+{
+  enabled = false;
+  tx_fifo.count = 0;
+  rx_fifo.count = 0;
+  phase = PHASE_IDLE;
+  in_transfer = false;
+  if (stalled) {
+    stalled = false;
+    sda_stuck_clocks = faults.sda_stuck_clocks;
+  }
+}
+
+static void log_bus(sim_i2c_log_type_t type, uint8_t value)
+{
+  if (bus_log_length == bus_log_size) {
+    bus_log_size += LOG_CHUNK;
+    bus_log = realloc(bus_log, bus_log_size * sizeof(bus_log[0]));
+    if (bus_log == NULL) {
+      abort();
+    }
+  }
+  bus_log[bus_log_length].type = type;
+  bus_log[bus_log_length].value = value;
+  bus_log_length++;
+}
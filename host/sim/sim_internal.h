@@ -0,0 +1,85 @@
+/***************************************************************************/ /**
+ * @file sim_internal.h
+ * @brief Interfaces between the simulated core and peripherals
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef SIM_INTERNAL_H_
+#define SIM_INTERNAL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sim.h"
+
+// -----------------------------------------------------------------------------
+// Core
+
+// Current time, in core cycles
+extern uint64_t sim_now;
+
+// Advances the time by the cost of an access, the peripherals follow. No
+// interrupt is dispatched, this is safe from the access traps.
+void sim_core_spend(uint32_t cycles);
+
+// Brings the peripherals to the current time.
+void sim_core_sync(void);
+
+// Dispatches the pending interrupts allowed by PRIMASK and the priorities.
+void sim_core_dispatch(void);
+
+// Entry and exit of a driver call, the exit is an interrupt dispatch point.
+void sim_core_driver_entry(void);
+void sim_core_driver_exit(void);
+
+// Conversions between the clocks, exact to the cycle
+uint64_t sim_ps_to_cycles_ceil(uint64_t ps);
+uint64_t sim_cycles_to_ticks(uint64_t cycles);
+uint64_t sim_ticks_to_cycles_ceil(uint64_t ticks);
+uint64_t sim_ps_to_ticks(uint64_t ps);
+
+// -----------------------------------------------------------------------------
+// Config timer
+
+void sim_ct_sync(uint64_t cycles);
+uint64_t sim_ct_next_event(void);
+bool sim_ct_irq_line(void);
+uint32_t sim_ct_read(uint32_t offset, bool side_effects);
+void sim_ct_write(uint32_t offset, uint32_t value);
+
+// -----------------------------------------------------------------------------
+// ULP_I2C
+
+void sim_i2c_sync(uint64_t cycles);
+uint64_t sim_i2c_next_event(void);
+bool sim_i2c_irq_line(void);
+uint32_t sim_i2c_read(uint32_t offset, bool side_effects);
+void sim_i2c_write(uint32_t offset, uint32_t value);
+// Level the follower leaves on SCL or SDA, false while it holds the line low
+bool sim_i2c_follower_line(bool scl);
+// SCL pulse generated with the pin as a GPIO
+void sim_i2c_scl_pulse(void);
+
+// -----------------------------------------------------------------------------
+// DMA
+
+// Element for a memory to peripheral channel serving the request, false if
+// no channel serves it.
+bool sim_dma_peripheral_read(uint8_t signal, uint32_t *value);
+// Element from the peripheral for a peripheral to memory channel.
+bool sim_dma_peripheral_write(uint8_t signal, uint32_t value);
+// A channel serving the request is armed.
+bool sim_dma_has_request(uint8_t signal);
+bool sim_dma_irq_line(void);
+void sim_dma_irq_handler(void);
+
+#endif /* SIM_INTERNAL_H_ */
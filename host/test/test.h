@@ -0,0 +1,67 @@
+/***************************************************************************/ /**
+ * @file host/test/test.h
+ * @brief Assertions of the host tests
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+// Fails the test, with the location and the failed condition
+#define TEST_ASSERT(condition)                                        \
+  do {                                                                \
+    if (!(condition)) {                                               \
+      fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+      exit(EXIT_FAILURE);                                             \
+    }                                                                 \
+  } while (0)
+
+// Fails the test if two integers differ, with both values
+#define TEST_ASSERT_EQUAL(expected, actual)                           \
+  do {                                                                \
+    unsigned long long expected_ = (unsigned long long)(expected);    \
+    unsigned long long actual_ = (unsigned long long)(actual);        \
+    if (expected_ != actual_) {                                       \
+      fprintf(stderr, "%s:%d: %s == %s, expected %llu, got %llu\n",   \
+              __FILE__, __LINE__, #expected, #actual,                 \
+              expected_, actual_);                                    \
+      exit(EXIT_FAILURE);                                             \
+    }                                                                 \
+  } while (0)
+
+// Fails the test if a value is outside [low, high]
+#define TEST_ASSERT_RANGE(low, high, actual)                          \
+  do {                                                                \
+    double actual_ = (double)(actual);                                \
+    if ((actual_ < (double)(low)) || (actual_ > (double)(high))) {    \
+      fprintf(stderr, "%s:%d: %s = %g, outside [%g, %g]\n",           \
+              __FILE__, __LINE__, #actual, actual_,                   \
+              (double)(low), (double)(high));                         \
+      exit(EXIT_FAILURE);                                             \
+    }                                                                 \
+  } while (0)
+
+// Runs one test case and reports it
+#define TEST_RUN(test)            \
+  do {                            \
+    test();                       \
+    printf("PASS %s\n", #test);   \
+  } while (0)
+
+#endif /* TEST_H_ */
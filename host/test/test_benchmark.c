@@ -0,0 +1,112 @@
+/***************************************************************************/ /**
+ * @file host/test/test_benchmark.c
+ * @brief Host test of the cycle benchmarks
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "benchmark.h"
+#include "sim.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define CALL_CYCLES 250 // Cycles spent by the measured function
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Function measured by the tests, it spends the cycles given by its context.
+ *
+ * @param[in] context (uint32_t) Cycles to spend.
+ * @return none
+ ******************************************************************************/
+static void spend_cycles(void *context)
+{
+  sim_advance(*(const uint32_t *)context);
+}
+
+/*******************************************************************************
+ * The cost per unit is exact once the measurement overhead is removed, and
+ * compared with the threshold.
+ ******************************************************************************/
+static void test_run(void)
+{
+  uint32_t cycles = CALL_CYCLES;
+
+  benchmark_init();
+  sim_console_clear();
+  TEST_ASSERT(benchmark_run("pass", spend_cycles, &cycles, 4, 10, 25));
+  TEST_ASSERT(strstr(sim_console_get(),
+                     "{\"benchmark\":\"pass\",\"iterations\":4,\"units\":40,"
+                     "\"cycles_min\":250,\"cycles_max\":250,"
+                     "\"cycles_per_unit\":25.00,\"threshold\":25,"
+                     "\"result\":\"pass\"}\n") != NULL);
+  TEST_ASSERT(!benchmark_run("fail", spend_cycles, &cycles, 4, 10, 24));
+  TEST_ASSERT(strstr(sim_console_get(), "\"result\":\"fail\"") != NULL);
+  TEST_ASSERT_EQUAL(1, benchmark_print_summary());
+}
+
+/*******************************************************************************
+ * A number of units past 32 bits is not wrapped into a cheap result, it is
+ * reported as invalid.
+ ******************************************************************************/
+static void test_units_overflow(void)
+{
+  uint32_t cycles = CALL_CYCLES;
+
+  benchmark_init();
+  sim_console_clear();
+  // 2 * (2^31 + 1) units wrap to 2 on 32 bits, 250 cycles per unit.
+  TEST_ASSERT(!benchmark_run("wrap", spend_cycles, &cycles, 2, 0x80000001,
+                             1000));
+  TEST_ASSERT(strstr(sim_console_get(), "\"units\":0,") != NULL);
+  TEST_ASSERT(strstr(sim_console_get(), "\"result\":\"invalid\"") != NULL);
+  TEST_ASSERT(!benchmark_run("none", spend_cycles, &cycles, 0, 10, 1000));
+  TEST_ASSERT_EQUAL(2, benchmark_print_summary());
+}
+
+/*******************************************************************************
+ * An external measurement has no per call values, they are left out. A
+ * report without units does not divide by zero, and large totals do not
+ * overflow.
+ ******************************************************************************/
+static void test_report(void)
+{
+  benchmark_init();
+  sim_console_clear();
+  TEST_ASSERT(benchmark_report("handler", 1000, 123456, 150));
+  TEST_ASSERT(strstr(sim_console_get(),
+                     "{\"benchmark\":\"handler\",\"iterations\":1,\"units\":1000,"
+                     "\"cycles_per_unit\":123.45,\"threshold\":150,"
+                     "\"result\":\"pass\"}\n") != NULL);
+  TEST_ASSERT(strstr(sim_console_get(), "cycles_min") == NULL);
+  TEST_ASSERT(!benchmark_report("empty", 0, 123456, 150));
+  TEST_ASSERT(strstr(sim_console_get(), "\"result\":\"invalid\"") != NULL);
+  // Totals past 2^64 / 100 cycles keep their cost per unit.
+  TEST_ASSERT(benchmark_report("long", 4000000000U, UINT64_MAX / 2, UINT32_MAX));
+  TEST_ASSERT(strstr(sim_console_get(), "\"cycles_per_unit\":2305843009.21,")
+              != NULL);
+  TEST_ASSERT(!benchmark_report("saturated", 1, UINT64_MAX, UINT32_MAX));
+  TEST_ASSERT_EQUAL(2, benchmark_print_summary());
+}
+
+int main(void)
+{
+  TEST_RUN(test_run);
+  TEST_RUN(test_units_overflow);
+  TEST_RUN(test_report);
+  return 0;
+}
@@ -0,0 +1,342 @@
+/***************************************************************************/ /**
+ * @file host/test/test_capture_export.c
+ * @brief Host test and throughput benchmark of the capture export
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "capture_decode.h"
+#include "capture_export.h"
+#include "capture_ring.h"
+#include "capture_timebase.h"
+#include "capture_timer.h"
+#include "sim.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define TIMESTAMPS_MAX     4096
+#define LINK_SIZE          65536 // Bytes recorded from the link
+#define SIGNAL_PERIOD_PS   50000000ULL // 20 kHz
+#define SIGNAL_HIGH_PS     25000000ULL
+#define BENCHMARK_CAPTURES 1000
+#define LOOP_US            500   // Main loop period of the benchmark
+#define UART_BAUD_RATE     115200 // Debug UART, 8N1
+#define UART_BITS_PER_BYTE 10
+#define TEXT_LINE_MAX      48
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static capture_export_t exporter;
+static capture_decode_t decoder;
+static uint8_t link_bytes[LINK_SIZE];
+static uint32_t link_length = 0;
+static uint64_t sent[TIMESTAMPS_MAX];
+static uint64_t received[TIMESTAMPS_MAX];
+static bool received_gaps[TIMESTAMPS_MAX];
+static uint32_t received_count = 0;
+static uint32_t random_state = 1;
+static capture_timebase_t timebase;
+static capture_ring_t ring;
+static sim_square_wave_t wave;
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+void CAPTURE_TIMER_IRQHandler(void)
+{
+  uint64_t edge = 0;
+
+  if (capture_timer_service(&timebase, &edge) & CAPTURE_TIMER_CAPTURE_EVENT) {
+    capture_ring_push(&ring, edge);
+  }
+}
+
+/*******************************************************************************
+ * Function to draw a pseudo-random number, reproducible from run to run.
+ *
+ * @param none
+ * @return pseudo-random 32-bit number
+ ******************************************************************************/
+static uint32_t random_next(void)
+{
+  random_state = (random_state * 1664525) + 1013904223;
+  return random_state;
+}
+
+/*******************************************************************************
+ * Function to record the bytes written on the link.
+ *
+ * @param[in] data (uint8_t) Bytes to send.
+ * @param[in] length (uint32_t) Number of bytes.
+ * @return none
+ ******************************************************************************/
+static void link_write(const uint8_t *data, uint32_t length)
+{
+  TEST_ASSERT(link_length + length <= LINK_SIZE);
+  memcpy(&link_bytes[link_length], data, length);
+  link_length += length;
+}
+
+/*******************************************************************************
+ * Function to store a decoded timestamp.
+ *
+ * @param[in] context (void) Unused.
+ * @param[in] timestamp (uint64_t) Decoded timestamp.
+ * @param[in] gap (bool) Captures or frames were lost before it.
+ * @return none
+ ******************************************************************************/
+static void store_timestamp(void *context, uint64_t timestamp, bool gap)
+{
+  (void)context;
+  TEST_ASSERT(received_count < TIMESTAMPS_MAX);
+  received[received_count] = timestamp;
+  received_gaps[received_count] = gap;
+  received_count++;
+}
+
+/*******************************************************************************
+ * Function to clear the link, the decoder and the exporter.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void reset_link(void)
+{
+  capture_export_init(&exporter);
+  capture_decode_init(&decoder);
+  link_length = 0;
+  received_count = 0;
+}
+
+/*******************************************************************************
+ * Function to send every queued byte, in chunks of random size, and decode
+ * the link in chunks of other sizes.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void transmit_and_decode(void)
+{
+  uint32_t start = link_length;
+  uint32_t offset = 0;
+  uint32_t chunk = 0;
+
+  while (capture_export_transmit(&exporter, link_write,
+                                 1 + (random_next() % 100)) > 0) {
+  }
+  for (offset = start; offset < link_length; offset += chunk) {
+    chunk = 1 + (random_next() % 37);
+    if (chunk > (link_length - offset)) {
+      chunk = link_length - offset;
+    }
+    capture_decode_feed(&decoder, &link_bytes[offset], chunk, store_timestamp,
+                        NULL);
+  }
+}
+
+/*******************************************************************************
+ * Timestamps with deltas of every varint length, and lost captures, come back
+ * out of the decoder unchanged.
+ ******************************************************************************/
+static void test_round_trip(void)
+{
+  uint64_t timestamp = 0x0123456789ULL;
+  uint32_t lost_total = 0;
+
+  reset_link();
+  for (uint32_t index = 0; index < TIMESTAMPS_MAX; index++) {
+    uint32_t lost = ((index % 500) == 499) ? (index / 100) : 0;
+
+    timestamp += (uint64_t)random_next() >> (random_next() % 32);
+    if ((index % 1000) == 999) {
+      timestamp += 1ULL << 50;
+    }
+    sent[index] = timestamp;
+    lost_total += lost;
+    capture_export_add(&exporter, timestamp, lost);
+    if ((index % 50) == 0) {
+      transmit_and_decode();
+    }
+  }
+  capture_export_flush(&exporter);
+  transmit_and_decode();
+  TEST_ASSERT_EQUAL(0, capture_export_get_frames_dropped(&exporter));
+  TEST_ASSERT_EQUAL(TIMESTAMPS_MAX, received_count);
+  for (uint32_t index = 0; index < TIMESTAMPS_MAX; index++) {
+    TEST_ASSERT_EQUAL(sent[index], received[index]);
+    TEST_ASSERT_EQUAL((index % 500) == 499, received_gaps[index]);
+  }
+  TEST_ASSERT_EQUAL(lost_total, decoder.captures_lost);
+  TEST_ASSERT_EQUAL(0, decoder.frames_missed);
+  TEST_ASSERT_EQUAL(0, decoder.frames_invalid);
+  TEST_ASSERT_EQUAL(exporter.sequence, decoder.frames);
+}
+
+/*******************************************************************************
+ * The transmit queue indexes wrap around 2^32 without corrupting the frames.
+ ******************************************************************************/
+static void test_queue_index_wrap(void)
+{
+  reset_link();
+  exporter.tx_head = UINT32_MAX - 100;
+  exporter.tx_tail = UINT32_MAX - 100;
+  for (uint32_t index = 0; index < 1000; index++) {
+    sent[index] = 1000000 + (index * 400ULL);
+    capture_export_add(&exporter, sent[index], 0);
+    if ((index % 40) == 0) {
+      transmit_and_decode();
+    }
+  }
+  capture_export_flush(&exporter);
+  transmit_and_decode();
+  TEST_ASSERT(exporter.tx_head < CAPTURE_EXPORT_TX_SIZE * 10);
+  TEST_ASSERT_EQUAL(1000, received_count);
+  for (uint32_t index = 0; index < 1000; index++) {
+    TEST_ASSERT_EQUAL(sent[index], received[index]);
+  }
+  TEST_ASSERT_EQUAL(0, decoder.frames_invalid);
+}
+
+/*******************************************************************************
+ * Frames dropped on a full transmit queue are seen as missed by the decoder,
+ * and the next decoded timestamp is flagged.
+ ******************************************************************************/
+static void test_dropped_frames(void)
+{
+  reset_link();
+  for (uint32_t index = 0; index < 2000; index++) {
+    capture_export_add(&exporter, index * 40000ULL, 0);
+  }
+  capture_export_flush(&exporter);
+  TEST_ASSERT(capture_export_get_frames_dropped(&exporter) > 0);
+  transmit_and_decode();
+  capture_export_add(&exporter, 2000 * 40000ULL, 0);
+  capture_export_flush(&exporter);
+  transmit_and_decode();
+  TEST_ASSERT_EQUAL(capture_export_get_frames_dropped(&exporter),
+                    decoder.frames_missed);
+  TEST_ASSERT(received_gaps[received_count - 1]);
+  TEST_ASSERT_EQUAL(2000 * 40000ULL, received[received_count - 1]);
+  TEST_ASSERT_EQUAL(0, decoder.frames_invalid);
+}
+
+/*******************************************************************************
+ * A corrupted frame is discarded whole, the decoder finds the next one after
+ * noise holding false sync bytes.
+ ******************************************************************************/
+static void test_corruption(void)
+{
+  static const uint8_t noise[] = { 0x00, CAPTURE_EXPORT_SYNC_0,
+                                   CAPTURE_EXPORT_SYNC_0, CAPTURE_EXPORT_SYNC_1,
+                                   0x01, 0x00, 0x00, 0x05, 0x03, 0xFF };
+  uint32_t first_frame_length = 0;
+
+  reset_link();
+  link_write(noise, sizeof(noise));
+  for (uint32_t index = 0; index < 3 * CAPTURE_EXPORT_RECORDS_MAX; index++) {
+    capture_export_add(&exporter, index * 1000ULL, 0);
+    if (index == CAPTURE_EXPORT_RECORDS_MAX - 1) {
+      while (capture_export_transmit(&exporter, link_write, UINT32_MAX) > 0) {
+      }
+      first_frame_length = link_length - sizeof(noise);
+    }
+  }
+  while (capture_export_transmit(&exporter, link_write, UINT32_MAX) > 0) {
+  }
+  // One payload bit of the second frame is flipped.
+  link_bytes[sizeof(noise) + first_frame_length + CAPTURE_EXPORT_HEADER_SIZE
+             + 3] ^= 0x10;
+  capture_decode_feed(&decoder, link_bytes, link_length, store_timestamp, NULL);
+  TEST_ASSERT_EQUAL(2, decoder.frames);
+  TEST_ASSERT(decoder.frames_invalid >= 1);
+  TEST_ASSERT_EQUAL(1, decoder.frames_missed);
+  TEST_ASSERT_EQUAL(2 * CAPTURE_EXPORT_RECORDS_MAX, received_count);
+  TEST_ASSERT_EQUAL(0, received[0]);
+  TEST_ASSERT(received_gaps[CAPTURE_EXPORT_RECORDS_MAX]);
+  TEST_ASSERT_EQUAL(2 * CAPTURE_EXPORT_RECORDS_MAX * 1000ULL,
+                    received[CAPTURE_EXPORT_RECORDS_MAX]);
+}
+
+/*******************************************************************************
+ * Benchmark of the binary export against the text path of the pulse capture
+ * example, on captures of a simulated 20 kHz signal. Both are bound by the
+ * debug UART, so the throughput is the link rate over the bytes sent per
+ * capture. The binary stream is decoded back to the captures.
+ ******************************************************************************/
+static void test_throughput(void)
+{
+  uint64_t captures[CAPTURE_RING_SIZE];
+  char line[TEXT_LINE_MAX];
+  uint32_t captured = 0;
+  uint32_t count = 0;
+  uint64_t text_bytes = 0;
+  uint32_t text_rate = 0;
+  uint32_t binary_rate = 0;
+  uint32_t link_rate = UART_BAUD_RATE / UART_BITS_PER_BYTE;
+
+  reset_link();
+  capture_ring_init(&ring);
+  capture_timebase_init(&timebase, CAPTURE_TIMER_COUNTER_BITS);
+  sim_ct_square_wave(&wave, 0, SIGNAL_PERIOD_PS, SIGNAL_HIGH_PS,
+                     sim_get_time_ps() + SIGNAL_PERIOD_PS);
+  sim_ct_set_edge_source(sim_ct_square_wave_source, &wave);
+  capture_timer_init(CAPTURE_TIMER_CAPTURE_EVENT | CAPTURE_TIMER_WRAP_EVENT,
+                     CAPTURE_TIMER_FALLING_EDGE);
+  while (captured < BENCHMARK_CAPTURES) {
+    sim_advance_us(LOOP_US);
+    count = capture_ring_pop_batch(&ring, captures, NULL, CAPTURE_RING_SIZE);
+    for (uint32_t index = 0; (index < count) && (captured < BENCHMARK_CAPTURES);
+         index++) {
+      sent[captured++] = captures[index];
+      capture_export_add(&exporter, captures[index], 0);
+      text_bytes += snprintf(line, sizeof(line), "capture value 0x%08lX%08lX\n",
+                             (unsigned long)(captures[index] >> 32),
+                             (unsigned long)(uint32_t)captures[index]);
+    }
+    transmit_and_decode();
+  }
+  capture_export_flush(&exporter);
+  transmit_and_decode();
+  TEST_ASSERT_EQUAL(0, capture_ring_get_overruns(&ring));
+  TEST_ASSERT_EQUAL(BENCHMARK_CAPTURES, received_count);
+  for (uint32_t index = 0; index < BENCHMARK_CAPTURES; index++) {
+    TEST_ASSERT_EQUAL(sent[index], received[index]);
+  }
+
+  text_rate = (uint32_t)(((uint64_t)link_rate * BENCHMARK_CAPTURES) / text_bytes);
+  binary_rate = (uint32_t)(((uint64_t)link_rate * BENCHMARK_CAPTURES) / link_length);
+  printf("BENCH capture_export: %lu captures, text %lu bytes %lu captures/s, "
+         "binary %lu bytes %lu captures/s at %lu baud\n",
+         (unsigned long)BENCHMARK_CAPTURES,
+         (unsigned long)text_bytes, (unsigned long)text_rate,
+         (unsigned long)link_length, (unsigned long)binary_rate,
+         (unsigned long)UART_BAUD_RATE);
+  TEST_ASSERT_EQUAL(33 * BENCHMARK_CAPTURES, text_bytes);
+  // About 2.2 bytes per capture, framing included.
+  TEST_ASSERT(link_length <= (22 * BENCHMARK_CAPTURES) / 10);
+  TEST_ASSERT(binary_rate > 10 * text_rate);
+}
+
+int main(void)
+{
+  TEST_RUN(test_round_trip);
+  TEST_RUN(test_queue_index_wrap);
+  TEST_RUN(test_dropped_frames);
+  TEST_RUN(test_corruption);
+  TEST_RUN(test_throughput);
+  return 0;
+}
@@ -0,0 +1,192 @@
+/***************************************************************************/ /**
+ * @file host/test/test_capture_ring.c
+ * @brief Host test of the capture timestamp ring
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdbool.h>
+
+#include "capture_ring.h"
+#include "capture_timer.h"
+#include "sim.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SIGNAL_PERIOD_PS  10000000ULL // 100 kHz
+#define SIGNAL_HIGH_PS    5000000ULL
+#define CONSUMER_STEP_US  200         // Time between two consumer batches
+#define CONSUMER_STEPS    50
+#define SLOW_STEPS        3           // Consumer batches skipped, forcing drops
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static capture_ring_t ring;
+static volatile uint32_t captures = 0;
+static sim_square_wave_t wave;
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+void CAPTURE_TIMER_IRQHandler(void)
+{
+  uint32_t status = RSI_CT_GetInterruptStatus(CAPTURE_TIMER_BASE);
+
+  RSI_CT_InterruptClear(CAPTURE_TIMER_BASE, status);
+  if (status & CAPTURE_TIMER_CAPTURE_EVENT) {
+    capture_ring_push(&ring, CAPTURE_TIMER_BASE->CT_CAPTURE_REG);
+    captures++;
+  }
+}
+
+/*******************************************************************************
+ * Timestamps come out in order, in batches of any size.
+ ******************************************************************************/
+static void test_fifo_order(void)
+{
+  uint64_t timestamps[CAPTURE_RING_SIZE];
+  bool gaps[CAPTURE_RING_SIZE];
+  uint64_t expected = 0;
+  uint32_t count = 0;
+
+  capture_ring_init(&ring);
+  TEST_ASSERT_EQUAL(0, capture_ring_pop_batch(&ring, timestamps, gaps, CAPTURE_RING_SIZE));
+  for (uint64_t value = 0; value < 10; value++) {
+    TEST_ASSERT(capture_ring_push(&ring, value * 1000));
+  }
+  TEST_ASSERT_EQUAL(10, capture_ring_get_count(&ring));
+  count = capture_ring_pop_batch(&ring, timestamps, gaps, 3);
+  TEST_ASSERT_EQUAL(3, count);
+  for (uint32_t index = 0; index < count; index++) {
+    TEST_ASSERT_EQUAL(expected, timestamps[index]);
+    TEST_ASSERT(!gaps[index]);
+    expected += 1000;
+  }
+  count = capture_ring_pop_batch(&ring, timestamps, NULL, CAPTURE_RING_SIZE);
+  TEST_ASSERT_EQUAL(7, count);
+  for (uint32_t index = 0; index < count; index++) {
+    TEST_ASSERT_EQUAL(expected, timestamps[index]);
+    expected += 1000;
+  }
+  TEST_ASSERT_EQUAL(0, capture_ring_get_count(&ring));
+}
+
+/*******************************************************************************
+ * A full ring drops and counts the new timestamps, the next stored one is
+ * flagged as following a gap.
+ ******************************************************************************/
+static void test_overrun_gap(void)
+{
+  uint64_t timestamps[CAPTURE_RING_SIZE];
+  bool gaps[CAPTURE_RING_SIZE];
+
+  capture_ring_init(&ring);
+  for (uint64_t value = 0; value < CAPTURE_RING_SIZE; value++) {
+    TEST_ASSERT(capture_ring_push(&ring, value));
+  }
+  TEST_ASSERT(!capture_ring_push(&ring, CAPTURE_RING_SIZE));
+  TEST_ASSERT(!capture_ring_push(&ring, CAPTURE_RING_SIZE + 1));
+  TEST_ASSERT_EQUAL(2, capture_ring_get_overruns(&ring));
+  TEST_ASSERT_EQUAL(1, capture_ring_pop_batch(&ring, timestamps, gaps, 1));
+  TEST_ASSERT(capture_ring_push(&ring, CAPTURE_RING_SIZE + 2));
+  TEST_ASSERT_EQUAL(CAPTURE_RING_SIZE,
+                    capture_ring_pop_batch(&ring, timestamps, gaps, CAPTURE_RING_SIZE));
+  for (uint32_t index = 0; index < CAPTURE_RING_SIZE - 1; index++) {
+    TEST_ASSERT_EQUAL(index + 1, timestamps[index]);
+    TEST_ASSERT(!gaps[index]);
+  }
+  TEST_ASSERT_EQUAL(CAPTURE_RING_SIZE + 2, timestamps[CAPTURE_RING_SIZE - 1]);
+  TEST_ASSERT(gaps[CAPTURE_RING_SIZE - 1]);
+  // The flag is only set once.
+  TEST_ASSERT(capture_ring_push(&ring, 0));
+  TEST_ASSERT_EQUAL(1, capture_ring_pop_batch(&ring, timestamps, gaps, 1));
+  TEST_ASSERT(!gaps[0]);
+}
+
+/*******************************************************************************
+ * The free-running indexes wrap around 2^32.
+ ******************************************************************************/
+static void test_index_wrap(void)
+{
+  uint64_t timestamps[CAPTURE_RING_SIZE];
+
+  capture_ring_init(&ring);
+  ring.head = UINT32_MAX - 2;
+  ring.tail = UINT32_MAX - 2;
+  for (uint64_t value = 0; value < CAPTURE_RING_SIZE; value++) {
+    TEST_ASSERT(capture_ring_push(&ring, value));
+  }
+  TEST_ASSERT(!capture_ring_push(&ring, 0));
+  TEST_ASSERT_EQUAL(CAPTURE_RING_SIZE, capture_ring_get_count(&ring));
+  TEST_ASSERT_EQUAL(CAPTURE_RING_SIZE,
+                    capture_ring_pop_batch(&ring, timestamps, NULL, CAPTURE_RING_SIZE));
+  for (uint32_t index = 0; index < CAPTURE_RING_SIZE; index++) {
+    TEST_ASSERT_EQUAL(index, timestamps[index]);
+  }
+}
+
+/*******************************************************************************
+ * Captures pushed by the interrupt handler while the main loop reads them.
+ * When the main loop falls behind, timestamps are dropped, and the pairs
+ * without a gap flag are always one signal period apart.
+ ******************************************************************************/
+static void test_interrupt_producer(void)
+{
+  uint64_t timestamps[CAPTURE_RING_SIZE];
+  bool gaps[CAPTURE_RING_SIZE];
+  uint32_t period = (uint32_t)((SIGNAL_PERIOD_PS * sim_get_ct_frequency())
+                               / 1000000000000ULL);
+  uint64_t previous = 0;
+  bool previous_valid = false;
+  uint32_t popped = 0;
+  uint32_t gap_count = 0;
+  uint32_t count = 0;
+
+  capture_ring_init(&ring);
+  sim_ct_square_wave(&wave, 0, SIGNAL_PERIOD_PS, SIGNAL_HIGH_PS,
+                     sim_get_time_ps() + SIGNAL_PERIOD_PS);
+  sim_ct_set_edge_source(sim_ct_square_wave_source, &wave);
+  capture_timer_init(CAPTURE_TIMER_CAPTURE_EVENT, CAPTURE_TIMER_RISING_EDGE);
+  for (uint32_t step = 0; step < CONSUMER_STEPS; step++) {
+    sim_advance_us(CONSUMER_STEP_US);
+    if ((step % 10) < SLOW_STEPS) {
+      continue;
+    }
+    count = capture_ring_pop_batch(&ring, timestamps, gaps, CAPTURE_RING_SIZE);
+    for (uint32_t index = 0; index < count; index++) {
+      if (gaps[index]) {
+        gap_count++;
+      } else if (previous_valid) {
+        TEST_ASSERT_EQUAL(period, timestamps[index] - previous);
+      }
+      previous = timestamps[index];
+      previous_valid = true;
+    }
+    popped += count;
+  }
+  TEST_ASSERT(capture_ring_get_overruns(&ring) > 0);
+  TEST_ASSERT(gap_count > 0);
+  TEST_ASSERT_EQUAL(captures, popped + capture_ring_get_count(&ring)
+                    + capture_ring_get_overruns(&ring));
+}
+
+int main(void)
+{
+  TEST_RUN(test_fifo_order);
+  TEST_RUN(test_overrun_gap);
+  TEST_RUN(test_index_wrap);
+  TEST_RUN(test_interrupt_producer);
+  return 0;
+}
@@ -0,0 +1,141 @@
+/***************************************************************************/ /**
+ * @file host/test/test_capture_timebase.c
+ * @brief Host test of the capture timebase extension
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "capture_timebase.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define WRAPS        3    // Wraps crossed by each scenario
+#define DRAWS        5000 // Random captures checked per counter width
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static const uint8_t counter_widths[] = { 16, 32 };
+static uint32_t random_state = 1;
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Function to draw a pseudo-random number, reproducible from run to run.
+ *
+ * @param none
+ * @return pseudo-random 32-bit number
+ ******************************************************************************/
+static uint32_t random_next(void)
+{
+  random_state = (random_state * 1664525) + 1013904223;
+  return random_state;
+}
+
+/*******************************************************************************
+ * The wraps counted by the handler extend the counter to 64 bits.
+ ******************************************************************************/
+static void test_wrap_count(void)
+{
+  capture_timebase_t timebase;
+
+  for (uint32_t w = 0; w < sizeof(counter_widths); w++) {
+    capture_timebase_init(&timebase, counter_widths[w]);
+    TEST_ASSERT_EQUAL(0, timebase.epoch);
+    TEST_ASSERT_EQUAL((1ULL << counter_widths[w]) - 1, timebase.counter_mask);
+    for (uint32_t wrap = 0; wrap < WRAPS; wrap++) {
+      capture_timebase_wrap(&timebase);
+    }
+    TEST_ASSERT_EQUAL((uint64_t)WRAPS << counter_widths[w],
+                      capture_timebase_extend(&timebase, 0, false));
+    TEST_ASSERT_EQUAL(((uint64_t)WRAPS << counter_widths[w]) | 1234,
+                      capture_timebase_extend(&timebase, 1234, false));
+  }
+}
+
+/*******************************************************************************
+ * A capture just before or just after a wrap still pending in the handler is
+ * placed on the right side of it, for handler latencies up to half a range.
+ ******************************************************************************/
+static void test_extend_pending_wrap(void)
+{
+  capture_timebase_t timebase;
+  uint64_t range = 0;
+  uint64_t wrap_time = 0;
+  uint64_t handler_time = 0;
+  uint64_t latencies[4] = { 0 };
+  int64_t offsets[] = { -1000, -2, -1, 0, 1, 2, 1000 };
+
+  for (uint32_t w = 0; w < sizeof(counter_widths); w++) {
+    capture_timebase_init(&timebase, counter_widths[w]);
+    range = (uint64_t)timebase.counter_mask + 1;
+    wrap_time = WRAPS * range;
+    latencies[0] = 0;
+    latencies[1] = 1;
+    latencies[2] = 1001;
+    latencies[3] = (range / 2) - 1001;
+    for (uint32_t o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+      uint64_t capture_time = wrap_time + offsets[o];
+
+      for (uint32_t l = 0; l < sizeof(latencies) / sizeof(latencies[0]); l++) {
+        handler_time = capture_time + latencies[l];
+        // The handler counts the wraps before the last one, the last is
+        // pending when the handler runs after it.
+        timebase.epoch = (uint32_t)(handler_time >> counter_widths[w]);
+        if (handler_time >= wrap_time) {
+          timebase.epoch = WRAPS - 1;
+        }
+        TEST_ASSERT_EQUAL(capture_time,
+                          capture_timebase_extend(&timebase,
+                                                  (uint32_t)(capture_time & timebase.counter_mask),
+                                                  handler_time >= wrap_time));
+      }
+    }
+  }
+}
+
+/*******************************************************************************
+ * Extension against a later counter read is exact up to one full range.
+ ******************************************************************************/
+static void test_extend_at(void)
+{
+  capture_timebase_t timebase;
+  uint64_t range = 0;
+  uint64_t capture_time = 0;
+  uint64_t read_time = 0;
+
+  for (uint32_t w = 0; w < sizeof(counter_widths); w++) {
+    capture_timebase_init(&timebase, counter_widths[w]);
+    range = (uint64_t)timebase.counter_mask + 1;
+    for (uint32_t step = 0; step < DRAWS; step++) {
+      capture_time = (WRAPS * range) + (random_next() & timebase.counter_mask)
+                     - (range / 2);
+      read_time = capture_time + (random_next() % range);
+      timebase.epoch = (uint32_t)(read_time >> counter_widths[w]);
+      TEST_ASSERT_EQUAL(capture_time,
+                        capture_timebase_extend_at(&timebase,
+                                                   (uint32_t)(capture_time & timebase.counter_mask),
+                                                   (uint32_t)(read_time & timebase.counter_mask)));
+    }
+  }
+}
+
+int main(void)
+{
+  TEST_RUN(test_wrap_count);
+  TEST_RUN(test_extend_pending_wrap);
+  TEST_RUN(test_extend_at);
+  return 0;
+}
@@ -0,0 +1,199 @@
+/***************************************************************************/ /**
+ * @file test/test_capture_timer.c
+ * @brief Host test of capture_timer on the simulated config timer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "benchmark.h"
+#include "capture_ring.h"
+#include "capture_timer.h"
+#include "sim.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define CAPTURES          16
+#define SIGNAL_PERIOD_PS  100000000ULL // 10 kHz
+#define SIGNAL_HIGH_PS    25000000ULL
+#define NEAR_WRAP_COUNT   0xFFFFF000UL
+#define HANDLER_EDGES     32           // Edges per handler measurement, fits the ring
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static volatile uint32_t captures[CAPTURES];
+static volatile uint32_t capture_count = 0;
+static volatile uint32_t wrap_count = 0;
+static sim_square_wave_t wave;
+static capture_timebase_t timebase;
+static capture_ring_t ring;
+// Body of the config timer handler under test
+static void (*handler)(void) = NULL;
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+void CAPTURE_TIMER_IRQHandler(void)
+{
+  handler();
+}
+
+/*******************************************************************************
+ * Function to record the raw captures and count the wraps.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void record_captures(void)
+{
+  uint32_t status = RSI_CT_GetInterruptStatus(CAPTURE_TIMER_BASE);
+
+  if (status & CAPTURE_TIMER_CAPTURE_EVENT) {
+    if (capture_count < CAPTURES) {
+      captures[capture_count] = CAPTURE_TIMER_BASE->CT_CAPTURE_REG;
+    }
+    capture_count++;
+  }
+  if (status & CAPTURE_TIMER_WRAP_EVENT) {
+    wrap_count++;
+  }
+  RSI_CT_InterruptClear(CAPTURE_TIMER_BASE, status);
+}
+
+/*******************************************************************************
+ * Function to queue the captures as the pulse capture example did before the
+ * handler path was shared, with the driver calls of that version.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void legacy_capture(void)
+{
+  uint32_t flag = RSI_CT_GetInterruptStatus(CAPTURE_TIMER_BASE);
+
+  RSI_CT_InterruptClear(CAPTURE_TIMER_BASE, flag);
+  if (flag & RSI_CT_EVENT_INTR_0_l) {
+    uint32_t capture = CAPTURE_TIMER_BASE->CT_CAPTURE_REG;
+
+    capture_ring_push(&ring,
+                      capture_timebase_extend(
+                        &timebase,
+                        capture,
+                        (flag & RSI_CT_EVENT_COUNTER_0_IS_PEAK_l) != 0));
+  }
+  if (flag & RSI_CT_EVENT_COUNTER_0_IS_PEAK_l) {
+    capture_timebase_wrap(&timebase);
+  }
+}
+
+/*******************************************************************************
+ * Function to queue the captures through the shared handler path, as both
+ * examples do.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void shared_capture(void)
+{
+  uint64_t edge = 0;
+
+  if (capture_timer_service(&timebase, &edge) & CAPTURE_TIMER_CAPTURE_EVENT) {
+    capture_ring_push(&ring, edge);
+  }
+}
+
+/*******************************************************************************
+ * Function to measure a handler body on HANDLER_EDGES edges of the signal.
+ * The cost is the one of the simulator: exception entry and return, register
+ * accesses and driver calls.
+ *
+ * @param[in] body (void (*)(void)) Handler body.
+ * @return handler cycles per run
+ ******************************************************************************/
+static uint64_t measure_handler(void (*body)(void))
+{
+  uint64_t start_ps = sim_get_time_ps() + SIGNAL_PERIOD_PS / 2;
+
+  handler = body;
+  capture_timebase_init(&timebase, CAPTURE_TIMER_COUNTER_BITS);
+  capture_ring_init(&ring);
+  sim_ct_set_edge_source(NULL, NULL);
+  sim_ct_set_input_level(0, false);
+  capture_timer_init(CAPTURE_TIMER_CAPTURE_EVENT | CAPTURE_TIMER_WRAP_EVENT,
+                     CAPTURE_TIMER_RISING_EDGE);
+  sim_ct_square_wave(&wave, 0, SIGNAL_PERIOD_PS, SIGNAL_HIGH_PS, start_ps);
+  sim_ct_set_edge_source(sim_ct_square_wave_source, &wave);
+  sim_clear_isr_stats();
+  sim_advance_us(HANDLER_EDGES * (SIGNAL_PERIOD_PS / 1000000));
+  sim_ct_set_edge_source(NULL, NULL);
+
+  TEST_ASSERT_EQUAL(HANDLER_EDGES, capture_ring_get_count(&ring));
+  TEST_ASSERT_EQUAL(HANDLER_EDGES, sim_get_irq_count(CAPTURE_TIMER_IRQn));
+  return sim_get_isr_cycles() / HANDLER_EDGES;
+}
+
+/*******************************************************************************
+ * Every rising edge is captured one signal period after the previous one,
+ * including across the counter wrap.
+ ******************************************************************************/
+static void test_period_capture(void)
+{
+  uint32_t expected = (uint32_t)((SIGNAL_PERIOD_PS * sim_get_ct_frequency())
+                                 / 1000000000000ULL);
+
+  handler = record_captures;
+  sim_ct_square_wave(&wave, 0, SIGNAL_PERIOD_PS, SIGNAL_HIGH_PS,
+                     sim_get_time_ps() + SIGNAL_PERIOD_PS / 2);
+  sim_ct_set_edge_source(sim_ct_square_wave_source, &wave);
+  capture_timer_init(CAPTURE_TIMER_CAPTURE_EVENT | CAPTURE_TIMER_WRAP_EVENT,
+                     CAPTURE_TIMER_RISING_EDGE);
+  CAPTURE_TIMER_BASE->CT_COUNTER_REG = NEAR_WRAP_COUNT;
+  sim_advance_us(CAPTURES * (SIGNAL_PERIOD_PS / 1000000));
+
+  TEST_ASSERT(capture_count >= CAPTURES);
+  TEST_ASSERT_EQUAL(1, wrap_count);
+  for (uint32_t index = 1; index < CAPTURES; index++) {
+    TEST_ASSERT_EQUAL(expected, captures[index] - captures[index - 1]);
+  }
+  TEST_ASSERT_EQUAL(capture_count, sim_get_irq_count(CAPTURE_TIMER_IRQn) - wrap_count);
+}
+
+/*******************************************************************************
+ * The shared handler path costs no more cycles per capture than the handler
+ * of the pulse capture example before it was shared. Both are reported with
+ * benchmark_report(), the legacy cost is the threshold.
+ ******************************************************************************/
+static void test_handler_cycles(void)
+{
+  uint64_t legacy_cycles = measure_handler(legacy_capture);
+  uint64_t shared_cycles = measure_handler(shared_capture);
+
+  benchmark_init();
+  sim_console_clear();
+  TEST_ASSERT(benchmark_report("legacy_capture_handler", HANDLER_EDGES,
+                               legacy_cycles * HANDLER_EDGES,
+                               (uint32_t)legacy_cycles));
+  TEST_ASSERT(benchmark_report("shared_capture_handler", HANDLER_EDGES,
+                               shared_cycles * HANDLER_EDGES,
+                               (uint32_t)legacy_cycles));
+  TEST_ASSERT_EQUAL(0, benchmark_print_summary());
+}
+
+int main(void)
+{
+  TEST_RUN(test_period_capture);
+  TEST_RUN(test_handler_cycles);
+  return 0;
+}
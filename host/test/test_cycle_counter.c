@@ -0,0 +1,136 @@
+/***************************************************************************/ /**
+ * @file host/test/test_cycle_counter.c
+ * @brief Host test of the cycle counter conversions across core clock changes
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "cycle_counter.h"
+#include "sim.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define MICROSECONDS_PER_SECOND 1000000
+#define ULP_FREQUENCY           32000000 // Core clock on the ULP reference
+#define DELAY_US                500
+#define TIMEOUT_US              200
+#define DELAY_OVERHEAD_CYCLES   64       // Calls and the last loop pass
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+// Core clocks: SoC PLL, its halves, the 40 MHz and 32 MHz references
+static const uint32_t frequencies[] = { 180000000, 90000000, 45000000,
+                                        40000000, 32000000 };
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Function to switch the simulated core clock and let the cycle counter read
+ * it again.
+ *
+ * @param[in] frequency (uint32_t) Core clock, in Hz.
+ * @return none
+ ******************************************************************************/
+static void switch_core_clock(uint32_t frequency)
+{
+  sim_set_core_frequency(frequency);
+  cycle_counter_update_frequency();
+}
+
+/*******************************************************************************
+ * The conversions use the core clock read by the last update.
+ ******************************************************************************/
+static void test_conversions_follow_clock(void)
+{
+  for (uint32_t f = 0; f < sizeof(frequencies) / sizeof(frequencies[0]); f++) {
+    switch_core_clock(frequencies[f]);
+    TEST_ASSERT_EQUAL(frequencies[f], cycle_counter_get_frequency());
+    TEST_ASSERT_EQUAL(frequencies[f] / 1000, cycle_counter_us_to_cycles(1000));
+    TEST_ASSERT_EQUAL(frequencies[f] / MICROSECONDS_PER_SECOND,
+                      cycle_counter_us_to_cycles(1));
+    TEST_ASSERT_EQUAL(MICROSECONDS_PER_SECOND,
+                      cycle_counter_cycles_to_us(frequencies[f]));
+    TEST_ASSERT_EQUAL(DELAY_US,
+                      cycle_counter_cycles_to_us(
+                        cycle_counter_us_to_cycles(DELAY_US)));
+  }
+  switch_core_clock(SIM_CORE_FREQUENCY);
+}
+
+/*******************************************************************************
+ * A clock change is only seen once the frequency is read again.
+ ******************************************************************************/
+static void test_update_required(void)
+{
+  switch_core_clock(SIM_CORE_FREQUENCY);
+  sim_set_core_frequency(ULP_FREQUENCY);
+  TEST_ASSERT_EQUAL(SIM_CORE_FREQUENCY, cycle_counter_get_frequency());
+  TEST_ASSERT_EQUAL(SIM_CORE_FREQUENCY / 1000, cycle_counter_us_to_cycles(1000));
+  cycle_counter_update_frequency();
+  TEST_ASSERT_EQUAL(ULP_FREQUENCY / 1000, cycle_counter_us_to_cycles(1000));
+  switch_core_clock(SIM_CORE_FREQUENCY);
+}
+
+/*******************************************************************************
+ * The delays and the timeouts last the same time at every core clock.
+ ******************************************************************************/
+static void test_delays_follow_clock(void)
+{
+  cycle_counter_timeout_t timeout;
+  uint64_t start = 0;
+  uint64_t elapsed = 0;
+
+  for (uint32_t f = 0; f < sizeof(frequencies) / sizeof(frequencies[0]); f++) {
+    switch_core_clock(frequencies[f]);
+    start = sim_get_cycles();
+    cycle_counter_delay_us(DELAY_US);
+    elapsed = sim_get_cycles() - start;
+    TEST_ASSERT_RANGE(sim_us_to_cycles(DELAY_US),
+                      sim_us_to_cycles(DELAY_US) + DELAY_OVERHEAD_CYCLES,
+                      elapsed);
+
+    cycle_counter_timeout_start(&timeout, TIMEOUT_US);
+    sim_advance(sim_us_to_cycles(TIMEOUT_US - 1));
+    TEST_ASSERT(!cycle_counter_timeout_expired(&timeout));
+    sim_advance(sim_us_to_cycles(1));
+    TEST_ASSERT(cycle_counter_timeout_expired(&timeout));
+  }
+  switch_core_clock(SIM_CORE_FREQUENCY);
+}
+
+/*******************************************************************************
+ * Long durations saturate instead of wrapping, and no clock gives no time.
+ ******************************************************************************/
+static void test_limits(void)
+{
+  switch_core_clock(SIM_CORE_FREQUENCY);
+  TEST_ASSERT_EQUAL(UINT32_MAX, cycle_counter_us_to_cycles(UINT32_MAX));
+  TEST_ASSERT_EQUAL(UINT32_MAX / (SIM_CORE_FREQUENCY / MICROSECONDS_PER_SECOND),
+                    cycle_counter_cycles_to_us(UINT32_MAX));
+  switch_core_clock(0);
+  TEST_ASSERT_EQUAL(0, cycle_counter_cycles_to_us(UINT32_MAX));
+  switch_core_clock(SIM_CORE_FREQUENCY);
+}
+
+int main(void)
+{
+  cycle_counter_init();
+  TEST_RUN(test_conversions_follow_clock);
+  TEST_RUN(test_update_required);
+  TEST_RUN(test_delays_follow_clock);
+  TEST_RUN(test_limits);
+  return 0;
+}
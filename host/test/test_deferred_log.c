@@ -0,0 +1,236 @@
+/***************************************************************************/ /**
+ * @file host/test/test_deferred_log.c
+ * @brief Host test of the deferred logging
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+#include "capture_timer.h"
+#include "deferred_log.h"
+#include "sim.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define EDGE_DELAY_PS   10000000ULL // From now to the preempting edge
+#define EDGE_SETTLE_PS  100000ULL   // Past the edge, the capture is pending
+#define SIGNAL_PERIOD_PS 1000000000ULL
+#define HIGH_PRIORITY   0
+#define LOW_PRIORITY    1
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static sim_square_wave_t wave;
+static uint64_t edge_ps = 0;         // Time of the preempting edge, 0 if none
+static volatile bool low_handler_writing = false;
+static volatile bool thread_writing = false;
+static volatile uint32_t preemptions = 0;
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * High priority handler, on the edge of the config timer input.
+ ******************************************************************************/
+void CAPTURE_TIMER_IRQHandler(void)
+{
+  RSI_CT_InterruptClear(CAPTURE_TIMER_BASE,
+                        RSI_CT_GetInterruptStatus(CAPTURE_TIMER_BASE));
+  if (low_handler_writing || thread_writing) {
+    preemptions++;
+  }
+  DLOG("high %lu\n", (unsigned long)preemptions);
+}
+
+/*******************************************************************************
+ * Low priority handler, pended by the tests. It waits for the edge to be
+ * pending without a dispatch point, so the high priority handler takes it
+ * in the middle of the write.
+ ******************************************************************************/
+void I2C2_IRQHandler(void)
+{
+  static uint32_t runs = 0;
+
+  runs++;
+  if (edge_ps == 0) {
+    DLOG("low %lu\n", (unsigned long)runs);
+    return;
+  }
+  while (sim_get_time_ps() < (edge_ps + EDGE_SETTLE_PS)) {
+    NVIC_SetPriority(I2C2_IRQn, LOW_PRIORITY);
+  }
+  low_handler_writing = true;
+  DLOG("low %lu\n", (unsigned long)runs);
+  low_handler_writing = false;
+}
+
+/*******************************************************************************
+ * Function to print every recorded message and clear the console.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void drain(void)
+{
+  for (uint32_t call = 0; call < 2 * DEFERRED_LOG_RING_SIZE; call++) {
+    deferred_log_process();
+  }
+  sim_console_clear();
+}
+
+/*******************************************************************************
+ * Function to schedule one edge on the config timer input, EDGE_DELAY_PS
+ * from now, with the capture interrupt at high priority. The messages of the
+ * driver are drained first.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void schedule_edge(void)
+{
+  capture_timer_init(CAPTURE_TIMER_CAPTURE_EVENT, CAPTURE_TIMER_RISING_EDGE);
+  NVIC_SetPriority(CAPTURE_TIMER_IRQn, HIGH_PRIORITY);
+  drain();
+  edge_ps = sim_get_time_ps() + EDGE_DELAY_PS;
+  sim_ct_set_input_level(0, false);
+  sim_ct_square_wave(&wave, 0, SIGNAL_PERIOD_PS, SIGNAL_PERIOD_PS / 2, edge_ps);
+  sim_ct_set_edge_source(sim_ct_square_wave_source, &wave);
+}
+
+/*******************************************************************************
+ * Messages are printed in order with their arguments, at most
+ * DEFERRED_LOG_PROCESS_MAX per call, and nothing is formatted when written.
+ ******************************************************************************/
+static void test_format_order(void)
+{
+  drain();
+  DLOG("no argument\n");
+  DLOG("one %lu\n", 1UL);
+  DLOG("two %lu %lu\n", 1UL, 2UL);
+  DLOG("three %lu %s %lu\n", 1UL, "2", 3UL);
+  DLOG("four %lu %lu %lu %lX\n", 1UL, 2UL, 3UL, 0xABCDUL);
+  for (uint32_t index = 0; index < DEFERRED_LOG_PROCESS_MAX; index++) {
+    DLOG("line %lu\n", (unsigned long)index);
+  }
+  TEST_ASSERT_EQUAL(0, strlen(sim_console_get()));
+  deferred_log_process();
+  TEST_ASSERT(strncmp(sim_console_get(),
+                      "no argument\none 1\ntwo 1 2\nthree 1 2 3\n"
+                      "four 1 2 3 ABCD\nline 0\nline 1\nline 2\n",
+                      strlen(sim_console_get())) == 0);
+  TEST_ASSERT(strstr(sim_console_get(), "line 3") == NULL);
+  deferred_log_process();
+  TEST_ASSERT(strstr(sim_console_get(), "line 7\n") != NULL);
+  sim_console_clear();
+  deferred_log_process();
+  TEST_ASSERT_EQUAL(0, strlen(sim_console_get()));
+}
+
+/*******************************************************************************
+ * A full ring drops and counts the new messages, the recorded ones are kept.
+ ******************************************************************************/
+static void test_drop(void)
+{
+  uint32_t dropped = deferred_log_get_dropped();
+
+  drain();
+  for (uint32_t index = 0; index < DEFERRED_LOG_RING_SIZE + 3; index++) {
+    DLOG("message %lu\n", (unsigned long)index);
+  }
+  TEST_ASSERT_EQUAL(dropped + 3, deferred_log_get_dropped());
+  for (uint32_t call = 0; call < DEFERRED_LOG_RING_SIZE; call++) {
+    deferred_log_process();
+  }
+  TEST_ASSERT(strstr(sim_console_get(), "message 0\n") != NULL);
+  TEST_ASSERT(strstr(sim_console_get(), "message 31\n") != NULL);
+  TEST_ASSERT(strstr(sim_console_get(), "message 32\n") == NULL);
+  drain();
+}
+
+/*******************************************************************************
+ * Handler messages go to their own ring, printed after the thread mode ones.
+ ******************************************************************************/
+static void test_contexts(void)
+{
+  drain();
+  NVIC_SetPriority(I2C2_IRQn, LOW_PRIORITY);
+  NVIC_EnableIRQ(I2C2_IRQn);
+  DLOG("thread 1\n");
+  NVIC_SetPendingIRQ(I2C2_IRQn);
+  DLOG("thread 2\n");
+  deferred_log_process();
+  TEST_ASSERT_EQUAL(0, strcmp(sim_console_get(), "thread 1\nthread 2\nlow 1\n"));
+  drain();
+}
+
+/*******************************************************************************
+ * A handler taken between the claim and the store of a thread mode write
+ * makes the store fail, the write claims the slot again and no message is
+ * lost.
+ ******************************************************************************/
+static void test_preempted_thread_write(void)
+{
+  uint32_t dropped = deferred_log_get_dropped();
+
+  drain();
+  preemptions = 0;
+  schedule_edge();
+  while (sim_get_time_ps() < (edge_ps + EDGE_SETTLE_PS)) {
+    NVIC_SetPriority(I2C2_IRQn, LOW_PRIORITY);
+  }
+  thread_writing = true;
+  DLOG("thread\n");
+  thread_writing = false;
+  TEST_ASSERT_EQUAL(1, preemptions);
+  deferred_log_process();
+  TEST_ASSERT_EQUAL(0, strcmp(sim_console_get(), "thread\nhigh 1\n"));
+  TEST_ASSERT_EQUAL(dropped, deferred_log_get_dropped());
+  sim_ct_set_edge_source(NULL, NULL);
+  edge_ps = 0;
+  drain();
+}
+
+/*******************************************************************************
+ * A handler preempting another between its claim and its store takes the
+ * slot, the preempted write takes the next one.
+ ******************************************************************************/
+static void test_preempted_handler_write(void)
+{
+  uint32_t dropped = deferred_log_get_dropped();
+
+  drain();
+  preemptions = 0;
+  schedule_edge();
+  NVIC_SetPriority(I2C2_IRQn, LOW_PRIORITY);
+  NVIC_SetPendingIRQ(I2C2_IRQn);
+  TEST_ASSERT_EQUAL(1, preemptions);
+  deferred_log_process();
+  TEST_ASSERT_EQUAL(0, strcmp(sim_console_get(), "high 1\nlow 2\n"));
+  TEST_ASSERT_EQUAL(dropped, deferred_log_get_dropped());
+  sim_ct_set_edge_source(NULL, NULL);
+  edge_ps = 0;
+  drain();
+}
+
+int main(void)
+{
+  TEST_RUN(test_format_order);
+  TEST_RUN(test_drop);
+  TEST_RUN(test_contexts);
+  TEST_RUN(test_preempted_thread_write);
+  TEST_RUN(test_preempted_handler_write);
+  return 0;
+}
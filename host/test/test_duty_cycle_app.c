@@ -0,0 +1,247 @@
+/***************************************************************************/ /**
+ * @file test/test_duty_cycle_app.c
+ * @brief Host test of the duty cycle mode of the period measurement example
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "sim.h"
+#include "test.h"
+// The example is built whole, the test reads the state it publishes.
+#include "app.c"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define INPUT             0
+#define PWM_PERIOD_PS     100000000ULL // 10 kHz
+#define PWM_HIGH_PS       25000000ULL  // 25 %
+#define SHORT_HIGH_PS     10000ULL     // Shorter than the handler latency
+#define SHORT_PULSE       50           // Pulse whose falling edge is missed
+#define LOOP_CYCLES       180          // Rest of the main loop, 1 us
+#define IDLE_US           100          // Main loop step without edges
+#define RUN_US            20000
+#define HOLD_RUN_US       ((DUTY_CYCLE_HOLD_MS * 1000) + RUN_US)
+#define PS_PER_NS         1000ULL
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+// PWM on INPUT, from a rising edge, with one short pulse when short_pulse is set
+static struct {
+  uint64_t next_ps;   // Next rising edge
+  uint32_t pulse;     // Pulses started so far
+  bool falling_next;  // The next edge is the falling one
+  bool short_pulse;   // Pulse SHORT_PULSE is SHORT_HIGH_PS high
+} pwm;
+// Time the PWM stops at, and the level it is held at
+static uint64_t stop_cycles = 0;
+static bool hold_level = false;
+// Duty cycle published when the PWM stopped
+static uint32_t stop_duty_cycle_ppm = 0;
+
+// main() of the example, renamed by the build
+int example_main(void);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Function to run the rest of the main loop, until the end time.
+ *
+ * @param[in] context (uint64_t) End time, in core cycles.
+ * @param[in] pass (uint32_t) Pass of the main loop.
+ * @return true until the end time
+ ******************************************************************************/
+static bool run_until(void *context, uint32_t pass)
+{
+  const uint64_t *end = context;
+
+  (void)pass;
+  sim_advance(LOOP_CYCLES);
+  return sim_get_cycles() < *end;
+}
+
+/*******************************************************************************
+ * Function to run the rest of the main loop until the end time, the PWM is
+ * stopped at stop_cycles and the loop then runs in long steps.
+ *
+ * @param[in] context (uint64_t) End time, in core cycles.
+ * @param[in] pass (uint32_t) Pass of the main loop.
+ * @return true until the end time
+ ******************************************************************************/
+static bool stop_then_idle(void *context, uint32_t pass)
+{
+  const uint64_t *end = context;
+
+  if (sim_get_cycles() < stop_cycles) {
+    return run_until(context, pass);
+  }
+  if (pwm.next_ps != 0) {
+    sim_ct_set_edge_source(NULL, NULL);
+    sim_ct_set_input_level(INPUT, hold_level);
+    stop_duty_cycle_ppm = duty_cycle_ppm;
+    pwm.next_ps = 0;
+  }
+  sim_advance(sim_us_to_cycles(IDLE_US));
+  return sim_get_cycles() < *end;
+}
+
+/*******************************************************************************
+ * Function to give the edges of the PWM.
+ *
+ * @param[in] context (void) Unused.
+ * @param[out] time_ps (uint64_t) Time of the edge.
+ * @param[out] input (uint8_t) Input of the edge.
+ * @return true, the PWM never ends
+ ******************************************************************************/
+static bool pwm_source(void *context, uint64_t *time_ps, uint8_t *input)
+{
+  uint64_t high_ps = PWM_HIGH_PS;
+
+  (void)context;
+  *input = INPUT;
+  if (!pwm.falling_next) {
+    *time_ps = pwm.next_ps;
+  } else {
+    if (pwm.short_pulse && (pwm.pulse == SHORT_PULSE)) {
+      high_ps = SHORT_HIGH_PS;
+    }
+    *time_ps = pwm.next_ps + high_ps;
+    pwm.next_ps += PWM_PERIOD_PS;
+    pwm.pulse++;
+  }
+  pwm.falling_next = !pwm.falling_next;
+  return true;
+}
+
+/*******************************************************************************
+ * Function to run the example on the PWM, from a low input.
+ *
+ * @param[in] short_pulse (bool) One pulse is shorter than the handler latency.
+ * @param[in] run_us (uint32_t) Run time, in microseconds.
+ * @return none
+ ******************************************************************************/
+static void run_pwm(bool short_pulse, uint32_t run_us)
+{
+  uint64_t end = sim_get_cycles() + sim_us_to_cycles(run_us);
+
+  sim_ct_set_edge_source(NULL, NULL);
+  sim_ct_set_input_level(INPUT, false);
+  memset(&pwm, 0, sizeof(pwm));
+  pwm.next_ps = sim_get_time_ps() + PWM_PERIOD_PS / 2;
+  pwm.short_pulse = short_pulse;
+  sim_ct_set_edge_source(pwm_source, NULL);
+  sim_run_main(example_main, run_until, &end);
+}
+
+/*******************************************************************************
+ * Function to run the example on the PWM, then on the input held at a level.
+ *
+ * @param[in] level (bool) Level the input is held at.
+ * @return none
+ ******************************************************************************/
+static void run_held(bool level)
+{
+  uint64_t end = 0;
+
+  sim_ct_set_edge_source(NULL, NULL);
+  sim_ct_set_input_level(INPUT, false);
+  memset(&pwm, 0, sizeof(pwm));
+  pwm.next_ps = sim_get_time_ps() + PWM_PERIOD_PS / 2;
+  sim_ct_set_edge_source(pwm_source, NULL);
+  stop_cycles = sim_get_cycles() + sim_us_to_cycles(RUN_US);
+  hold_level = level;
+  end = stop_cycles + sim_us_to_cycles(HOLD_RUN_US);
+  sim_run_main(example_main, stop_then_idle, &end);
+}
+
+/*******************************************************************************
+ * Every pulse of the PWM is measured: the last period, high time, frequency
+ * and duty cycle are published, and all the periods are equal.
+ ******************************************************************************/
+static void test_pwm(void)
+{
+  uint32_t counts = (uint32_t)((PWM_PERIOD_PS * sim_get_ct_frequency())
+                               / SIM_PS_PER_SECOND);
+  uint32_t pulses = (uint32_t)((RUN_US * 1000000ULL) / PWM_PERIOD_PS);
+  stream_stats_snapshot_t snapshot;
+
+  run_pwm(false, RUN_US);
+
+  TEST_ASSERT_EQUAL(PWM_PERIOD_PS / PS_PER_NS, period_measurement_ns);
+  TEST_ASSERT_EQUAL(PWM_HIGH_PS / PS_PER_NS, high_width_ns);
+  TEST_ASSERT_EQUAL((PWM_HIGH_PS * DUTY_CYCLE_FULL_PPM) / PWM_PERIOD_PS,
+                    duty_cycle_ppm);
+  TEST_ASSERT_EQUAL(SIM_PS_PER_SECOND * 1000 / PWM_PERIOD_PS,
+                    frequency_measurement_millihz);
+  // The first rising edge only starts the first pulse, the last one may be
+  // pending.
+  TEST_ASSERT_RANGE(pulses - 2, pulses, period_count);
+  TEST_ASSERT(stream_stats_get_snapshot(&period_stats, &snapshot));
+  TEST_ASSERT_EQUAL(counts, snapshot.min);
+  TEST_ASSERT_EQUAL(counts, snapshot.max);
+  TEST_ASSERT_EQUAL(0, capture_ring_get_overruns(&edge_capture_ring));
+}
+
+/*******************************************************************************
+ * A falling edge coming before the handler arms it is counted as lost, the
+ * pulses around it are not measured: no period spans two pulses, and the
+ * PWM is measured again after it.
+ ******************************************************************************/
+static void test_lost_edge(void)
+{
+  uint32_t counts = (uint32_t)((PWM_PERIOD_PS * sim_get_ct_frequency())
+                               / SIM_PS_PER_SECOND);
+  stream_stats_snapshot_t snapshot;
+
+  run_pwm(true, RUN_US);
+
+  TEST_ASSERT(pwm.pulse > SHORT_PULSE + 2);
+  TEST_ASSERT_EQUAL(1, capture_ring_get_overruns(&edge_capture_ring));
+  TEST_ASSERT(stream_stats_get_snapshot(&period_stats, &snapshot));
+  TEST_ASSERT_EQUAL(counts, snapshot.min);
+  TEST_ASSERT_EQUAL(counts, snapshot.max);
+  TEST_ASSERT_EQUAL(PWM_HIGH_PS / PS_PER_NS, high_width_ns);
+  TEST_ASSERT_EQUAL((PWM_HIGH_PS * DUTY_CYCLE_FULL_PPM) / PWM_PERIOD_PS,
+                    duty_cycle_ppm);
+}
+
+/*******************************************************************************
+ * A PWM stopped low is 0 %, stopped high 100 %, once no edge came for
+ * DUTY_CYCLE_HOLD_MS. No period is published then.
+ ******************************************************************************/
+static void test_held_input(void)
+{
+  uint32_t duty_ppm = (uint32_t)((PWM_HIGH_PS * DUTY_CYCLE_FULL_PPM) / PWM_PERIOD_PS);
+
+  run_held(false);
+  TEST_ASSERT_EQUAL(duty_ppm, stop_duty_cycle_ppm);
+  TEST_ASSERT_EQUAL(0, duty_cycle_ppm);
+  TEST_ASSERT_EQUAL(0, period_measurement_ns);
+  TEST_ASSERT_EQUAL(0, frequency_measurement_millihz);
+
+  run_held(true);
+  TEST_ASSERT_EQUAL(duty_ppm, stop_duty_cycle_ppm);
+  TEST_ASSERT_EQUAL(DUTY_CYCLE_FULL_PPM, duty_cycle_ppm);
+  TEST_ASSERT_EQUAL(0, period_measurement_ns);
+  TEST_ASSERT_EQUAL(0, high_width_ns);
+}
+
+int main(void)
+{
+  TEST_RUN(test_pwm);
+  TEST_RUN(test_lost_edge);
+  TEST_RUN(test_held_input);
+  return 0;
+}
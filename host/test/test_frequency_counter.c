@@ -0,0 +1,156 @@
+/***************************************************************************/ /**
+ * @file host/test/test_frequency_counter.c
+ * @brief Host test of the reciprocal frequency counter, over an input frequency sweep
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "capture_timer.h"
+#include "frequency_counter.h"
+#include "sim.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define INPUT              0
+#define LOOP_CYCLES        180        // Rest of the main loop, 1 us
+#define GATE_US            10000      // FREQUENCY_COUNTER_GATE_US
+#define SETTLE_GATES       3          // Gates before the gate length settles
+#define STARTUP_PERIODS    8          // Longest first gate, in input periods
+#define MEASURED_GATES     5          // Gates checked per frequency
+#define WRAP_COUNTS        65536      // Counter 0 range
+#define PPB_PER_UNIT       1000000000ULL
+#define MILLIHERTZ_PER_HERTZ 1000ULL
+#define LOAD_PPM_MAX       5000       // Interrupt load at any frequency
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static sim_square_wave_t wave;
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+void CAPTURE_TIMER_IRQHandler(void)
+{
+  uint32_t flags = RSI_CT_GetInterruptStatus(CAPTURE_TIMER_BASE);
+
+  RSI_CT_InterruptClear(CAPTURE_TIMER_BASE, flags);
+  frequency_counter_irq_handler(flags);
+}
+
+/*******************************************************************************
+ * Function to run the main loop until the next gate result.
+ *
+ * @param[out] result (frequency_counter_result_t) Result of the gate.
+ * @param[in] limit_us (uint32_t) Longest wait, in microseconds.
+ * @return none
+ ******************************************************************************/
+static void wait_result(frequency_counter_result_t *result, uint32_t limit_us)
+{
+  uint64_t end = sim_get_cycles() + sim_us_to_cycles(limit_us);
+
+  while (!frequency_counter_get_result(result)) {
+    TEST_ASSERT(sim_get_cycles() < end);
+    sim_advance(LOOP_CYCLES);
+  }
+}
+
+/*******************************************************************************
+ * Sweeps the input frequency from below one period per gate to a few timer
+ * counts per period. Once the gate length has settled, every result is
+ * within its resolution of the input frequency, the gates last about
+ * GATE_US, or one period when it is longer, and the interrupts are the gates
+ * and the timebase wraps only, whatever the frequency.
+ ******************************************************************************/
+static void test_frequency_sweep(void)
+{
+  static const uint32_t frequencies[] = {
+    20, 100, 1000, 12345, 100000, 1000000, 4000000
+  };
+  frequency_counter_result_t result;
+  uint64_t ct_frequency = sim_get_ct_frequency();
+  uint64_t gate_target = (ct_frequency * GATE_US) / 1000000;
+  uint64_t period_ps = 0;
+  uint64_t period_counts = 0;
+  uint64_t expected_millihz = 0;
+  uint64_t error_millihz = 0;
+  uint64_t start_cycles = 0;
+  uint64_t elapsed_cycles = 0;
+  uint64_t window_counts = 0;
+  uint64_t load_ppm = 0;
+  uint32_t limit_us = 0;
+  uint32_t irqs = 0;
+  uint32_t wraps = 0;
+
+  printf("frequency Hz | edges/gate | resolution ppb | interrupts/s | load ppm\n");
+  for (uint32_t f = 0; f < sizeof(frequencies) / sizeof(frequencies[0]); f++) {
+    period_ps = SIM_PS_PER_SECOND / frequencies[f];
+    period_counts = ct_frequency / frequencies[f];
+    expected_millihz = frequencies[f] * MILLIHERTZ_PER_HERTZ;
+    limit_us = 4 * (GATE_US + (uint32_t)(period_ps / 1000000));
+    sim_ct_set_edge_source(NULL, NULL);
+    sim_ct_set_input_level(INPUT, true);
+    capture_timer_gpio_init();
+    frequency_counter_init();
+    sim_ct_square_wave(&wave, INPUT, period_ps, period_ps / 2,
+                       sim_get_time_ps() + period_ps / 2);
+    sim_ct_set_edge_source(sim_ct_square_wave_source, &wave);
+    // The first gate starts on a timebase wrap once an edge came, it lasts
+    // a few periods at the lowest frequencies.
+    wait_result(&result, limit_us + STARTUP_PERIODS * (uint32_t)(period_ps / 1000000));
+    for (uint32_t gate = 1; gate < SETTLE_GATES; gate++) {
+      wait_result(&result, limit_us);
+    }
+
+    sim_clear_isr_stats();
+    start_cycles = sim_get_cycles();
+    for (uint32_t gate = 0; gate < MEASURED_GATES; gate++) {
+      wait_result(&result, limit_us);
+      error_millihz = (result.frequency_millihz > expected_millihz)
+                      ? result.frequency_millihz - expected_millihz
+                      : expected_millihz - result.frequency_millihz;
+      TEST_ASSERT(error_millihz
+                  <= (expected_millihz * result.resolution_ppb) / PPB_PER_UNIT + 1);
+      TEST_ASSERT_EQUAL(PPB_PER_UNIT / result.gate_counts, result.resolution_ppb);
+      if (period_counts >= gate_target) {
+        TEST_ASSERT_EQUAL(1, result.edges);
+      } else {
+        // The gate is rounded down to whole periods, the last one may be
+        // taken late.
+        TEST_ASSERT_RANGE(gate_target - period_counts,
+                          gate_target + 2 * period_counts,
+                          result.gate_counts);
+      }
+    }
+    elapsed_cycles = sim_get_cycles() - start_cycles;
+    window_counts = (elapsed_cycles * ct_frequency) / sim_get_core_frequency();
+    irqs = sim_get_irq_count(CT_IRQn);
+    wraps = (uint32_t)(window_counts / WRAP_COUNTS);
+    TEST_ASSERT(irqs <= MEASURED_GATES + wraps + 2);
+    load_ppm = (sim_get_isr_cycles() * 1000000) / elapsed_cycles;
+    TEST_ASSERT(load_ppm <= LOAD_PPM_MAX);
+    printf("%12lu | %10lu | %14lu | %12lu | %8lu\n",
+           (unsigned long)frequencies[f],
+           (unsigned long)result.edges,
+           (unsigned long)result.resolution_ppb,
+           (unsigned long)((irqs * ct_frequency) / window_counts),
+           (unsigned long)load_ppm);
+  }
+}
+
+int main(void)
+{
+  TEST_RUN(test_frequency_sweep);
+  return 0;
+}
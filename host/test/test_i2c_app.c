@@ -0,0 +1,153 @@
+/***************************************************************************/ /**
+ * @file host/test/test_i2c_app.c
+ * @brief Host test of the I2C example super loop, with the Follower polling
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "sim.h"
+#include "test.h"
+// The example is built whole, the test reads the state it publishes.
+#include "app.c"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define LOOP_CYCLES       180    // Rest of the main loop, 1 us
+#define RUN_US            1100000 // One scheduler report and a bit more
+#define BUS_FREQUENCY     1000000 // Fast-mode Plus
+#define BITS_PER_ADDRESS  10      // Start and address byte with its acknowledge
+#define BITS_PER_BYTE     9       // Data byte with its acknowledge
+#define BITS_PER_STOP     1
+#define PPM               1000000
+#define FAST_LINE         "Fast poll: "
+#define SLOW_LINE         "Slow poll: "
+#define UTILIZATION_LINE  "Bus utilization: "
+
+/*******************************************************************************
+ ******************************  Data Types  ***********************************
+ ******************************************************************************/
+// Statistics of a polled read, as printed by the example
+typedef struct {
+  unsigned long completed;
+  unsigned long errors;
+  unsigned long misses;
+  unsigned long max_latency_us;
+} poll_report_t;
+
+// main() of the example, renamed by the build
+int example_main(void);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Function to run the rest of the main loop, until the end time.
+ *
+ * @param[in] context (uint64_t) End time, in core cycles.
+ * @param[in] pass (uint32_t) Pass of the main loop.
+ * @return true until the end time
+ ******************************************************************************/
+static bool run_until(void *context, uint32_t pass)
+{
+  const uint64_t *end = context;
+
+  (void)pass;
+  sim_advance(LOOP_CYCLES);
+  return sim_get_cycles() < *end;
+}
+
+/*******************************************************************************
+ * Function to read the first report of a polled read.
+ *
+ * @param[in] label (char) Start of the report line.
+ * @param[out] report (poll_report_t) Printed statistics.
+ * @return none
+ ******************************************************************************/
+static void read_poll_report(const char *label, poll_report_t *report)
+{
+  const char *line = strstr(sim_console_get(), label);
+
+  TEST_ASSERT(line != NULL);
+  TEST_ASSERT(sscanf(line + strlen(label),
+                     "%lu completed, %lu errors, %lu deadline misses, "
+                     "max latency %lu us",
+                     &report->completed,
+                     &report->errors,
+                     &report->misses,
+                     &report->max_latency_us)
+              == 4);
+}
+
+/*******************************************************************************
+ * Function to compute the time a register read takes on the bus: the
+ * register address is written, then the data is read after a repeated start.
+ *
+ * @param[in] length (uint32_t) Number of bytes read.
+ * @return bus time, in microseconds
+ ******************************************************************************/
+static uint32_t register_read_us(uint32_t length)
+{
+  uint32_t bits = 2 * BITS_PER_ADDRESS + (1 + length) * BITS_PER_BYTE
+                  + BITS_PER_STOP;
+
+  return (uint32_t)(((uint64_t)bits * PPM) / BUS_FREQUENCY);
+}
+
+/*******************************************************************************
+ * Once the example transactions are done, both register reads are polled at
+ * their rate for a whole report period without errors or deadline misses,
+ * and the reported bus utilization is the bus time of the reads.
+ ******************************************************************************/
+static void test_follower_polling(void)
+{
+  uint64_t end = sim_get_cycles() + sim_us_to_cycles(RUN_US);
+  uint32_t fast_polls = SCHEDULER_REPORT_US / SCHEDULER_FAST_PERIOD_US;
+  uint32_t slow_polls = SCHEDULER_REPORT_US / SCHEDULER_SLOW_PERIOD_US;
+  uint32_t wire_ppm = 0;
+  poll_report_t fast;
+  poll_report_t slow;
+  const char *line = NULL;
+  unsigned long utilization = 0;
+
+  sim_run_main(example_main, run_until, &end);
+
+  const char *console = sim_console_get();
+  TEST_ASSERT(strstr(console, "Data is received from Follower successfully") != NULL);
+  read_poll_report(FAST_LINE, &fast);
+  read_poll_report(SLOW_LINE, &slow);
+  // A release still in progress at the report time is not completed yet.
+  TEST_ASSERT_RANGE(fast_polls, fast_polls + 1, fast.completed);
+  TEST_ASSERT_RANGE(slow_polls, slow_polls + 1, slow.completed);
+  TEST_ASSERT_EQUAL(0, fast.errors + slow.errors);
+  TEST_ASSERT_EQUAL(0, fast.misses + slow.misses);
+  TEST_ASSERT(fast.max_latency_us < SCHEDULER_FAST_PERIOD_US);
+  TEST_ASSERT(slow.max_latency_us < SCHEDULER_SLOW_PERIOD_US);
+
+  line = strstr(console, UTILIZATION_LINE);
+  TEST_ASSERT(line != NULL);
+  TEST_ASSERT(sscanf(line + strlen(UTILIZATION_LINE), "%lu ppm", &utilization) == 1);
+  wire_ppm = fast_polls * register_read_us(SCHEDULER_FAST_LENGTH)
+             + slow_polls * register_read_us(SCHEDULER_SLOW_LENGTH);
+  printf("Bus utilization: %lu ppm, bus time of the reads: %lu ppm\n",
+         utilization, (unsigned long)wire_ppm);
+  // The transfers also occupy the bus while the handler fills the FIFO.
+  TEST_ASSERT_RANGE(wire_ppm, wire_ppm + wire_ppm / 10, utilization);
+}
+
+int main(void)
+{
+  TEST_RUN(test_follower_polling);
+  return 0;
+}
@@ -0,0 +1,465 @@
+/***************************************************************************/ /**
+ * @file host/test/test_i2c_leader.c
+ * @brief Host test of the I2C leader example on the simulated ULP_I2C
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+
+#include "i2c_leader_interrupt.h"
+#include "deferred_log.h"
+#include "sim.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define BUFFER_SIZE        1024 // I2C_BUFFER_SIZE of the example
+#define EXAMPLE_STEPS      1000 // Main loop iterations allowed for the example
+#define WAIT_STEP_US       100  // Time step while waiting for a transaction
+#define WAIT_LIMIT_US      200000
+#define FOLLOWER_ADDRESS   0x50
+#define ABSENT_ADDRESS     0x23
+#define SHORT_LENGTH       4
+#define STALL_LENGTH       16
+#define STALL_AFTER_BYTES  5
+#define SDA_STUCK_CLOCKS   3
+// Not a whole number of sleep timer ticks, the timer rounds it down
+#define STALL_TIMEOUT_US   2000
+#define STALL_EARLY_US     50   // One sleep timer tick is about 31 us
+#define STALL_LATE_US      200  // The bus recovery clocks take about 100 us
+#define OTHER_ADDRESS      0x51 // Acknowledged by nobody, only changes the target
+#define ADDRESS_WRITES     3    // Disable, target address and enable
+#define CHAIN_LENGTH       (QUEUE_SIZE + 1) // The first one is started at once
+#define CHAIN_BYTES        8
+#define IRQ_REPORT         "Interrupts taken for 2048 bytes: "
+#define WRITES_REPORT      "Configuration register writes for 2 transactions: "
+#define SLEEP_REPORT       "CPU asleep: "
+#define SLEEP_SHARE_MIN    90   // Share of the transfer time the CPU sleeps, in percent
+#define SLEEP_READ_CYCLES  4    // Cycles of a sleep measured around the sleep itself
+
+// Settings of the example
+#define QUEUE_SIZE         8    // I2C_TRANSACTION_QUEUE_SIZE
+#define FIFO_DEPTH         8    // I2C_FIFO_DEPTH
+#define TX_FIFO_THRESHOLD  2    // I2C_TX_FIFO_THRESHOLD
+#define RX_FIFO_THRESHOLD  3    // I2C_RX_FIFO_THRESHOLD
+
+#ifndef I2C_DMA_ENABLE
+#define I2C_DMA_ENABLE     0
+#endif
+#ifndef I2C_WAIT_MEASUREMENT_ENABLE
+#define I2C_WAIT_MEASUREMENT_ENABLE 0
+#endif
+// Besides the data, a transaction takes the interrupt pended by its
+// submission, a last partial batch and the stop.
+#if I2C_DMA_ENABLE
+// The bytes are moved by the DMA, a read also has its read commands moved by
+// a second channel.
+#define WRITE_IRQS_MAX     3
+#define READ_IRQS_MAX      4
+#else
+// One refill per FIFO_DEPTH - TX_FIFO_THRESHOLD bytes written, one drain per
+// RX_FIFO_THRESHOLD + 1 bytes read.
+#define WRITE_IRQS_MAX     ((BUFFER_SIZE / (FIFO_DEPTH - TX_FIFO_THRESHOLD)) + 3)
+#define READ_IRQS_MAX      ((BUFFER_SIZE / (RX_FIFO_THRESHOLD + 1)) + 3)
+#endif
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+extern volatile uint8_t i2c_read_buffer[BUFFER_SIZE];
+
+static volatile bool transaction_done = false;
+static volatile sl_status_t transaction_status = SL_STATUS_OK;
+static uint64_t transaction_end = 0;
+static uint32_t chain_order[CHAIN_LENGTH];
+static volatile uint32_t chain_completed = 0;
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+static void transaction_callback(i2c_transaction_t *transaction, sl_status_t status)
+{
+  (void)transaction;
+  transaction_status = status;
+  transaction_end = sim_get_cycles();
+  transaction_done = true;
+}
+
+/*******************************************************************************
+ * Submits a transaction and runs the simulation until its callback.
+ ******************************************************************************/
+static sl_status_t run_transaction(i2c_transaction_t *transaction)
+{
+  transaction_done = false;
+  transaction->callback = transaction_callback;
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, i2c_leader_submit_transaction(transaction));
+  for (uint32_t waited = 0; !transaction_done && (waited < WAIT_LIMIT_US);
+       waited += WAIT_STEP_US) {
+    sim_advance_us(WAIT_STEP_US);
+  }
+  TEST_ASSERT(transaction_done);
+  return transaction_status;
+}
+
+/*******************************************************************************
+ * Records the completion order of a chain, the context is the index.
+ ******************************************************************************/
+static void chain_callback(i2c_transaction_t *transaction, sl_status_t status)
+{
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, status);
+  chain_order[chain_completed++] = (uint32_t)(uintptr_t)transaction->context;
+}
+
+/*******************************************************************************
+ * Reads a number printed by the example after a label.
+ ******************************************************************************/
+static uint32_t read_report(const char *label)
+{
+  const char *line = strstr(sim_console_get(), label);
+  unsigned long value = 0;
+
+  TEST_ASSERT(line != NULL);
+  TEST_ASSERT(sscanf(line + strlen(label), "%lu", &value) == 1);
+  return (uint32_t)value;
+}
+
+/*******************************************************************************
+ * Checks a bus log entry.
+ ******************************************************************************/
+static void check_log(const sim_i2c_log_entry_t *entry,
+                      sim_i2c_log_type_t type,
+                      uint8_t value)
+{
+  TEST_ASSERT_EQUAL(type, entry->type);
+  TEST_ASSERT_EQUAL(value, entry->value);
+}
+
+/*******************************************************************************
+ * The example writes its buffer and reads it back, as two transactions with
+ * a stop each.
+ ******************************************************************************/
+static void test_example_transfer(void)
+{
+  const sim_i2c_log_entry_t *log = NULL;
+  const uint8_t *memory = sim_i2c_get_follower_memory();
+  uint32_t config_writes = sim_i2c_get_config_writes();
+  uint32_t sleeps = sim_get_sleep_count();
+  uint64_t sleep_cycles = sim_get_sleep_cycles();
+  uint64_t start = sim_get_cycles();
+  size_t length = 0;
+  size_t index = 0;
+
+  sim_clear_isr_stats();
+  for (uint32_t step = 0;
+       (step < EXAMPLE_STEPS) && (strstr(sim_console_get(), "bus recoveries") == NULL);
+       step++) {
+    i2c_leader_interrupt_process_action();
+    deferred_log_process();
+  }
+  TEST_ASSERT(strstr(sim_console_get(), "Data is transferred to Follower successfully") != NULL);
+  TEST_ASSERT(strstr(sim_console_get(), "Data is received from Follower successfully") != NULL);
+  for (uint32_t byte = 0; byte < BUFFER_SIZE; byte++) {
+    TEST_ASSERT_EQUAL((uint8_t)(byte + 1), memory[byte]);
+    TEST_ASSERT_EQUAL((uint8_t)(byte + 1), i2c_read_buffer[byte]);
+  }
+  // The counts printed by the example are the ones seen by the simulation.
+  TEST_ASSERT_EQUAL(sim_get_irq_count(I2C2_IRQn), read_report(IRQ_REPORT));
+  TEST_ASSERT_RANGE(2, WRITE_IRQS_MAX + READ_IRQS_MAX, read_report(IRQ_REPORT));
+  TEST_ASSERT_EQUAL(sim_i2c_get_config_writes() - config_writes,
+                    read_report(WRITES_REPORT));
+  sleeps = sim_get_sleep_count() - sleeps;
+  sleep_cycles = sim_get_sleep_cycles() - sleep_cycles;
+  // The CPU sleeps while waiting, it only wakes up for the interrupts and
+  // when the simulation bounds a wait.
+  TEST_ASSERT(sleeps > 0);
+  TEST_ASSERT(sleeps <= sim_get_irq_count(I2C2_IRQn)
+                        + sim_get_irq_count(ULPSS_UDMA_IRQn)
+                        + sim_get_irq_count(SYSRTC_IRQn)
+                        + (sim_get_cycles() - start)
+                            / sim_us_to_cycles(SIM_WAIT_LIMIT_US)
+                        + 1);
+  TEST_ASSERT(sleep_cycles >= ((sim_get_cycles() - start) * SLEEP_SHARE_MIN) / 100);
+#if I2C_WAIT_MEASUREMENT_ENABLE
+  // The measured time also counts the reads of the cycle counter.
+  printf("Example slept %lu times, %lu cycles, measured %lu cycles\n",
+         (unsigned long)sleeps,
+         (unsigned long)sleep_cycles,
+         (unsigned long)read_report(SLEEP_REPORT));
+  TEST_ASSERT_RANGE(sleep_cycles, sleep_cycles + sleeps * SLEEP_READ_CYCLES,
+                    read_report(SLEEP_REPORT));
+#endif
+
+  length = sim_i2c_get_log(&log);
+  TEST_ASSERT_EQUAL(2 * (BUFFER_SIZE + 2), length);
+  check_log(&log[index++], SIM_I2C_START, FOLLOWER_ADDRESS << 1);
+  for (uint32_t byte = 0; byte < BUFFER_SIZE; byte++) {
+    check_log(&log[index++], SIM_I2C_WRITE, (uint8_t)(byte + 1));
+  }
+  check_log(&log[index++], SIM_I2C_STOP, 0);
+  check_log(&log[index++], SIM_I2C_START, (FOLLOWER_ADDRESS << 1) | 1);
+  for (uint32_t byte = 0; byte < BUFFER_SIZE; byte++) {
+    check_log(&log[index++], SIM_I2C_READ, (uint8_t)(byte + 1));
+  }
+  check_log(&log[index++], SIM_I2C_STOP, 0);
+  TEST_ASSERT(i2c_leader_is_idle());
+}
+
+/*******************************************************************************
+ * A write and read transaction turns the bus around with a repeated start
+ * and a single stop.
+ ******************************************************************************/
+static void test_register_read(void)
+{
+  static const uint8_t write_data[] = { 0x10, 0x20 };
+  uint8_t read_data[SHORT_LENGTH] = { 0 };
+  i2c_transaction_t transaction = { 0 };
+  const sim_i2c_log_entry_t *log = NULL;
+
+  transaction.follower_address = FOLLOWER_ADDRESS;
+  transaction.write_buffer = write_data;
+  transaction.write_length = sizeof(write_data);
+  transaction.read_buffer = read_data;
+  transaction.read_length = sizeof(read_data);
+  sim_i2c_clear_log();
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, run_transaction(&transaction));
+  // The follower reads from the start of its memory after an address.
+  TEST_ASSERT_EQUAL(0x10, read_data[0]);
+  TEST_ASSERT_EQUAL(0x20, read_data[1]);
+  TEST_ASSERT_EQUAL(3, read_data[2]);
+
+  TEST_ASSERT_EQUAL(2 + 2 + 1 + SHORT_LENGTH, sim_i2c_get_log(&log));
+  check_log(&log[0], SIM_I2C_START, FOLLOWER_ADDRESS << 1);
+  check_log(&log[3], SIM_I2C_RESTART, (FOLLOWER_ADDRESS << 1) | 1);
+  check_log(&log[4 + SHORT_LENGTH], SIM_I2C_STOP, 0);
+}
+
+/*******************************************************************************
+ * An address NACK aborts the transaction and is counted.
+ ******************************************************************************/
+static void test_address_nack(void)
+{
+  static const uint8_t write_data[SHORT_LENGTH] = { 1, 2, 3, 4 };
+  i2c_transaction_t transaction = { 0 };
+  i2c_leader_error_counters_t counters;
+  const sim_i2c_log_entry_t *log = NULL;
+
+  transaction.follower_address = ABSENT_ADDRESS;
+  transaction.write_buffer = write_data;
+  transaction.write_length = sizeof(write_data);
+  sim_i2c_clear_log();
+  i2c_leader_clear_error_counters();
+  TEST_ASSERT_EQUAL(SL_STATUS_ABORT, run_transaction(&transaction));
+  i2c_leader_get_error_counters(&counters);
+  TEST_ASSERT_EQUAL(1, counters.address_nacks);
+  TEST_ASSERT_EQUAL(0, counters.timeouts);
+
+  TEST_ASSERT_EQUAL(3, sim_i2c_get_log(&log));
+  check_log(&log[0], SIM_I2C_START, ABSENT_ADDRESS << 1);
+  check_log(&log[1], SIM_I2C_NACK, ABSENT_ADDRESS << 1);
+  check_log(&log[2], SIM_I2C_STOP, 0);
+
+  // The next transaction is not affected.
+  transaction.follower_address = FOLLOWER_ADDRESS;
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, run_transaction(&transaction));
+  TEST_ASSERT(memcmp(sim_i2c_get_follower_memory(), write_data, sizeof(write_data)) == 0);
+}
+
+/*******************************************************************************
+ * A follower holding SCL is aborted at the deadline, the bus is recovered by
+ * clocking the follower out, and the next transaction goes through.
+ ******************************************************************************/
+static void test_stall_timeout(void)
+{
+  static uint8_t write_data[STALL_LENGTH];
+  sim_i2c_faults_t faults = { 0 };
+  i2c_transaction_t transaction = { 0 };
+  i2c_leader_error_counters_t counters;
+  uint64_t start = 0;
+
+  faults.stall_after_bytes = STALL_AFTER_BYTES;
+  faults.sda_stuck_clocks = SDA_STUCK_CLOCKS;
+  sim_i2c_set_faults(&faults);
+  transaction.follower_address = FOLLOWER_ADDRESS;
+  transaction.write_buffer = write_data;
+  transaction.write_length = sizeof(write_data);
+  transaction.timeout_us = STALL_TIMEOUT_US;
+  i2c_leader_clear_error_counters();
+  start = sim_get_cycles();
+  TEST_ASSERT_EQUAL(SL_STATUS_TIMEOUT, run_transaction(&transaction));
+  // Aborted when the sleep timer fires, around the deadline.
+  TEST_ASSERT_RANGE(sim_us_to_cycles(STALL_TIMEOUT_US - STALL_EARLY_US),
+                    sim_us_to_cycles(STALL_TIMEOUT_US + STALL_LATE_US),
+                    transaction_end - start);
+  i2c_leader_get_error_counters(&counters);
+  TEST_ASSERT_EQUAL(1, counters.timeouts);
+  TEST_ASSERT_EQUAL(1, counters.bus_recoveries);
+  TEST_ASSERT_EQUAL(0, counters.bus_recovery_failures);
+
+  transaction.timeout_us = 0;
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, run_transaction(&transaction));
+}
+
+/*******************************************************************************
+ * Each direction of a full buffer takes a bounded number of interrupts: one
+ * per FIFO refill or drain without the DMA, the start and the end with it.
+ ******************************************************************************/
+static void test_interrupts_per_transaction(void)
+{
+  static uint8_t data[BUFFER_SIZE];
+  i2c_transaction_t transaction = { 0 };
+
+  transaction.follower_address = FOLLOWER_ADDRESS;
+  transaction.write_buffer = data;
+  transaction.write_length = BUFFER_SIZE;
+  sim_clear_isr_stats();
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, run_transaction(&transaction));
+  printf("Write of %u bytes: %lu interrupts\n", BUFFER_SIZE,
+         (unsigned long)sim_get_irq_count(I2C2_IRQn));
+  TEST_ASSERT_RANGE(1, WRITE_IRQS_MAX, sim_get_irq_count(I2C2_IRQn));
+
+  transaction.write_length = 0;
+  transaction.read_buffer = data;
+  transaction.read_length = BUFFER_SIZE;
+  sim_clear_isr_stats();
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, run_transaction(&transaction));
+  printf("Read of %u bytes: %lu interrupts\n", BUFFER_SIZE,
+         (unsigned long)sim_get_irq_count(I2C2_IRQn));
+  TEST_ASSERT_RANGE(1, READ_IRQS_MAX, sim_get_irq_count(I2C2_IRQn));
+}
+
+/*******************************************************************************
+ * The follower address is only programmed when it changes: a transaction to
+ * another follower costs exactly the address writes more than one to the
+ * programmed follower.
+ ******************************************************************************/
+static void test_cached_configuration(void)
+{
+  static const uint8_t write_data[SHORT_LENGTH] = { 1, 2, 3, 4 };
+  i2c_transaction_t transaction = { 0 };
+  uint32_t start = 0;
+  uint32_t same_follower = 0;
+  uint32_t other_follower = 0;
+
+  transaction.follower_address = FOLLOWER_ADDRESS;
+  transaction.write_buffer = write_data;
+  transaction.write_length = sizeof(write_data);
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, run_transaction(&transaction));
+
+  start = sim_i2c_get_config_writes();
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, run_transaction(&transaction));
+  same_follower = sim_i2c_get_config_writes() - start;
+
+  transaction.follower_address = OTHER_ADDRESS;
+  start = sim_i2c_get_config_writes();
+  TEST_ASSERT_EQUAL(SL_STATUS_ABORT, run_transaction(&transaction));
+  other_follower = sim_i2c_get_config_writes() - start;
+  TEST_ASSERT_EQUAL(same_follower + ADDRESS_WRITES, other_follower);
+
+  // Back to the first follower, programmed again once.
+  transaction.follower_address = FOLLOWER_ADDRESS;
+  start = sim_i2c_get_config_writes();
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, run_transaction(&transaction));
+  TEST_ASSERT_EQUAL(same_follower + ADDRESS_WRITES,
+                    sim_i2c_get_config_writes() - start);
+}
+
+/*******************************************************************************
+ * Transactions submitted at once are chained by the IRQ handler, in order,
+ * without the main loop. The queue holds I2C_TRANSACTION_QUEUE_SIZE of them
+ * behind the active one, the next submission is refused.
+ ******************************************************************************/
+static void test_chained_transactions(void)
+{
+  static uint8_t write_data[CHAIN_LENGTH][CHAIN_BYTES];
+  static uint8_t read_data[CHAIN_LENGTH][CHAIN_BYTES];
+  static i2c_transaction_t transactions[CHAIN_LENGTH];
+  i2c_transaction_t extra = { 0 };
+  const sim_i2c_log_entry_t *log = NULL;
+  size_t index = 0;
+
+  chain_completed = 0;
+  for (uint32_t number = 0; number < CHAIN_LENGTH; number++) {
+    i2c_transaction_t *transaction = &transactions[number];
+
+    memset(write_data[number], (int)number, CHAIN_BYTES);
+    transaction->follower_address = FOLLOWER_ADDRESS;
+    transaction->callback = chain_callback;
+    transaction->context = (void *)(uintptr_t)number;
+    // Writes and register reads alternate.
+    transaction->write_buffer = write_data[number];
+    transaction->write_length = CHAIN_BYTES;
+    if (number & 1) {
+      transaction->write_length = 1;
+      transaction->read_buffer = read_data[number];
+      transaction->read_length = CHAIN_BYTES - 1;
+    }
+  }
+  sim_i2c_clear_log();
+  for (uint32_t number = 0; number < CHAIN_LENGTH; number++) {
+    TEST_ASSERT_EQUAL(SL_STATUS_OK,
+                      i2c_leader_submit_transaction(&transactions[number]));
+  }
+  extra = transactions[0];
+  TEST_ASSERT_EQUAL(SL_STATUS_FULL, i2c_leader_submit_transaction(&extra));
+
+  for (uint32_t waited = 0;
+       (chain_completed < CHAIN_LENGTH) && (waited < WAIT_LIMIT_US);
+       waited += WAIT_STEP_US) {
+    sim_advance_us(WAIT_STEP_US);
+  }
+  TEST_ASSERT_EQUAL(CHAIN_LENGTH, chain_completed);
+  TEST_ASSERT(i2c_leader_is_idle());
+  for (uint32_t number = 0; number < CHAIN_LENGTH; number++) {
+    TEST_ASSERT_EQUAL(number, chain_order[number]);
+  }
+  // One start and one stop per transaction, in submission order.
+  sim_i2c_get_log(&log);
+  for (uint32_t number = 0; number < CHAIN_LENGTH; number++) {
+    check_log(&log[index++], SIM_I2C_START, FOLLOWER_ADDRESS << 1);
+    check_log(&log[index++], SIM_I2C_WRITE, (uint8_t)number);
+    if (number & 1) {
+      check_log(&log[index++], SIM_I2C_RESTART, (FOLLOWER_ADDRESS << 1) | 1);
+      // The follower reads from the start of its memory: the byte just
+      // written, then the ones of the previous transaction.
+      for (uint32_t byte = 0; byte < (CHAIN_BYTES - 1); byte++) {
+        uint8_t expected = (uint8_t)((byte == 0) ? number : (number - 1));
+
+        check_log(&log[index++], SIM_I2C_READ, expected);
+        TEST_ASSERT_EQUAL(expected, read_data[number][byte]);
+      }
+    } else {
+      for (uint32_t byte = 1; byte < CHAIN_BYTES; byte++) {
+        check_log(&log[index++], SIM_I2C_WRITE, (uint8_t)number);
+      }
+    }
+    check_log(&log[index++], SIM_I2C_STOP, 0);
+  }
+
+  // Once drained, the queue takes transactions again.
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, run_transaction(&extra));
+}
+
+int main(void)
+{
+  i2c_leader_interrupt_init();
+  TEST_RUN(test_example_transfer);
+  TEST_RUN(test_register_read);
+  TEST_RUN(test_address_nack);
+  TEST_RUN(test_stall_timeout);
+  TEST_RUN(test_interrupts_per_transaction);
+  TEST_RUN(test_cached_configuration);
+  TEST_RUN(test_chained_transactions);
+  return 0;
+}
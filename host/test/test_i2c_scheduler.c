@@ -0,0 +1,319 @@
+/***************************************************************************/ /**
+ * @file host/test/test_i2c_scheduler.c
+ * @brief Host test of the I2C polling scheduler, the driver is mocked
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "i2c_scheduler.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define MOCK_QUEUE_SIZE 16
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static uint32_t now = 0;
+static i2c_transaction_t *submitted[MOCK_QUEUE_SIZE];
+static uint32_t submitted_count = 0;
+static uint32_t submit_limit = MOCK_QUEUE_SIZE;
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Driver mock, the transactions are recorded in submission order and only
+ * completed by the test.
+ ******************************************************************************/
+sl_status_t i2c_leader_submit_transaction(i2c_transaction_t *transaction)
+{
+  if (submitted_count >= submit_limit) {
+    return SL_STATUS_FULL;
+  }
+  submitted[submitted_count++] = transaction;
+  return SL_STATUS_OK;
+}
+
+static uint32_t get_time(void)
+{
+  return now;
+}
+
+/*******************************************************************************
+ * Resets the mock and the scheduler, the time starts at the given tick.
+ ******************************************************************************/
+static void reset(uint32_t start)
+{
+  now = start;
+  submitted_count = 0;
+  submit_limit = MOCK_QUEUE_SIZE;
+  i2c_scheduler_init(get_time);
+}
+
+static void add_device(i2c_scheduler_device_t *device,
+                       uint32_t period,
+                       uint8_t priority)
+{
+  *device = (i2c_scheduler_device_t){ 0 };
+  device->period = period;
+  device->priority = priority;
+  device->transaction.write_length = 1;
+  TEST_ASSERT_EQUAL(SL_STATUS_OK, i2c_scheduler_add_device(device));
+}
+
+static void complete(i2c_scheduler_device_t *device, sl_status_t status)
+{
+  device->transaction.callback(&device->transaction, status);
+}
+
+/*******************************************************************************
+ * Released transfers are submitted by priority first.
+ ******************************************************************************/
+static void test_priority_order(void)
+{
+  i2c_scheduler_device_t low, high, middle;
+
+  reset(0);
+  add_device(&low, 10, 2);
+  add_device(&high, 10, 0);
+  add_device(&middle, 10, 1);
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(3, submitted_count);
+  TEST_ASSERT(submitted[0] == &high.transaction);
+  TEST_ASSERT(submitted[1] == &middle.transaction);
+  TEST_ASSERT(submitted[2] == &low.transaction);
+}
+
+/*******************************************************************************
+ * At equal priority, the earliest deadline is submitted first.
+ ******************************************************************************/
+static void test_earliest_deadline(void)
+{
+  i2c_scheduler_device_t slow, fast;
+
+  reset(0);
+  add_device(&slow, 50, 1);
+  add_device(&fast, 20, 1);
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(2, submitted_count);
+  TEST_ASSERT(submitted[0] == &fast.transaction);
+  TEST_ASSERT(submitted[1] == &slow.transaction);
+}
+
+/*******************************************************************************
+ * A transfer completed after its period counts a deadline miss, and the
+ * latency is measured from the release.
+ ******************************************************************************/
+static void test_deadline_miss(void)
+{
+  i2c_scheduler_device_t device;
+
+  reset(100);
+  add_device(&device, 10, 0);
+  i2c_scheduler_process();
+  now = 108;
+  complete(&device, SL_STATUS_OK);
+  TEST_ASSERT_EQUAL(0, device.deadline_misses);
+  TEST_ASSERT_EQUAL(8, device.max_latency);
+
+  now = 110;
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(2, submitted_count);
+  now = 125;
+  complete(&device, SL_STATUS_TIMEOUT);
+  TEST_ASSERT_EQUAL(1, device.deadline_misses);
+  TEST_ASSERT_EQUAL(15, device.max_latency);
+  TEST_ASSERT_EQUAL(1, device.completions);
+  TEST_ASSERT_EQUAL(1, device.errors);
+}
+
+/*******************************************************************************
+ * A device still busy when its next period starts skips that period, the
+ * skipped period and the late transfer both count a deadline miss.
+ ******************************************************************************/
+static void test_busy_device_skips_period(void)
+{
+  i2c_scheduler_device_t device;
+
+  reset(0);
+  add_device(&device, 10, 0);
+  i2c_scheduler_process();
+  now = 10;
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(1, submitted_count);
+  TEST_ASSERT_EQUAL(1, device.deadline_misses);
+  now = 12;
+  complete(&device, SL_STATUS_OK);
+  TEST_ASSERT_EQUAL(2, device.deadline_misses);
+  // The next release is at the following period, not right away.
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(1, submitted_count);
+  now = 20;
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(2, submitted_count);
+}
+
+/*******************************************************************************
+ * After a stall, the missed periods are skipped instead of released in a
+ * burst, and each of them counts a deadline miss.
+ ******************************************************************************/
+static void test_stall_skips_periods(void)
+{
+  i2c_scheduler_device_t device;
+
+  reset(0);
+  add_device(&device, 10, 0);
+  i2c_scheduler_process();
+  complete(&device, SL_STATUS_OK);
+  now = 55;
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(2, submitted_count);
+  // The period at 10 is released late, the ones at 20, 30, 40 and 50 skipped.
+  TEST_ASSERT_EQUAL(4, device.deadline_misses);
+  complete(&device, SL_STATUS_OK);
+  TEST_ASSERT_EQUAL(5, device.deadline_misses);
+  for (now = 56; now < 65; now++) {
+    i2c_scheduler_process();
+  }
+  TEST_ASSERT_EQUAL(2, submitted_count);
+  now = 65;
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(3, submitted_count);
+}
+
+/*******************************************************************************
+ * A full driver queue leaves the remaining transfers for the next call, in
+ * the same order.
+ ******************************************************************************/
+static void test_driver_queue_full(void)
+{
+  i2c_scheduler_device_t first, second, third;
+
+  reset(0);
+  add_device(&first, 10, 0);
+  add_device(&second, 10, 1);
+  add_device(&third, 10, 2);
+  submit_limit = 1;
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(1, submitted_count);
+  TEST_ASSERT(!second.in_flight);
+  TEST_ASSERT(second.pending);
+  submit_limit = MOCK_QUEUE_SIZE;
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(3, submitted_count);
+  TEST_ASSERT(submitted[1] == &second.transaction);
+  TEST_ASSERT(submitted[2] == &third.transaction);
+}
+
+/*******************************************************************************
+ * Releases and deadlines are computed across the tick counter wrap.
+ ******************************************************************************/
+static void test_time_wrap(void)
+{
+  i2c_scheduler_device_t device, slow, fast;
+
+  reset(UINT32_MAX - 4);
+  add_device(&device, 10, 0);
+  i2c_scheduler_process();
+  complete(&device, SL_STATUS_OK);
+  now = 4;
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(1, submitted_count);
+  now = 5;
+  i2c_scheduler_process();
+  TEST_ASSERT_EQUAL(2, submitted_count);
+  now = 8;
+  complete(&device, SL_STATUS_OK);
+  TEST_ASSERT_EQUAL(0, device.deadline_misses);
+  TEST_ASSERT_EQUAL(3, device.max_latency);
+
+  // The deadline of fast is UINT32_MAX, the one of slow wrapped to 15.
+  reset(UINT32_MAX - 4);
+  add_device(&slow, 20, 0);
+  add_device(&fast, 4, 0);
+  i2c_scheduler_process();
+  TEST_ASSERT(submitted[0] == &fast.transaction);
+  TEST_ASSERT(submitted[1] == &slow.transaction);
+}
+
+/*******************************************************************************
+ * The utilization counts the bus time of the transfers run back to back once,
+ * and not the idle time between periods.
+ ******************************************************************************/
+static void test_utilization(void)
+{
+  i2c_scheduler_device_t first, second;
+
+  reset(0);
+  TEST_ASSERT_EQUAL(0, i2c_scheduler_get_utilization_ppm());
+  add_device(&first, 100, 0);
+  add_device(&second, 100, 1);
+  i2c_scheduler_process();
+  now = 10;
+  complete(&first, SL_STATUS_OK);
+  now = 30;
+  complete(&second, SL_STATUS_OK);
+  now = 100;
+  TEST_ASSERT_EQUAL(300000, i2c_scheduler_get_utilization_ppm());
+
+  i2c_scheduler_process();
+  now = 120;
+  complete(&first, SL_STATUS_OK);
+  now = 125;
+  complete(&second, SL_STATUS_OK);
+  now = 200;
+  TEST_ASSERT_EQUAL(275000, i2c_scheduler_get_utilization_ppm());
+
+  // A new window only counts the transfers completed in it.
+  i2c_scheduler_clear_utilization();
+  TEST_ASSERT_EQUAL(0, i2c_scheduler_get_utilization_ppm());
+  i2c_scheduler_process();
+  now = 250;
+  complete(&first, SL_STATUS_OK);
+  complete(&second, SL_STATUS_OK);
+  now = 300;
+  TEST_ASSERT_EQUAL(500000, i2c_scheduler_get_utilization_ppm());
+  TEST_ASSERT_EQUAL(0, first.deadline_misses + second.deadline_misses);
+}
+
+static void test_invalid_devices(void)
+{
+  i2c_scheduler_device_t devices[I2C_SCHEDULER_MAX_DEVICES + 1];
+
+  reset(0);
+  devices[0] = (i2c_scheduler_device_t){ 0 };
+  TEST_ASSERT_EQUAL(SL_STATUS_INVALID_PARAMETER, i2c_scheduler_add_device(&devices[0]));
+  TEST_ASSERT_EQUAL(SL_STATUS_INVALID_PARAMETER, i2c_scheduler_add_device(NULL));
+  for (uint32_t index = 0; index < I2C_SCHEDULER_MAX_DEVICES; index++) {
+    add_device(&devices[index], 10, 0);
+  }
+  devices[I2C_SCHEDULER_MAX_DEVICES].period = 10;
+  TEST_ASSERT_EQUAL(SL_STATUS_FULL,
+                    i2c_scheduler_add_device(&devices[I2C_SCHEDULER_MAX_DEVICES]));
+}
+
+int main(void)
+{
+  TEST_RUN(test_priority_order);
+  TEST_RUN(test_earliest_deadline);
+  TEST_RUN(test_deadline_miss);
+  TEST_RUN(test_busy_device_skips_period);
+  TEST_RUN(test_stall_skips_periods);
+  TEST_RUN(test_driver_queue_full);
+  TEST_RUN(test_time_wrap);
+  TEST_RUN(test_utilization);
+  TEST_RUN(test_invalid_devices);
+  return 0;
+}
@@ -0,0 +1,226 @@
+/***************************************************************************/ /**
+ * @file host/test/test_isr_trace.c
+ * @brief Host test of the interrupt handler tracing, on a mocked cycle counter
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include "deferred_log.h"
+#include "sim.h"
+#include "test.h"
+
+// The timestamps of ISR_TRACE_ENTER and ISR_TRACE_EXIT come from the mock.
+static uint32_t mock_cycles(void);
+#define ISR_TRACE_CYCLES mock_cycles
+#include "isr_trace.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define TRACE_ID          0
+#define OTHER_ID          1
+#define TIMER_FREQUENCY   40000000 // Config timer clock
+#define CORE_FREQUENCY    180000000
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static uint32_t mock_now = 0;
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+static uint32_t mock_cycles(void)
+{
+  return mock_now;
+}
+
+/*******************************************************************************
+ * Function to trace one handler run of the given duration, starting at the
+ * mocked cycle count.
+ *
+ * @param[in] id (uint8_t) Handler identifier.
+ * @param[in] duration (uint32_t) Entry to exit, in cycles.
+ * @param[in] latency (uint32_t) Latency, or ISR_TRACE_NO_LATENCY.
+ * @return none
+ ******************************************************************************/
+static void run_handler(uint8_t id, uint32_t duration, uint32_t latency)
+{
+  ISR_TRACE_ENTER(id);
+  mock_now += duration;
+  ISR_TRACE_EXIT(id, latency);
+}
+
+/*******************************************************************************
+ * The minimum, maximum, mean and histogram of the durations and latencies.
+ ******************************************************************************/
+static void test_statistics(void)
+{
+  isr_trace_stats_t stats;
+
+  isr_trace_init();
+  mock_now = 1000;
+  run_handler(TRACE_ID, 10, ISR_TRACE_NO_LATENCY);
+  run_handler(TRACE_ID, 30, 7);
+  run_handler(TRACE_ID, 20, 3);
+  run_handler(TRACE_ID, 0, ISR_TRACE_NO_LATENCY);
+  // Nothing is counted until the records are processed.
+  isr_trace_get_stats(TRACE_ID, &stats);
+  TEST_ASSERT_EQUAL(0, stats.duration.count);
+
+  isr_trace_process();
+  isr_trace_get_stats(TRACE_ID, &stats);
+  TEST_ASSERT_EQUAL(4, stats.duration.count);
+  TEST_ASSERT_EQUAL(0, stats.duration.min);
+  TEST_ASSERT_EQUAL(30, stats.duration.max);
+  TEST_ASSERT_EQUAL(15, isr_trace_get_mean(&stats.duration));
+  TEST_ASSERT_EQUAL(1, stats.duration.histogram[0]);  // 0
+  TEST_ASSERT_EQUAL(1, stats.duration.histogram[3]);  // 10
+  TEST_ASSERT_EQUAL(2, stats.duration.histogram[4]);  // 20 and 30
+  // Only the measured latencies are counted.
+  TEST_ASSERT_EQUAL(2, stats.latency.count);
+  TEST_ASSERT_EQUAL(3, stats.latency.min);
+  TEST_ASSERT_EQUAL(7, stats.latency.max);
+  TEST_ASSERT_EQUAL(5, isr_trace_get_mean(&stats.latency));
+  TEST_ASSERT_EQUAL(0, stats.overruns);
+  // The other handler has its own statistics.
+  isr_trace_get_stats(OTHER_ID, &stats);
+  TEST_ASSERT_EQUAL(0, stats.duration.count);
+  TEST_ASSERT_EQUAL(0, isr_trace_get_mean(&stats.duration));
+
+  isr_trace_reset(TRACE_ID);
+  isr_trace_get_stats(TRACE_ID, &stats);
+  TEST_ASSERT_EQUAL(0, stats.duration.count);
+  TEST_ASSERT_EQUAL(UINT32_MAX, stats.duration.min);
+}
+
+/*******************************************************************************
+ * A handler run across the 32-bit wrap of the DWT counter keeps its duration.
+ ******************************************************************************/
+static void test_counter_wrap(void)
+{
+  isr_trace_stats_t stats;
+
+  isr_trace_init();
+  mock_now = UINT32_MAX - 5;
+  run_handler(TRACE_ID, 16, ISR_TRACE_NO_LATENCY);
+  TEST_ASSERT_EQUAL(10, mock_now);
+  mock_now = UINT32_MAX;
+  run_handler(TRACE_ID, 1, ISR_TRACE_NO_LATENCY);
+  run_handler(TRACE_ID, 40, ISR_TRACE_NO_LATENCY);
+  isr_trace_process();
+  isr_trace_get_stats(TRACE_ID, &stats);
+  TEST_ASSERT_EQUAL(3, stats.duration.count);
+  TEST_ASSERT_EQUAL(1, stats.duration.min);
+  TEST_ASSERT_EQUAL(40, stats.duration.max);
+  TEST_ASSERT_EQUAL(19, isr_trace_get_mean(&stats.duration));
+  TEST_ASSERT_EQUAL(1, stats.duration.histogram[4]);  // 16
+}
+
+/*******************************************************************************
+ * Long durations fall into the last histogram bin, and the total does not
+ * overflow.
+ ******************************************************************************/
+static void test_long_durations(void)
+{
+  isr_trace_stats_t stats;
+
+  isr_trace_init();
+  for (uint32_t run = 0; run < ISR_TRACE_RING_SIZE; run++) {
+    run_handler(TRACE_ID, UINT32_MAX, ISR_TRACE_NO_LATENCY);
+  }
+  isr_trace_process();
+  isr_trace_get_stats(TRACE_ID, &stats);
+  TEST_ASSERT_EQUAL(UINT32_MAX, isr_trace_get_mean(&stats.duration));
+  TEST_ASSERT_EQUAL(ISR_TRACE_RING_SIZE,
+                    stats.duration.histogram[ISR_TRACE_HISTOGRAM_BINS - 1]);
+}
+
+/*******************************************************************************
+ * A full ring drops and counts the records until the main loop drains it.
+ ******************************************************************************/
+static void test_overruns(void)
+{
+  isr_trace_stats_t stats;
+
+  isr_trace_init();
+  for (uint32_t run = 0; run < ISR_TRACE_RING_SIZE + 3; run++) {
+    run_handler(TRACE_ID, 5, ISR_TRACE_NO_LATENCY);
+  }
+  isr_trace_process();
+  isr_trace_get_stats(TRACE_ID, &stats);
+  TEST_ASSERT_EQUAL(ISR_TRACE_RING_SIZE, stats.duration.count);
+  TEST_ASSERT_EQUAL(3, stats.overruns);
+
+  run_handler(TRACE_ID, 5, ISR_TRACE_NO_LATENCY);
+  isr_trace_process();
+  isr_trace_get_stats(TRACE_ID, &stats);
+  TEST_ASSERT_EQUAL(ISR_TRACE_RING_SIZE + 1, stats.duration.count);
+  TEST_ASSERT_EQUAL(3, stats.overruns);
+}
+
+/*******************************************************************************
+ * Timer counts are converted to core clock cycles.
+ ******************************************************************************/
+static void test_timer_latency(void)
+{
+  isr_trace_init();
+  TEST_ASSERT_EQUAL(CORE_FREQUENCY, cycle_counter_get_frequency());
+  isr_trace_set_timer_frequency(TIMER_FREQUENCY);
+  TEST_ASSERT_EQUAL(0, isr_trace_timer_to_cycles(0));
+  TEST_ASSERT_EQUAL(180, isr_trace_timer_to_cycles(40));
+  TEST_ASSERT_EQUAL(180000, isr_trace_timer_to_cycles(40000));
+  // A zero frequency keeps the previous ratio.
+  isr_trace_set_timer_frequency(0);
+  TEST_ASSERT_EQUAL(180, isr_trace_timer_to_cycles(40));
+}
+
+/*******************************************************************************
+ * The report is recorded with DLOG, and printed by deferred_log_process()
+ * with the name and the whole histogram line.
+ ******************************************************************************/
+static void test_print(void)
+{
+  isr_trace_init();
+  mock_now = 1000;
+  run_handler(TRACE_ID, 10, ISR_TRACE_NO_LATENCY);
+  run_handler(TRACE_ID, 30, 7);
+  run_handler(TRACE_ID, 20, 3);
+  run_handler(TRACE_ID, 0, ISR_TRACE_NO_LATENCY);
+  isr_trace_process();
+  sim_console_clear();
+
+  isr_trace_print(TRACE_ID, "handler");
+  TEST_ASSERT_EQUAL(0, strlen(sim_console_get()));
+  // Nine records, more than one call prints.
+  deferred_log_process();
+  deferred_log_process();
+  TEST_ASSERT_EQUAL(0, strcmp(sim_console_get(),
+                              "handler: 4 runs, duration min 0 mean 15 max 30 "
+                              "cycles, 0 lost \n"
+                              "handler: latency min 3 mean 5 max 7 cycles \n"
+                              "handler: duration histogram"
+                              " 1 0 0 1 2 0 0 0 0 0 0 0 0 0 0 0 \n"));
+}
+
+int main(void)
+{
+  TEST_RUN(test_statistics);
+  TEST_RUN(test_counter_wrap);
+  TEST_RUN(test_long_durations);
+  TEST_RUN(test_overruns);
+  TEST_RUN(test_timer_latency);
+  TEST_RUN(test_print);
+  return 0;
+}
@@ -0,0 +1,328 @@
+/***************************************************************************/ /**
+ * @file test/test_multi_capture.c
+ * @brief Host test of multi_capture on the simulated config timer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdbool.h>
+#include "deferred_log.h"
+#include "multi_capture.h"
+#include "sim.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define EDGES_MAX           8
+#define EVENTS_MAX          64
+#define PULSE_PS            10000ULL    // Low time of the pulses
+#define REFERENCE_LEAD_PS   1000000ULL  // Channel 1 edge before the pulses
+#define TRIAL_START_PS      2000000ULL  // From now to the first pulse
+#define TRIAL_US            5
+#define SPACING_MIN_PS      20000ULL    // Sweep of the second pulse
+#define SPACING_MAX_PS      400000ULL
+#define SPACING_STEP_PS     1000ULL
+#define WAVE_0_PERIOD_PS    7000000ULL  // Unrelated periods for both channels
+#define WAVE_1_PERIOD_PS    11000000ULL
+#define WAVES_US            2000        // More than one 16-bit counter range
+#define SIMULTANEOUS_TRIALS 8
+#define SIMULTANEOUS_US     433         // From now to the pulses, 17320 counts
+
+// Outcomes of one trial, in the order of the sweep
+typedef enum {
+  OUTCOME_MERGED,   // Both pulses before the handler, one queued, no trace
+  OUTCOME_FLAGGED,  // Pulse overwritten in the handler, loss counted
+  OUTCOME_BOTH,     // Both pulses queued
+} outcome_t;
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static capture_timebase_t timebase;
+static capture_ring_t ring;
+static uint64_t edge_times[EDGES_MAX];
+static uint8_t edge_inputs[EDGES_MAX];
+static uint32_t edge_count = 0;
+static uint32_t edge_next = 0;
+static sim_square_wave_t waves[MULTI_CAPTURE_CHANNELS];
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+void CAPTURE_TIMER_IRQHandler(void)
+{
+  multi_capture_service(&timebase, &ring);
+}
+
+/*******************************************************************************
+ * Function to give the edges of the table, in order.
+ *
+ * @param[in] context (void) Unused.
+ * @param[out] time_ps (uint64_t) Time of the edge.
+ * @param[out] input (uint8_t) Input of the edge.
+ * @return true while edges remain
+ ******************************************************************************/
+static bool table_source(void *context, uint64_t *time_ps, uint8_t *input)
+{
+  (void)context;
+  if (edge_next >= edge_count) {
+    return false;
+  }
+  *time_ps = edge_times[edge_next];
+  *input = edge_inputs[edge_next];
+  edge_next++;
+  return true;
+}
+
+/*******************************************************************************
+ * Function to give the next edge of the earliest square wave.
+ *
+ * @param[in] context (sim_square_wave_t) Waves, one per channel.
+ * @param[out] time_ps (uint64_t) Time of the edge.
+ * @param[out] input (uint8_t) Input of the edge.
+ * @return true
+ ******************************************************************************/
+static bool waves_source(void *context, uint64_t *time_ps, uint8_t *input)
+{
+  sim_square_wave_t *wave = context;
+
+  if (wave[1].next_ps < wave[0].next_ps) {
+    wave++;
+  }
+  return sim_ct_square_wave_source(wave, time_ps, input);
+}
+
+/*******************************************************************************
+ * Function to add a low pulse to the edge table.
+ *
+ * @param[in] input (uint8_t) Input of the pulse.
+ * @param[in] start_ps (uint64_t) Falling edge, the captured one.
+ * @return none
+ ******************************************************************************/
+static void add_pulse(uint8_t input, uint64_t start_ps)
+{
+  edge_times[edge_count] = start_ps;
+  edge_inputs[edge_count] = input;
+  edge_times[edge_count + 1] = start_ps + PULSE_PS;
+  edge_inputs[edge_count + 1] = input;
+  edge_count += 2;
+}
+
+/*******************************************************************************
+ * Function to convert a time to timer counts, as captured.
+ *
+ * @param[in] time_ps (uint64_t) Time.
+ * @return counts of the timer clock
+ ******************************************************************************/
+static uint64_t to_counts(uint64_t time_ps)
+{
+  return (time_ps * sim_get_ct_frequency()) / SIM_PS_PER_SECOND;
+}
+
+/*******************************************************************************
+ * Function to start the capture of both channels, on falling edges from
+ * high inputs. The messages of the service are dropped.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void start_capture(void)
+{
+  sim_ct_set_input_level(0, true);
+  sim_ct_set_input_level(1, true);
+  capture_ring_init(&ring);
+  multi_capture_init(&timebase,
+                     MULTI_CAPTURE_CHANNEL_0_EVENT,
+                     MULTI_CAPTURE_CHANNEL_1_EVENT);
+  for (uint32_t call = 0; call < 2 * DEFERRED_LOG_RING_SIZE; call++) {
+    deferred_log_process();
+  }
+  sim_console_clear();
+}
+
+/*******************************************************************************
+ * The captures of two square waves are queued in time order, tagged with
+ * their channel, one period apart on the shared timebase across the wraps
+ * of the 16-bit counters.
+ ******************************************************************************/
+static void test_time_order(void)
+{
+  static const uint64_t periods[MULTI_CAPTURE_CHANNELS] = {
+    WAVE_0_PERIOD_PS, WAVE_1_PERIOD_PS
+  };
+  uint64_t events[EVENTS_MAX];
+  bool gaps[EVENTS_MAX];
+  uint64_t last[MULTI_CAPTURE_CHANNELS] = { 0 };
+  uint32_t captured[MULTI_CAPTURE_CHANNELS] = { 0 };
+  uint64_t previous = 0;
+  uint64_t timestamp = 0;
+  uint32_t count = 0;
+  uint8_t channel = 0;
+
+  start_capture();
+  for (uint8_t input = 0; input < MULTI_CAPTURE_CHANNELS; input++) {
+    sim_ct_square_wave(&waves[input], input, periods[input], periods[input] / 2,
+                       sim_get_time_ps() + TRIAL_START_PS);
+  }
+  sim_ct_set_edge_source(waves_source, waves);
+  for (uint32_t step = 0; step < WAVES_US / 100; step++) {
+    sim_advance_us(100);
+    count = capture_ring_pop_batch(&ring, events, gaps, EVENTS_MAX);
+    for (uint32_t index = 0; index < count; index++) {
+      channel = multi_capture_get_channel(events[index]);
+      timestamp = multi_capture_get_timestamp(events[index]);
+      TEST_ASSERT(channel < MULTI_CAPTURE_CHANNELS);
+      TEST_ASSERT(!gaps[index]);
+      TEST_ASSERT(timestamp >= previous);
+      if (captured[channel] > 0) {
+        TEST_ASSERT_EQUAL(to_counts(periods[channel]),
+                          timestamp - last[channel]);
+      }
+      captured[channel]++;
+      last[channel] = timestamp;
+      previous = timestamp;
+    }
+  }
+  sim_ct_set_edge_source(NULL, NULL);
+
+  TEST_ASSERT(captured[0] >= WAVES_US * 1000000ULL / WAVE_0_PERIOD_PS - 1);
+  TEST_ASSERT(captured[1] >= WAVES_US * 1000000ULL / WAVE_1_PERIOD_PS - 1);
+  TEST_ASSERT(to_counts(WAVES_US * 1000000ULL) > (1UL << 16));
+  TEST_ASSERT_EQUAL(0, capture_ring_get_overruns(&ring));
+}
+
+/*******************************************************************************
+ * Two pulses on channel 0, the second one later at each step. Before the
+ * handler reads the status the second capture replaces the first without a
+ * trace. While the handler runs, a replaced capture is counted and the
+ * next event is flagged. Once the capture is read both are queued. Nothing
+ * is queued twice, and the queued timestamps are the ones of the pulses.
+ ******************************************************************************/
+static void test_overwrite_flagged(void)
+{
+  uint64_t events[EVENTS_MAX];
+  bool gaps[EVENTS_MAX];
+  uint32_t outcomes[OUTCOME_BOTH + 1] = { 0 };
+  outcome_t outcome = OUTCOME_MERGED;
+  outcome_t previous = OUTCOME_MERGED;
+  uint64_t first_ps = 0;
+  uint64_t second_counts = 0;
+  uint64_t reference = 0;
+  uint32_t overruns = 0;
+  uint32_t count = 0;
+  bool gap_carried = false;
+
+  start_capture();
+  for (uint64_t spacing = SPACING_MIN_PS; spacing <= SPACING_MAX_PS;
+       spacing += SPACING_STEP_PS) {
+    first_ps = sim_get_time_ps() + TRIAL_START_PS;
+    edge_count = 0;
+    edge_next = 0;
+    add_pulse(1, first_ps - REFERENCE_LEAD_PS);
+    add_pulse(0, first_ps);
+    add_pulse(0, first_ps + spacing);
+    sim_ct_set_edge_source(table_source, NULL);
+    overruns = capture_ring_get_overruns(&ring);
+    sim_advance_us(TRIAL_US);
+
+    count = capture_ring_pop_batch(&ring, events, gaps, EVENTS_MAX);
+    TEST_ASSERT(count >= 1);
+    TEST_ASSERT_EQUAL(1, multi_capture_get_channel(events[0]));
+    // A loss not followed by an event of its trial flags this one.
+    TEST_ASSERT_EQUAL(gap_carried, gaps[0]);
+    reference = multi_capture_get_timestamp(events[0]);
+    second_counts = to_counts(first_ps + spacing)
+                    - to_counts(first_ps - REFERENCE_LEAD_PS);
+    if (count == 3) {
+      outcome = OUTCOME_BOTH;
+      TEST_ASSERT(!gaps[1] && !gaps[2]);
+      TEST_ASSERT_EQUAL(to_counts(first_ps)
+                        - to_counts(first_ps - REFERENCE_LEAD_PS),
+                        multi_capture_get_timestamp(events[1]) - reference);
+    } else if (capture_ring_get_overruns(&ring) == overruns) {
+      outcome = OUTCOME_MERGED;
+      TEST_ASSERT_EQUAL(2, count);
+      TEST_ASSERT(!gaps[1]);
+    } else {
+      // The replacing edge is queued by the next run, unless it came just
+      // before the acknowledge, in the count of the counter read.
+      outcome = OUTCOME_FLAGGED;
+      TEST_ASSERT_EQUAL(overruns + 1, capture_ring_get_overruns(&ring));
+      TEST_ASSERT((count == 1) || ((count == 2) && gaps[1]));
+    }
+    if (count > 1) {
+      TEST_ASSERT_EQUAL(0, multi_capture_get_channel(events[count - 1]));
+      TEST_ASSERT_EQUAL(second_counts,
+                        multi_capture_get_timestamp(events[count - 1])
+                        - reference);
+    }
+    TEST_ASSERT(outcome >= previous);
+    outcomes[outcome]++;
+    gap_carried = (outcome == OUTCOME_FLAGGED) && (count == 1);
+    previous = outcome;
+  }
+  sim_ct_set_edge_source(NULL, NULL);
+
+  TEST_ASSERT(outcomes[OUTCOME_MERGED] > 0);
+  TEST_ASSERT(outcomes[OUTCOME_FLAGGED] > 0);
+  TEST_ASSERT(outcomes[OUTCOME_BOTH] > 0);
+}
+
+/*******************************************************************************
+ * Pulses starting at the same time on both channels are captured by both
+ * counters with equal timestamps once the offset of counter 1 is added,
+ * channel 0 first, at any count of the counters.
+ ******************************************************************************/
+static void test_simultaneous_edges(void)
+{
+  uint64_t events[EVENTS_MAX];
+  bool gaps[EVENTS_MAX];
+  uint64_t start_ps = 0;
+  uint64_t previous = 0;
+  uint32_t count = 0;
+
+  start_capture();
+  for (uint32_t trial = 0; trial < SIMULTANEOUS_TRIALS; trial++) {
+    start_ps = sim_get_time_ps() + (SIMULTANEOUS_US * 1000000ULL);
+    edge_next = 0;
+    for (uint8_t input = 0; input < MULTI_CAPTURE_CHANNELS; input++) {
+      edge_times[input] = start_ps;
+      edge_inputs[input] = input;
+      edge_times[MULTI_CAPTURE_CHANNELS + input] = start_ps + PULSE_PS;
+      edge_inputs[MULTI_CAPTURE_CHANNELS + input] = input;
+    }
+    edge_count = 2 * MULTI_CAPTURE_CHANNELS;
+    sim_ct_set_edge_source(table_source, NULL);
+    sim_advance_us(SIMULTANEOUS_US + TRIAL_US);
+
+    count = capture_ring_pop_batch(&ring, events, gaps, EVENTS_MAX);
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT(!gaps[0] && !gaps[1]);
+    TEST_ASSERT_EQUAL(0, multi_capture_get_channel(events[0]));
+    TEST_ASSERT_EQUAL(1, multi_capture_get_channel(events[1]));
+    TEST_ASSERT_EQUAL(multi_capture_get_timestamp(events[0]),
+                      multi_capture_get_timestamp(events[1]));
+    TEST_ASSERT(multi_capture_get_timestamp(events[0]) > previous);
+    previous = multi_capture_get_timestamp(events[0]);
+  }
+  sim_ct_set_edge_source(NULL, NULL);
+  TEST_ASSERT_EQUAL(0, capture_ring_get_overruns(&ring));
+}
+
+int main(void)
+{
+  TEST_RUN(test_time_order);
+  TEST_RUN(test_overwrite_flagged);
+  TEST_RUN(test_simultaneous_edges);
+  return 0;
+}
@@ -0,0 +1,93 @@
+/***************************************************************************/ /**
+ * @file test/test_period_app.c
+ * @brief Host test of the period measurement example through its super loop
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "sim.h"
+#include "test.h"
+// The example is built whole, the test reads the state it publishes.
+#include "app.c"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SIGNAL_PERIOD_PS  10000000ULL // 100 kHz
+#define SIGNAL_HIGH_PS    5000000ULL
+#define LOOP_CYCLES       180         // Rest of the main loop, 1 us
+#define RUN_US            110000      // One statistics report and a bit more
+#define PS_PER_US         1000000ULL
+#define PS_PER_NS         1000ULL
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static sim_square_wave_t wave;
+
+// main() of the example, renamed by the build
+int example_main(void);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Function to run the rest of the main loop, until the end time.
+ *
+ * @param[in] context (uint64_t) End time, in core cycles.
+ * @param[in] pass (uint32_t) Pass of the main loop.
+ * @return true until the end time
+ ******************************************************************************/
+static bool run_until(void *context, uint32_t pass)
+{
+  const uint64_t *end = context;
+
+  (void)pass;
+  sim_advance(LOOP_CYCLES);
+  return sim_get_cycles() < *end;
+}
+
+/*******************************************************************************
+ * The super loop measures every period of a steady signal: the last period
+ * and frequency are published, and the statistics report shows no spread.
+ ******************************************************************************/
+static void test_steady_signal(void)
+{
+  uint64_t end = sim_get_cycles() + sim_us_to_cycles(RUN_US);
+  uint32_t periods = (uint32_t)((RUN_US * PS_PER_US) / SIGNAL_PERIOD_PS);
+  uint32_t counts = (uint32_t)((SIGNAL_PERIOD_PS * sim_get_ct_frequency())
+                               / SIM_PS_PER_SECOND);
+  char report[64];
+
+  sim_ct_square_wave(&wave, 0, SIGNAL_PERIOD_PS, SIGNAL_HIGH_PS,
+                     sim_get_time_ps() + SIGNAL_PERIOD_PS / 2);
+  sim_ct_set_edge_source(sim_ct_square_wave_source, &wave);
+  sim_run_main(example_main, run_until, &end);
+
+  TEST_ASSERT_EQUAL(SIGNAL_PERIOD_PS / PS_PER_NS, period_measurement_ns);
+  TEST_ASSERT_EQUAL(SIM_PS_PER_SECOND * 1000 / SIGNAL_PERIOD_PS,
+                    frequency_measurement_millihz);
+  // The first edge only starts the first period, the last one may be pending.
+  TEST_ASSERT_RANGE(periods - 2, periods, period_count);
+  snprintf(report, sizeof(report), "min %lu max %lu mean %lu.000 std dev 0.000",
+           (unsigned long)counts, (unsigned long)counts, (unsigned long)counts);
+  TEST_ASSERT(strstr(sim_console_get(), report) != NULL);
+  TEST_ASSERT(strstr(sim_console_get(), "Cycle-to-cycle jitter: max 0 rms 0.000")
+              != NULL);
+}
+
+int main(void)
+{
+  TEST_RUN(test_steady_signal);
+  return 0;
+}
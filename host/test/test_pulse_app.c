@@ -0,0 +1,197 @@
+/***************************************************************************/ /**
+ * @file test/test_pulse_app.c
+ * @brief Host test of the pulse capture example through its super loop
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "sim.h"
+#include "test.h"
+// The example is built whole, the test reads the state it publishes.
+#include "app.c"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SIGNAL_PERIOD_PS  100000000ULL // 10 kHz
+#define SIGNAL_HIGH_PS    25000000ULL
+#define LOOP_CYCLES       180          // Rest of the main loop, 1 us
+#define RUN_US            5000
+#define PS_PER_US         1000000ULL
+#define CAPTURE_LINE      "capture value 0x"
+#define LOST_LINE         "captures lost, "
+#define BURST_PERIOD_PS   2000000ULL   // 500 kHz
+#define BURST_EDGES       300          // Falling edges of the burst
+#define BURST_STALL_US    400          // Main loop stalled, shorter than the burst
+#define BURST_RUN_US      3000
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static sim_square_wave_t wave;
+static uint32_t wave_toggles = 0;
+
+// main() of the example, renamed by the build
+int example_main(void);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Function to run the rest of the main loop, until the end time.
+ *
+ * @param[in] context (uint64_t) End time, in core cycles.
+ * @param[in] pass (uint32_t) Pass of the main loop.
+ * @return true until the end time
+ ******************************************************************************/
+static bool run_until(void *context, uint32_t pass)
+{
+  const uint64_t *end = context;
+
+  (void)pass;
+  sim_advance(LOOP_CYCLES);
+  return sim_get_cycles() < *end;
+}
+
+/*******************************************************************************
+ * Function to run the rest of the main loop, stalled on the first pass.
+ *
+ * @param[in] context (uint64_t) End time, in core cycles.
+ * @param[in] pass (uint32_t) Pass of the main loop.
+ * @return true until the end time
+ ******************************************************************************/
+static bool stall_then_run(void *context, uint32_t pass)
+{
+  if (pass == 0) {
+    sim_advance(sim_us_to_cycles(BURST_STALL_US));
+  }
+  return run_until(context, pass);
+}
+
+/*******************************************************************************
+ * Function to give the edges of the square wave, until wave_toggles edges.
+ *
+ * @param[in] context (sim_square_wave_t) Wave.
+ * @param[out] time_ps (uint64_t) Time of the edge.
+ * @param[out] input (uint8_t) Input of the edge.
+ * @return false once the edges are all given
+ ******************************************************************************/
+static bool burst_source(void *context, uint64_t *time_ps, uint8_t *input)
+{
+  if (wave_toggles == 0) {
+    return false;
+  }
+  wave_toggles--;
+  return sim_ct_square_wave_source(context, time_ps, input);
+}
+
+/*******************************************************************************
+ * Function to read the timestamps printed by the example.
+ *
+ * @param[out] timestamps (uint64_t) Timestamps, in print order.
+ * @param[in] size (uint32_t) Size of timestamps.
+ * @return the number of timestamps printed
+ ******************************************************************************/
+static uint32_t read_timestamps(uint64_t *timestamps, uint32_t size)
+{
+  const char *line = sim_console_get();
+  unsigned long high = 0;
+  unsigned long low = 0;
+  uint32_t count = 0;
+
+  while ((line = strstr(line, CAPTURE_LINE)) != NULL) {
+    TEST_ASSERT(sscanf(line, CAPTURE_LINE "%8lx%8lx", &high, &low) == 2);
+    if (count < size) {
+      timestamps[count] = ((uint64_t)high << 32) | low;
+    }
+    count++;
+    line += strlen(CAPTURE_LINE);
+  }
+  return count;
+}
+
+/*******************************************************************************
+ * The super loop prints every falling edge of a steady signal, one period
+ * apart, and no loss.
+ ******************************************************************************/
+static void test_steady_signal(void)
+{
+  uint64_t end = sim_get_cycles() + sim_us_to_cycles(RUN_US);
+  uint32_t edges = (uint32_t)((RUN_US * PS_PER_US) / SIGNAL_PERIOD_PS);
+  uint32_t counts = (uint32_t)((SIGNAL_PERIOD_PS * sim_get_ct_frequency())
+                               / SIM_PS_PER_SECOND);
+  uint64_t timestamps[RUN_US];
+  uint32_t count = 0;
+
+  sim_ct_square_wave(&wave, 0, SIGNAL_PERIOD_PS, SIGNAL_HIGH_PS,
+                     sim_get_time_ps() + SIGNAL_PERIOD_PS / 2);
+  sim_ct_set_edge_source(sim_ct_square_wave_source, &wave);
+  sim_run_main(example_main, run_until, &end);
+
+  count = read_timestamps(timestamps, RUN_US);
+  TEST_ASSERT_RANGE(edges - 1, edges, count);
+  for (uint32_t index = 1; index < count; index++) {
+    TEST_ASSERT_EQUAL(counts, timestamps[index] - timestamps[index - 1]);
+  }
+  TEST_ASSERT(strstr(sim_console_get(), "captures lost") == NULL);
+}
+
+/*******************************************************************************
+ * A burst fills the capture ring while the main loop is stalled. Every edge
+ * is either printed or counted as lost by the capture ring, the log drops
+ * nothing, and the printed timestamps jump by the lost edges at the gap,
+ * where the total is printed.
+ ******************************************************************************/
+static void test_burst(void)
+{
+  uint64_t end = sim_get_cycles() + sim_us_to_cycles(BURST_RUN_US);
+  uint32_t counts = (uint32_t)((BURST_PERIOD_PS * sim_get_ct_frequency())
+                               / SIM_PS_PER_SECOND);
+  uint64_t timestamps[BURST_EDGES];
+  const char *lost_line = NULL;
+  unsigned long lost_total = 0;
+  uint32_t overruns = 0;
+  uint32_t missing = 0;
+  uint32_t count = 0;
+
+  sim_console_clear();
+  sim_ct_set_input_level(0, false);
+  sim_ct_square_wave(&wave, 0, BURST_PERIOD_PS, BURST_PERIOD_PS / 2,
+                     sim_get_time_ps() + BURST_PERIOD_PS);
+  wave_toggles = 2 * BURST_EDGES;
+  sim_ct_set_edge_source(burst_source, &wave);
+  sim_run_main(example_main, stall_then_run, &end);
+
+  count = read_timestamps(timestamps, BURST_EDGES);
+  overruns = capture_ring_get_overruns(&capture_ring);
+  TEST_ASSERT(overruns > 0);
+  TEST_ASSERT_EQUAL(BURST_EDGES, count + overruns);
+  TEST_ASSERT_EQUAL(0, deferred_log_get_dropped());
+  for (uint32_t index = 1; index < count; index++) {
+    TEST_ASSERT_EQUAL(0, (timestamps[index] - timestamps[index - 1]) % counts);
+    missing += (uint32_t)((timestamps[index] - timestamps[index - 1]) / counts) - 1;
+  }
+  TEST_ASSERT_EQUAL(overruns, missing);
+  lost_line = strstr(sim_console_get(), LOST_LINE);
+  TEST_ASSERT(lost_line != NULL);
+  TEST_ASSERT(sscanf(lost_line, LOST_LINE "%lu", &lost_total) == 1);
+  TEST_ASSERT_EQUAL(overruns, lost_total);
+  TEST_ASSERT(strstr(lost_line + 1, LOST_LINE) == NULL);
+}
+
+int main(void)
+{
+  TEST_RUN(test_steady_signal);
+  TEST_RUN(test_burst);
+  return 0;
+}
@@ -0,0 +1,307 @@
+/***************************************************************************/ /**
+ * @file test/test_quadrature_decoder.c
+ * @brief Host test of the quadrature decoder on a simulated encoder
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdbool.h>
+#include "capture_timer.h"
+#include "deferred_log.h"
+#include "quadrature_decoder.h"
+#include "sim.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define INPUT_A             0
+#define INPUT_B             1
+#define LOOP_CYCLES         180        // Rest of the main loop, 1 us
+#define PHASE_US            60000      // Motion at one speed
+#define SETTLE_US           20000      // Transients, excluded from the checks
+#define STOP_US             300000     // Past the stop timeout of the decoder
+#define VELOCITY_ERROR_PPM  10000      // Velocity error at a constant speed
+#define COUNT_ERROR_CPS     2000       // Count mode, an edge of A per 1 ms window
+#define POSITION_ERROR_MAX  4          // Counts, plus the ones of LATENCY_PS
+#define LATENCY_PS          2000000ULL // Window end to the state read
+#define LOAD_PPM_MAX        100000     // Interrupt load at any speed
+#define COUNT_LOAD_PPM_MAX  2000       // Interrupt load in count mode
+#define GLITCH_SPEED_CPS    2000
+#define GLITCH_WIDTH_PS     20000ULL   // Shorter than the interrupt latency
+#define GLITCH_COUNTS       10         // Counts before and after the glitch
+
+// Constant speed motion of the encoder, then stopped
+typedef struct {
+  uint64_t next_ps;       // Next count
+  uint64_t step_ps;       // Time between counts
+  uint32_t remaining;     // Counts until the stop
+  int8_t direction;       // 1 forward, -1 backward
+  bool a;                 // Levels after the last edge
+  bool b;
+  uint64_t glitch_ps;     // Pulse on A, not a count, 0 if none
+  uint32_t glitch_edges;  // Edges of the pulse left
+  int64_t first_position; // Position at the start of the motion
+  uint64_t first_ps;      // First count of the motion
+  uint32_t counts;        // Counts of the motion
+} encoder_t;
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static encoder_t encoder;
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+void CAPTURE_TIMER_IRQHandler(void)
+{
+  quadrature_decoder_irq_handler();
+}
+
+/*******************************************************************************
+ * Function to give the next edge of the encoder. Forward, B changes when A
+ * and B are equal and A when they differ.
+ *
+ * @param[in] context (encoder_t) Encoder.
+ * @param[out] time_ps (uint64_t) Time of the edge.
+ * @param[out] input (uint8_t) Input of the edge.
+ * @return true while the encoder moves
+ ******************************************************************************/
+static bool encoder_source(void *context, uint64_t *time_ps, uint8_t *input)
+{
+  encoder_t *motion = context;
+  bool change_b = false;
+
+  if ((motion->glitch_edges > 0) && (motion->glitch_ps <= motion->next_ps)) {
+    *time_ps = motion->glitch_ps;
+    *input = INPUT_A;
+    motion->glitch_ps += GLITCH_WIDTH_PS;
+    motion->glitch_edges--;
+    return true;
+  }
+  if (motion->remaining == 0) {
+    return false;
+  }
+  change_b = (motion->a == motion->b) == (motion->direction > 0);
+  if (change_b) {
+    motion->b = !motion->b;
+  } else {
+    motion->a = !motion->a;
+  }
+  *time_ps = motion->next_ps;
+  *input = change_b ? INPUT_B : INPUT_A;
+  motion->next_ps += motion->step_ps;
+  motion->remaining--;
+  return true;
+}
+
+/*******************************************************************************
+ * Function to start a motion of the encoder, from where the last one ended.
+ *
+ * @param[in] speed_cps (uint32_t) Speed, in counts per second.
+ * @param[in] direction (int8_t) 1 forward, -1 backward.
+ * @param[in] counts (uint32_t) Counts until the encoder stops.
+ * @return none
+ ******************************************************************************/
+static void encoder_start(uint32_t speed_cps, int8_t direction, uint32_t counts)
+{
+  encoder.first_position += (int64_t)encoder.counts * encoder.direction;
+  encoder.step_ps = SIM_PS_PER_SECOND / speed_cps;
+  encoder.first_ps = sim_get_time_ps() + encoder.step_ps;
+  encoder.next_ps = encoder.first_ps;
+  encoder.direction = direction;
+  encoder.counts = counts;
+  encoder.remaining = counts;
+  encoder.glitch_edges = 0;
+  sim_ct_set_edge_source(encoder_source, &encoder);
+}
+
+/*******************************************************************************
+ * Function to return the position of the encoder now.
+ *
+ * @param none
+ * @return position, in counts
+ ******************************************************************************/
+static int64_t encoder_position(void)
+{
+  uint64_t now_ps = sim_get_time_ps();
+  uint64_t counts = 0;
+
+  if (now_ps >= encoder.first_ps) {
+    counts = (now_ps - encoder.first_ps) / encoder.step_ps + 1;
+  }
+  if (counts > encoder.counts) {
+    counts = encoder.counts;
+  }
+  return encoder.first_position + (int64_t)counts * encoder.direction;
+}
+
+/*******************************************************************************
+ * Function to run the main loop of the decoder for a time.
+ *
+ * @param[in] microseconds (uint32_t) Time to run.
+ * @return none
+ ******************************************************************************/
+static void run(uint32_t microseconds)
+{
+  uint64_t end = sim_get_cycles() + sim_us_to_cycles(microseconds);
+
+  while (sim_get_cycles() < end) {
+    quadrature_decoder_process();
+    sim_advance(LOOP_CYCLES);
+  }
+}
+
+/*******************************************************************************
+ * Function to start the decoder with both inputs low, the messages of the
+ * driver are dropped.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void start_decoder(void)
+{
+  sim_ct_set_edge_source(NULL, NULL);
+  sim_ct_set_input_level(INPUT_A, false);
+  sim_ct_set_input_level(INPUT_B, false);
+  encoder = (encoder_t){ .direction = 1 };
+  quadrature_decoder_init();
+  for (uint32_t call = 0; call < 2 * DEFERRED_LOG_RING_SIZE; call++) {
+    deferred_log_process();
+  }
+  sim_console_clear();
+}
+
+/*******************************************************************************
+ * Function to return the magnitude of a difference.
+ *
+ * @param[in] value (int64_t) Difference.
+ * @return magnitude
+ ******************************************************************************/
+static uint64_t magnitude(int64_t value)
+{
+  return (value < 0) ? (uint64_t)-value : (uint64_t)value;
+}
+
+/*******************************************************************************
+ * Sweeps the speed, both directions, across the switch to the count mode.
+ * Once settled, at every window end the velocity is within
+ * VELOCITY_ERROR_PPM, plus one edge of A per window in count mode, and the
+ * position within a few counts of the encoder,
+ * and the interrupt load stays bounded: above the switch only the wraps are
+ * taken. Once stopped, the position is exact again and the decoder back in
+ * capture mode.
+ ******************************************************************************/
+static void test_speed_sweep(void)
+{
+  static const uint32_t speeds_cps[] = {
+    100, 1000, 10000, 40000, 90000, 150000, 400000, 1000000
+  };
+  quadrature_decoder_state_t state;
+  uint64_t start_cycles = 0;
+  uint64_t end = 0;
+  uint64_t load_ppm = 0;
+  uint64_t velocity_error_ppm = 0;
+  uint64_t position_error = 0;
+  uint64_t position_error_max = 0;
+  uint64_t expected_mcps = 0;
+  uint32_t windows = 0;
+  uint32_t speed_count = sizeof(speeds_cps) / sizeof(speeds_cps[0]);
+  uint32_t speed_cps = 0;
+  int8_t direction = 1;
+
+  start_decoder();
+  for (uint32_t index = 0; index < 2 * speed_count; index++) {
+    speed_cps = speeds_cps[index % speed_count];
+    direction = (index < speed_count) ? 1 : -1;
+    expected_mcps = (uint64_t)speed_cps * 1000;
+    encoder_start(speed_cps, direction,
+                  (uint32_t)(((uint64_t)speed_cps * PHASE_US) / 1000000));
+    run(SETTLE_US);
+
+    sim_clear_isr_stats();
+    start_cycles = sim_get_cycles();
+    end = start_cycles + sim_us_to_cycles(PHASE_US - 2 * SETTLE_US);
+    windows = 0;
+    position_error_max = 0;
+    while (sim_get_cycles() < end) {
+      if (quadrature_decoder_process()) {
+        quadrature_decoder_get_state(&state);
+        velocity_error_ppm =
+          (magnitude(state.velocity_mcps - (int64_t)expected_mcps * direction)
+           * 1000000) / expected_mcps;
+        TEST_ASSERT(velocity_error_ppm <= VELOCITY_ERROR_PPM
+                    + ((state.mode == QUADRATURE_DECODER_COUNT)
+                       ? (COUNT_ERROR_CPS * 1000000ULL) / speed_cps : 0));
+        position_error = magnitude(state.position - encoder_position());
+        TEST_ASSERT(position_error <= POSITION_ERROR_MAX
+                    + (speed_cps * LATENCY_PS) / SIM_PS_PER_SECOND);
+        if (position_error > position_error_max) {
+          position_error_max = position_error;
+        }
+        windows++;
+      }
+      sim_advance(LOOP_CYCLES);
+    }
+    load_ppm = (sim_get_isr_cycles() * 1000000)
+               / (sim_get_cycles() - start_cycles);
+    TEST_ASSERT(windows > 0);
+    TEST_ASSERT(load_ppm <= LOAD_PPM_MAX);
+    if (state.mode == QUADRATURE_DECODER_COUNT) {
+      TEST_ASSERT(load_ppm <= COUNT_LOAD_PPM_MAX);
+    }
+    printf("%8ld cps %-7s position error %2lu, interrupt load %3lu.%02lu %%\n",
+           (long)speed_cps * direction,
+           (state.mode == QUADRATURE_DECODER_COUNT) ? "count" : "capture",
+           (unsigned long)position_error_max,
+           (unsigned long)(load_ppm / 10000),
+           (unsigned long)((load_ppm / 100) % 100));
+
+    run(SETTLE_US + STOP_US);
+    quadrature_decoder_get_state(&state);
+    TEST_ASSERT_EQUAL(QUADRATURE_DECODER_CAPTURE, state.mode);
+    TEST_ASSERT_EQUAL(0, state.velocity_mcps);
+    TEST_ASSERT_EQUAL(encoder_position(), state.position);
+  }
+  TEST_ASSERT_EQUAL(0, state.lost_edges);
+}
+
+/*******************************************************************************
+ * A pulse on A shorter than the interrupt latency is captured once, with A
+ * back at its level. The decoder counts the missing edge and the direction
+ * and the position stay right.
+ ******************************************************************************/
+static void test_glitch_keeps_direction(void)
+{
+  quadrature_decoder_state_t state;
+
+  start_decoder();
+  encoder_start(GLITCH_SPEED_CPS, 1, 2 * GLITCH_COUNTS);
+  encoder.glitch_ps = encoder.first_ps
+                      + encoder.step_ps * GLITCH_COUNTS - encoder.step_ps / 2;
+  encoder.glitch_edges = 2;
+  run((uint32_t)((2 * GLITCH_COUNTS * 1000000ULL) / GLITCH_SPEED_CPS));
+  run(STOP_US);
+
+  quadrature_decoder_get_state(&state);
+  TEST_ASSERT_EQUAL(1, state.lost_edges);
+  TEST_ASSERT_EQUAL(2 * GLITCH_COUNTS, state.position);
+  TEST_ASSERT_EQUAL(encoder_position(), state.position);
+}
+
+int main(void)
+{
+  TEST_RUN(test_speed_sweep);
+  TEST_RUN(test_glitch_keeps_direction);
+  return 0;
+}
@@ -0,0 +1,190 @@
+/***************************************************************************/ /**
+ * @file host/test/test_stream_stats.c
+ * @brief Host test of the streaming statistics
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <math.h>
+#include "stream_stats.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define BIN_WIDTH     10
+#define SAMPLE_COUNT  1000
+#define TOLERANCE     1e-6
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static stream_stats_t stats;
+static uint32_t samples[SAMPLE_COUNT];
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * The statistics match a direct two-pass computation, whatever the batches.
+ ******************************************************************************/
+static void test_moments(void)
+{
+  stream_stats_snapshot_t snapshot;
+  double mean = 0;
+  double variance = 0;
+  double jitter_square_sum = 0;
+  uint32_t jitter_max = 0;
+  uint32_t jitter = 0;
+
+  for (uint32_t index = 0; index < SAMPLE_COUNT; index++) {
+    samples[index] = 40000 + ((index * 7919) % 101) - 50;
+    mean += samples[index];
+  }
+  mean /= SAMPLE_COUNT;
+  for (uint32_t index = 0; index < SAMPLE_COUNT; index++) {
+    variance += (samples[index] - mean) * (samples[index] - mean);
+    if (index > 0) {
+      jitter = (samples[index] > samples[index - 1])
+               ? (samples[index] - samples[index - 1])
+               : (samples[index - 1] - samples[index]);
+      jitter_max = (jitter > jitter_max) ? jitter : jitter_max;
+      jitter_square_sum += (double)jitter * jitter;
+    }
+  }
+  variance /= SAMPLE_COUNT - 1;
+
+  stream_stats_init(&stats, BIN_WIDTH);
+  TEST_ASSERT(stream_stats_get_snapshot(&stats, &snapshot));
+  TEST_ASSERT_EQUAL(0, snapshot.count);
+  stream_stats_add_batch(&stats, samples, 1);
+  stream_stats_add_batch(&stats, &samples[1], 0);
+  stream_stats_add_batch(&stats, &samples[1], 300);
+  stream_stats_add_batch(&stats, &samples[301], SAMPLE_COUNT - 301);
+  TEST_ASSERT(stream_stats_get_snapshot(&stats, &snapshot));
+  TEST_ASSERT_EQUAL(SAMPLE_COUNT, snapshot.count);
+  TEST_ASSERT_EQUAL(39950, snapshot.min);
+  TEST_ASSERT_EQUAL(40050, snapshot.max);
+  TEST_ASSERT(fabs(snapshot.mean - mean) < TOLERANCE);
+  TEST_ASSERT(fabs(snapshot.std_dev - sqrt(variance)) < TOLERANCE);
+  TEST_ASSERT_EQUAL(jitter_max, snapshot.jitter_max);
+  TEST_ASSERT(fabs(snapshot.jitter_rms
+                   - sqrt(jitter_square_sum / (SAMPLE_COUNT - 1))) < TOLERANCE);
+  TEST_ASSERT(!snapshot.saturated);
+}
+
+/*******************************************************************************
+ * The histogram is centered on the first sample and the end bins count the
+ * outliers.
+ ******************************************************************************/
+static void test_histogram(void)
+{
+  stream_stats_snapshot_t snapshot;
+  const uint32_t values[] = { 1000, 1000, 1009, 1010, 995, 840, 839, 0,
+                              1159, 1160, UINT32_MAX };
+
+  stream_stats_init(&stats, BIN_WIDTH);
+  stream_stats_add_batch(&stats, values, sizeof(values) / sizeof(values[0]));
+  TEST_ASSERT(stream_stats_get_snapshot(&stats, &snapshot));
+  TEST_ASSERT_EQUAL(1000 - ((STREAM_STATS_HISTOGRAM_BINS / 2) * BIN_WIDTH),
+                    snapshot.histogram_start);
+  TEST_ASSERT_EQUAL(BIN_WIDTH, snapshot.bin_width);
+  TEST_ASSERT_EQUAL(3, snapshot.histogram[0]);  // 840, 839, 0
+  TEST_ASSERT_EQUAL(1, snapshot.histogram[15]); // 995
+  TEST_ASSERT_EQUAL(3, snapshot.histogram[16]); // 1000, 1000, 1009
+  TEST_ASSERT_EQUAL(1, snapshot.histogram[17]); // 1010
+  TEST_ASSERT_EQUAL(3, snapshot.histogram[STREAM_STATS_HISTOGRAM_BINS - 1]);
+}
+
+/*******************************************************************************
+ * A first sample below half the histogram span starts the bins at 0, rather
+ * than wrapping the lower bound.
+ ******************************************************************************/
+static void test_histogram_low_reference(void)
+{
+  stream_stats_snapshot_t snapshot;
+  const uint32_t values[] = { 5, 0, 9, 25, 319, 320 };
+
+  stream_stats_init(&stats, BIN_WIDTH);
+  stream_stats_add_batch(&stats, values, sizeof(values) / sizeof(values[0]));
+  TEST_ASSERT(stream_stats_get_snapshot(&stats, &snapshot));
+  TEST_ASSERT_EQUAL(0, snapshot.histogram_start);
+  TEST_ASSERT_EQUAL(3, snapshot.histogram[0]);
+  TEST_ASSERT_EQUAL(1, snapshot.histogram[2]);
+  TEST_ASSERT_EQUAL(2, snapshot.histogram[STREAM_STATS_HISTOGRAM_BINS - 1]);
+  TEST_ASSERT(fabs(snapshot.mean - (678.0 / 6)) < TOLERANCE);
+
+  // A new window takes its own reference.
+  stream_stats_reset(&stats);
+  stream_stats_add_batch(&stats, &values[4], 1);
+  TEST_ASSERT(stream_stats_get_snapshot(&stats, &snapshot));
+  TEST_ASSERT_EQUAL(319 - ((STREAM_STATS_HISTOGRAM_BINS / 2) * BIN_WIDTH),
+                    snapshot.histogram_start);
+  TEST_ASSERT_EQUAL(1, snapshot.histogram[STREAM_STATS_HISTOGRAM_BINS / 2]);
+}
+
+/*******************************************************************************
+ * Squared sums past 2^64 saturate and flag the statistics instead of
+ * wrapping to a wrong deviation, until the next reset.
+ ******************************************************************************/
+static void test_saturation(void)
+{
+  stream_stats_snapshot_t snapshot;
+  const uint32_t values[] = { 0, UINT32_MAX, 0, UINT32_MAX };
+
+  stream_stats_init(&stats, BIN_WIDTH);
+  stream_stats_add_batch(&stats, values, 2);
+  TEST_ASSERT(stream_stats_get_snapshot(&stats, &snapshot));
+  TEST_ASSERT(!snapshot.saturated);
+  TEST_ASSERT(snapshot.std_dev > 3.0e9);
+
+  stream_stats_add_batch(&stats, &values[2], 2);
+  TEST_ASSERT(stream_stats_get_snapshot(&stats, &snapshot));
+  TEST_ASSERT(snapshot.saturated);
+  TEST_ASSERT_EQUAL(UINT64_MAX, stats.deviation_square_sum);
+  TEST_ASSERT_EQUAL(UINT64_MAX, stats.jitter_square_sum);
+  TEST_ASSERT(snapshot.std_dev == 0);
+  TEST_ASSERT(snapshot.jitter_rms == 0);
+  TEST_ASSERT_EQUAL(4, snapshot.count);
+  TEST_ASSERT_EQUAL(UINT32_MAX, snapshot.jitter_max);
+
+  stream_stats_reset(&stats);
+  stream_stats_add_batch(&stats, samples, 2);
+  TEST_ASSERT(stream_stats_get_snapshot(&stats, &snapshot));
+  TEST_ASSERT(!snapshot.saturated);
+}
+
+/*******************************************************************************
+ * A snapshot taken while the writer is updating is refused.
+ ******************************************************************************/
+static void test_snapshot_busy(void)
+{
+  stream_stats_snapshot_t snapshot;
+
+  stream_stats_init(&stats, BIN_WIDTH);
+  stream_stats_add_batch(&stats, samples, 10);
+  stats.sequence++;
+  TEST_ASSERT(!stream_stats_get_snapshot(&stats, &snapshot));
+  stats.sequence++;
+  TEST_ASSERT(stream_stats_get_snapshot(&stats, &snapshot));
+  TEST_ASSERT_EQUAL(10, snapshot.count);
+}
+
+int main(void)
+{
+  TEST_RUN(test_moments);
+  TEST_RUN(test_histogram);
+  TEST_RUN(test_histogram_low_reference);
+  TEST_RUN(test_saturation);
+  TEST_RUN(test_snapshot_busy);
+  return 0;
+}
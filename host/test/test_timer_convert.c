@@ -0,0 +1,139 @@
+/***************************************************************************/ /**
+ * @file host/test/test_timer_convert.c
+ * @brief Host test of the timer count conversions
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "timer_convert.h"
+#include "test.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define NANOSECONDS_PER_SECOND 1000000000ULL
+#define MILLIHERTZ_PER_HERTZ   1000ULL
+#define BATCH_LENGTH           8
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+// Timer clocks: SoC PLL, divided PLL, 40 MHz reference, 32 kHz, and odd ones
+static const uint32_t frequencies[] = { 180000000, 90000000, 40000000, 32768,
+                                        1000000, 12345678, 7, 1 };
+static const uint32_t counts[] = { 0, 1, 2, 3, 999, 1000, 4000, 65535, 65536,
+                                   40000000, 123456789, 0x80000000,
+                                   0xFFFFFFFE, 0xFFFFFFFF };
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * The Q32 conversion is within 1 ns of the exact duration rounded down, over
+ * the whole counter range.
+ ******************************************************************************/
+static void test_counts_to_ns(void)
+{
+  timer_convert_t convert;
+  unsigned __int128 exact = 0;
+  uint64_t converted = 0;
+
+  for (uint32_t f = 0; f < sizeof(frequencies) / sizeof(frequencies[0]); f++) {
+    timer_convert_init(&convert, frequencies[f]);
+    TEST_ASSERT_EQUAL(frequencies[f], convert.frequency);
+    for (uint32_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+      exact = ((unsigned __int128)counts[c] * NANOSECONDS_PER_SECOND) / frequencies[f];
+      converted = timer_convert_counts_to_ns(&convert, counts[c]);
+      TEST_ASSERT_RANGE((double)exact - 1, (double)exact + 1, converted);
+    }
+  }
+}
+
+/*******************************************************************************
+ * The 64-bit conversion matches the 32-bit one in its range. Past it, the
+ * error is the Q32 scale rounding, at most 1 ns per 2^32 counts.
+ ******************************************************************************/
+static void test_counts64_to_ns(void)
+{
+  static const uint64_t long_counts[] = { 0x100000000ULL, 0x123456789ULL,
+                                          0xFFFFFFFFFFULL, 0x3FFFFFFFFFFFULL };
+  timer_convert_t convert;
+  unsigned __int128 exact = 0;
+  uint64_t converted = 0;
+  uint64_t tolerance = 0;
+
+  for (uint32_t f = 0; f < sizeof(frequencies) / sizeof(frequencies[0]); f++) {
+    timer_convert_init(&convert, frequencies[f]);
+    for (uint32_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+      TEST_ASSERT_EQUAL(timer_convert_counts_to_ns(&convert, counts[c]),
+                        timer_convert_counts64_to_ns(&convert, counts[c]));
+    }
+    if (frequencies[f] < 1000000) {
+      continue; // Longest durations do not fit 64 bits of nanoseconds
+    }
+    for (uint32_t c = 0; c < sizeof(long_counts) / sizeof(long_counts[0]); c++) {
+      exact = ((unsigned __int128)long_counts[c] * NANOSECONDS_PER_SECOND)
+              / frequencies[f];
+      converted = timer_convert_counts64_to_ns(&convert, long_counts[c]);
+      tolerance = (long_counts[c] >> 32) + 1;
+      TEST_ASSERT(converted + tolerance >= exact);
+      TEST_ASSERT(converted <= exact + tolerance);
+    }
+  }
+}
+
+/*******************************************************************************
+ * Frequencies are exact in millihertz, rounded to nearest.
+ ******************************************************************************/
+static void test_counts_to_millihz(void)
+{
+  timer_convert_t convert;
+  uint64_t expected = 0;
+
+  for (uint32_t f = 0; f < sizeof(frequencies) / sizeof(frequencies[0]); f++) {
+    timer_convert_init(&convert, frequencies[f]);
+    for (uint32_t c = 1; c < sizeof(counts) / sizeof(counts[0]); c++) {
+      expected = (((uint64_t)frequencies[f] * MILLIHERTZ_PER_HERTZ) + (counts[c] / 2))
+                 / counts[c];
+      TEST_ASSERT_EQUAL(expected, timer_convert_counts_to_millihz(&convert, counts[c]));
+    }
+  }
+  // 40000 counts of a 40 MHz clock is 1 kHz.
+  timer_convert_init(&convert, 40000000);
+  TEST_ASSERT_EQUAL(1000000, timer_convert_counts_to_millihz(&convert, 40000));
+  TEST_ASSERT_EQUAL(1000000, timer_convert_counts_to_ns(&convert, 40000));
+}
+
+/*******************************************************************************
+ * The batch conversion matches the single one, also in place.
+ ******************************************************************************/
+static void test_batch(void)
+{
+  timer_convert_t convert;
+  uint64_t durations[BATCH_LENGTH];
+
+  timer_convert_init(&convert, 12345678);
+  timer_convert_counts_to_ns_batch(&convert, counts, durations, BATCH_LENGTH);
+  for (uint32_t index = 0; index < BATCH_LENGTH; index++) {
+    TEST_ASSERT_EQUAL(timer_convert_counts_to_ns(&convert, counts[index]),
+                      durations[index]);
+  }
+}
+
+int main(void)
+{
+  TEST_RUN(test_counts_to_ns);
+  TEST_RUN(test_counts64_to_ns);
+  TEST_RUN(test_counts_to_millihz);
+  TEST_RUN(test_batch);
+  return 0;
+}
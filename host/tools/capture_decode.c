@@ -0,0 +1,253 @@
+/***************************************************************************/ /**
+ * @file capture_decode.c
+ * @brief Host decoder of the capture export frames
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include "capture_decode.h"
+#include <string.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SEQUENCE_OFFSET 2 // Header offsets
+#define FLAGS_OFFSET    4
+#define COUNT_OFFSET    5
+#define LENGTH_OFFSET   6
+#define CRC_INIT        0xFFFF
+#define CRC_POLYNOMIAL  0x1021
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static void feed_byte(capture_decode_t *decoder,
+                      uint8_t byte,
+                      capture_decode_callback_t callback,
+                      void *context);
+static void resync(capture_decode_t *decoder,
+                   capture_decode_callback_t callback,
+                   void *context);
+static bool decode_frame(capture_decode_t *decoder,
+                         capture_decode_callback_t callback,
+                         void *context);
+static bool get_varint(const uint8_t *buffer,
+                       uint32_t length,
+                       uint32_t *offset,
+                       uint64_t *value);
+static uint16_t crc16(const uint8_t *data, uint32_t length);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Initializes a decoder.
+ ******************************************************************************/
+void capture_decode_init(capture_decode_t *decoder)
+{
+  memset(decoder, 0, sizeof(*decoder));
+}
+
+/*******************************************************************************
+ * Decodes received bytes.
+ ******************************************************************************/
+void capture_decode_feed(capture_decode_t *decoder,
+                         const uint8_t *data,
+                         uint32_t length,
+                         capture_decode_callback_t callback,
+                         void *context)
+{
+  for (uint32_t index = 0; index < length; index++) {
+    feed_byte(decoder, data[index], callback, context);
+  }
+}
+
+/*******************************************************************************
+ * Function to add one byte to the frame being received, and decode the frame
+ * once complete.
+ *
+ * @param[in,out] decoder (capture_decode_t) Decoder.
+ * @param[in] byte (uint8_t) Received byte.
+ * @param[in] callback (capture_decode_callback_t) Receives the timestamps.
+ * @param[in] context (void) Passed to the callback.
+ * @return none
+ ******************************************************************************/
+static void feed_byte(capture_decode_t *decoder,
+                      uint8_t byte,
+                      capture_decode_callback_t callback,
+                      void *context)
+{
+  uint32_t frame_length = 0;
+
+  if ((decoder->length == 0) && (byte != CAPTURE_EXPORT_SYNC_0)) {
+    return;
+  }
+  decoder->frame[decoder->length++] = byte;
+  if ((decoder->length == 2) && (byte != CAPTURE_EXPORT_SYNC_1)) {
+    resync(decoder, callback, context);
+    return;
+  }
+  if (decoder->length <= LENGTH_OFFSET) {
+    return;
+  }
+  if (decoder->frame[LENGTH_OFFSET] > CAPTURE_EXPORT_PAYLOAD_MAX) {
+    resync(decoder, callback, context);
+    return;
+  }
+  frame_length = CAPTURE_EXPORT_HEADER_SIZE + decoder->frame[LENGTH_OFFSET]
+                 + CAPTURE_EXPORT_CRC_SIZE;
+  if (decoder->length < frame_length) {
+    return;
+  }
+  if (decode_frame(decoder, callback, context)) {
+    decoder->length = 0;
+  } else {
+    decoder->frames_invalid++;
+    resync(decoder, callback, context);
+  }
+}
+
+/*******************************************************************************
+ * Function to drop the first byte of a false frame and look for a sync in
+ * the bytes received after it.
+ *
+ * @param[in,out] decoder (capture_decode_t) Decoder.
+ * @param[in] callback (capture_decode_callback_t) Receives the timestamps.
+ * @param[in] context (void) Passed to the callback.
+ * @return none
+ ******************************************************************************/
+static void resync(capture_decode_t *decoder,
+                   capture_decode_callback_t callback,
+                   void *context)
+{
+  uint8_t pending[CAPTURE_EXPORT_FRAME_MAX];
+  uint32_t count = decoder->length - 1;
+
+  memcpy(pending, &decoder->frame[1], count);
+  decoder->length = 0;
+  capture_decode_feed(decoder, pending, count, callback, context);
+}
+
+/*******************************************************************************
+ * Function to check a complete frame and pass its timestamps to the callback.
+ * Nothing is passed unless the whole frame is valid.
+ *
+ * @param[in,out] decoder (capture_decode_t) Decoder.
+ * @param[in] callback (capture_decode_callback_t) Receives the timestamps.
+ * @param[in] context (void) Passed to the callback.
+ * @return true if the frame was valid.
+ ******************************************************************************/
+static bool decode_frame(capture_decode_t *decoder,
+                         capture_decode_callback_t callback,
+                         void *context)
+{
+  const uint8_t *frame = decoder->frame;
+  uint32_t payload_end = CAPTURE_EXPORT_HEADER_SIZE + frame[LENGTH_OFFSET];
+  uint32_t count = frame[COUNT_OFFSET];
+  uint16_t sequence = (uint16_t)(frame[SEQUENCE_OFFSET]
+                                 | (frame[SEQUENCE_OFFSET + 1] << 8));
+  uint16_t crc = (uint16_t)(frame[payload_end] | (frame[payload_end + 1] << 8));
+  uint64_t values[CAPTURE_EXPORT_PAYLOAD_MAX];
+  uint64_t lost = 0;
+  uint64_t timestamp = 0;
+  uint32_t offset = CAPTURE_EXPORT_HEADER_SIZE;
+  bool gap = false;
+
+  if ((crc != crc16(&frame[SEQUENCE_OFFSET], payload_end - SEQUENCE_OFFSET))
+      || (count == 0)
+      || (frame[FLAGS_OFFSET] & ~CAPTURE_EXPORT_FLAG_LOST)) {
+    return false;
+  }
+  if ((frame[FLAGS_OFFSET] & CAPTURE_EXPORT_FLAG_LOST)
+      && !get_varint(frame, payload_end, &offset, &lost)) {
+    return false;
+  }
+  for (uint32_t index = 0; index < count; index++) {
+    if (!get_varint(frame, payload_end, &offset, &values[index])) {
+      return false;
+    }
+  }
+  if (offset != payload_end) {
+    return false;
+  }
+
+  if (decoder->sequence_valid && (sequence != decoder->next_sequence)) {
+    decoder->frames_missed += (uint16_t)(sequence - decoder->next_sequence);
+    gap = true;
+  }
+  if (lost > 0) {
+    decoder->captures_lost += (uint32_t)lost;
+    gap = true;
+  }
+  decoder->next_sequence = (uint16_t)(sequence + 1);
+  decoder->sequence_valid = true;
+  decoder->frames++;
+  decoder->timestamps += count;
+  for (uint32_t index = 0; index < count; index++) {
+    timestamp = (index == 0) ? values[0] : (timestamp + values[index]);
+    callback(context, timestamp, gap && (index == 0));
+  }
+  return true;
+}
+
+/*******************************************************************************
+ * Function to decode a varint.
+ *
+ * @param[in] buffer (uint8_t) Bytes to decode.
+ * @param[in] length (uint32_t) End of the bytes.
+ * @param[in,out] offset (uint32_t) Position of the varint, moved past it.
+ * @param[out] value (uint64_t) Decoded value.
+ * @return false if the varint runs past the end or 64 bits.
+ ******************************************************************************/
+static bool get_varint(const uint8_t *buffer,
+                       uint32_t length,
+                       uint32_t *offset,
+                       uint64_t *value)
+{
+  uint64_t result = 0;
+  uint8_t byte = 0;
+
+  for (uint32_t shift = 0; shift < (7 * CAPTURE_EXPORT_VARINT_MAX); shift += 7) {
+    if (*offset >= length) {
+      return false;
+    }
+    byte = buffer[(*offset)++];
+    result |= (uint64_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+/*******************************************************************************
+ * Function to compute the CRC-16/CCITT-FALSE of a buffer, bit by bit, as a
+ * check of the table-driven encoder.
+ *
+ * @param[in] data (uint8_t) Bytes to check.
+ * @param[in] length (uint32_t) Number of bytes.
+ * @return CRC
+ ******************************************************************************/
+static uint16_t crc16(const uint8_t *data, uint32_t length)
+{
+  uint16_t crc = CRC_INIT;
+
+  for (uint32_t index = 0; index < length; index++) {
+    crc ^= (uint16_t)(data[index] << 8);
+    for (uint32_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ CRC_POLYNOMIAL)
+            : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
@@ -0,0 +1,75 @@
+/***************************************************************************/ /**
+ * @file capture_decode.h
+ * @brief Host decoder of the capture export frames
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef CAPTURE_DECODE_H_
+#define CAPTURE_DECODE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "capture_export.h"
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Called for each decoded timestamp. The gap flag is set on the first
+// timestamp after lost captures or missed frames.
+typedef void (*capture_decode_callback_t)(void *context,
+                                          uint64_t timestamp,
+                                          bool gap);
+
+// Decoder of a byte stream written by capture_export_transmit. It finds the
+// frames by their sync bytes and resynchronizes after a bad frame.
+typedef struct {
+  uint8_t frame[CAPTURE_EXPORT_FRAME_MAX]; // Frame being received
+  uint32_t length;                         // Bytes in frame
+  uint16_t next_sequence;                  // Sequence expected next
+  bool sequence_valid;                     // A frame was decoded
+  uint32_t frames;                         // Frames decoded
+  uint32_t timestamps;                     // Timestamps decoded
+  uint32_t frames_missed;                  // Frames dropped by the sender or the link
+  uint32_t frames_invalid;                 // Frames with a bad CRC or payload
+  uint32_t captures_lost;                  // Captures lost before the sender, from the frames
+} capture_decode_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Initializes a decoder, waiting for a sync.
+ *
+ * @param[out] decoder Decoder to initialize.
+ * @return none
+ ******************************************************************************/
+void capture_decode_init(capture_decode_t *decoder);
+
+/***************************************************************************/ /**
+ * Decodes received bytes, in chunks of any size. The timestamps of each
+ * valid frame are passed to the callback, in order.
+ *
+ * @param[in,out] decoder Decoder.
+ * @param[in] data Received bytes.
+ * @param[in] length Number of bytes.
+ * @param[in] callback Function receiving the timestamps.
+ * @param[in] context Passed to the callback.
+ * @return none
+ ******************************************************************************/
+void capture_decode_feed(capture_decode_t *decoder,
+                         const uint8_t *data,
+                         uint32_t length,
+                         capture_decode_callback_t callback,
+                         void *context);
+
+#endif /* CAPTURE_DECODE_H_ */
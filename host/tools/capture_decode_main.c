@@ -0,0 +1,83 @@
+/***************************************************************************/ /**
+ * @file capture_decode_main.c
+ * @brief Decodes a capture export stream to text
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include "capture_decode.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define READ_CHUNK 4096
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Function to print a timestamp the way the text path of the pulse capture
+ * example does, after a note on any gap.
+ *
+ * @param[in] context (FILE) Output stream.
+ * @param[in] timestamp (uint64_t) Decoded timestamp.
+ * @param[in] gap (bool) Captures or frames were lost before it.
+ * @return none
+ ******************************************************************************/
+static void print_timestamp(void *context, uint64_t timestamp, bool gap)
+{
+  FILE *output = context;
+
+  if (gap) {
+    fprintf(output, "captures lost\n");
+  }
+  fprintf(output, "capture value 0x%016llX\n", (unsigned long long)timestamp);
+}
+
+/*******************************************************************************
+ * Reads a byte stream captured from the debug UART, from the file given or
+ * from the standard input, and prints the timestamps. The counts of frames
+ * and losses go to the standard error.
+ ******************************************************************************/
+int main(int argc, char **argv)
+{
+  static capture_decode_t decoder;
+  uint8_t buffer[READ_CHUNK];
+  FILE *input = stdin;
+  size_t length = 0;
+
+  if (argc > 2) {
+    fprintf(stderr, "usage: %s [capture file]\n", argv[0]);
+    return 2;
+  }
+  if ((argc == 2) && ((input = fopen(argv[1], "rb")) == NULL)) {
+    perror(argv[1]);
+    return 1;
+  }
+  capture_decode_init(&decoder);
+  while ((length = fread(buffer, 1, sizeof(buffer), input)) > 0) {
+    capture_decode_feed(&decoder, buffer, (uint32_t)length, print_timestamp,
+                        stdout);
+  }
+  fprintf(stderr, "%lu frames, %lu timestamps, %lu frames missed, "
+          "%lu invalid, %lu captures lost\n",
+          (unsigned long)decoder.frames,
+          (unsigned long)decoder.timestamps,
+          (unsigned long)decoder.frames_missed,
+          (unsigned long)decoder.frames_invalid,
+          (unsigned long)decoder.captures_lost);
+  if (input != stdin) {
+    fclose(input);
+  }
+  return 0;
+}
@@ -0,0 +1,77 @@
+/***************************************************************************/ /**
+ * @file frequency_counter.h
+ * @brief Reciprocal frequency counter on the config timer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef FREQUENCY_COUNTER_H
+#define FREQUENCY_COUNTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Result of one gate
+typedef struct {
+  uint64_t frequency_millihz; // Input frequency, in millihertz
+  uint32_t edges;         // Input periods counted over the gate
+  uint64_t gate_counts;   // Exact gate duration, in timer counts
+  uint32_t resolution_ppb; // One timer count relative to the gate, in ppb
+} frequency_counter_result_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Configures CT0 as a reciprocal frequency counter and starts it.
+ * Counter 0 is the 16-bit timebase and captures every falling edge, counter 1
+ * counts the falling edges and interrupts once per gate. The input pin must
+ * be configured first.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void frequency_counter_init(void);
+
+/***************************************************************************/ /**
+ * Handles the config timer interrupt flags, called from the IRQ handler.
+ *
+ * @param[in] flags Interrupt flags read and cleared by the IRQ handler.
+ * @return none
+ ******************************************************************************/
+void frequency_counter_irq_handler(uint32_t flags);
+
+/***************************************************************************/ /**
+ * Returns the result of the last completed gate.
+ *
+ * @param[out] result Result of the gate.
+ * @return true if a new gate was completed since the previous call.
+ ******************************************************************************/
+bool frequency_counter_get_result(frequency_counter_result_t *result);
+
+#endif // FREQUENCY_COUNTER_H
@@ -0,0 +1,92 @@
+/***************************************************************************/ /**
+ * @file quadrature_decoder.h
+ * @brief Quadrature encoder decoding on the config timer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef QUADRATURE_DECODER_H
+#define QUADRATURE_DECODER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+// Source of the edges
+typedef enum {
+  QUADRATURE_DECODER_CAPTURE = 0, // Every edge of A and B is captured and decoded
+  QUADRATURE_DECODER_COUNT,       // The edges of A are only counted, at high speed
+} quadrature_decoder_mode_t;
+
+// Decoder state, one count per edge of A or B, four counts per encoder line
+typedef struct {
+  int64_t position;                 // Position, in counts
+  int64_t velocity_mcps;            // Velocity, in millicounts per second
+  quadrature_decoder_mode_t mode;   // Current source of the edges
+  uint32_t lost_edges;              // Edges dropped by the capture ring or found missing
+} quadrature_decoder_state_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Configures CT0 in 16-bit mode, counter 0 captures both edges of A on
+ * SCT_IN_0 and counter 1 both edges of B on SCT_IN_1, and starts it in
+ * capture mode. The position starts at 0.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void quadrature_decoder_init(void);
+
+/***************************************************************************/ /**
+ * Queues the captured edges and counts the timebase wraps, called from the
+ * IRQ handler.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void quadrature_decoder_irq_handler(void);
+
+/***************************************************************************/ /**
+ * Decodes the queued edges and, once per window, updates the velocity and
+ * switches between the capture and count modes. Called from the main loop.
+ *
+ * @param none
+ * @return true if a window ended and the velocity was updated.
+ ******************************************************************************/
+bool quadrature_decoder_process(void);
+
+/***************************************************************************/ /**
+ * Returns the decoder state, from the main loop.
+ *
+ * @param[out] state Position, velocity and mode.
+ * @return none
+ ******************************************************************************/
+void quadrature_decoder_get_state(quadrature_decoder_state_t *state);
+
+#endif // QUADRATURE_DECODER_H
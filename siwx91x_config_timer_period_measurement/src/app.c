@@ -32,44 +32,185 @@
  * as a demonstration for evaluation purposes only. This code will be maintained
  * at the sole discretion of Silicon Labs.
  ******************************************************************************/
-#include "rsi_rom_egpio.h"
-#include "rsi_rom_clks.h"
-#include "rsi_egpio.h"
 #include "rsi_debug.h"
-#include "rsi_ct.h"
+#include "rsi_rom_egpio.h"
 #include "clock_update.h"
+#include "isr_trace.h"
+#include "capture_timer.h"
+#include "capture_timebase.h"
+#include "capture_ring.h"
+#include "timer_convert.h"
+#include "stream_stats.h"
+#include "deferred_log.h"
+#include "frequency_counter.h"
+#include "quadrature_decoder.h"
+#include "benchmark.h"
 
 #define SL_SI91X_REQUIRES_INTF_PLL
 
-#define CONFIG_TIMER_INPUT_GPIO_PORT  RTE_SCT_IN_0_PORT
-#define CONFIG_TIMER_INPUT_GPIO_PIN   RTE_SCT_IN_0_PIN
-#define CONFIG_TIMER_INPUT_GPIO_PAD   RTE_SCT_IN_0_PAD
-#define CONFIG_TIMER_0_BASE_ADD       CT0
-#define CONFIG_TIMER_IRQHandler       IRQ034_Handler
-#define FALLING_EDGE_EVENT            0x05
 
-#define EDGE_CAPTURE_BUFFER_SIZE      2
-#define TOP_COUNTER_VALUE             0xFFFFFFFF // Top value for the timer/counter
-#define CONFIG_TIMER_FREQ             RSI_CLK_GetBaseClock(M4_CT)
+#define CAPTURE_BATCH_SIZE            16   // Timestamps taken from the ring at once
+#define CONFIG_TIMER_ISR_TRACE_ID     0    // Handler identifier when ISR_TRACE_ENABLE is set
+#define CONFIG_TIMER_TRACE_REPORT_RUNS 1000 // Handler runs between two trace reports
+#define PERIOD_STATS_BIN_WIDTH        1    // Period histogram bin width, in timer counts
+#define PERIOD_STATS_REPORT_COUNT     10000 // Periods between two statistics reports
+#define BENCHMARK_EDGE_STEP           1000 // Timer counts between two benchmark edges
+#define BENCHMARK_BATCHES             16   // Batches measured by the period benchmarks
+#define BENCHMARK_CAPTURE_MAX_CYCLES  80   // Capture path threshold, in cycles per captured edge
+#define BENCHMARK_CALCULATE_PERIOD_MAX_CYCLES 12 // calculate_period threshold, in cycles per period
+#define BENCHMARK_MEASURE_MAX_CYCLES  160  // measure_periods threshold, in cycles per period
+#define BENCHMARK_IRQ_MAX_CYCLES      250  // CONFIG_TIMER_IRQHandler threshold, in cycles per run, needs ISR_TRACE_ENABLE
+
+#ifndef CONFIG_TIMER_DUTY_CYCLE_ENABLE
+#define CONFIG_TIMER_DUTY_CYCLE_ENABLE 0   // Set to 1 to capture both edges and measure the high time of each period
+#endif
+#define DUTY_CYCLE_HOLD_MS            100  // No edge for this long, the input is held at 0 % or 100 %
+#define DUTY_CYCLE_FULL_PPM           1000000
+#ifndef CONFIG_TIMER_RECIPROCAL_ENABLE
+#define CONFIG_TIMER_RECIPROCAL_ENABLE 0   // Set to 1 to measure the frequency over a gate of many periods
+#endif
+#ifndef CONFIG_TIMER_QUADRATURE_ENABLE
+#define CONFIG_TIMER_QUADRATURE_ENABLE 0   // Set to 1 to decode a quadrature encoder on SCT_IN_0 and SCT_IN_1
+#endif
+
+#if CONFIG_TIMER_DUTY_CYCLE_ENABLE && CONFIG_TIMER_RECIPROCAL_ENABLE
+#error "The duty cycle mode needs the capture interrupt, it cannot be combined with the reciprocal mode"
+#endif
+
+#if CONFIG_TIMER_QUADRATURE_ENABLE \
+  && (CONFIG_TIMER_DUTY_CYCLE_ENABLE || CONFIG_TIMER_RECIPROCAL_ENABLE)
+#error "The quadrature mode uses both counters, it cannot be combined with the duty cycle or reciprocal modes"
+#endif
+
+#if (STREAM_STATS_HISTOGRAM_BINS % 4) != 0
+#error "The period histogram is logged four bins at a time, STREAM_STATS_HISTOGRAM_BINS must be a multiple of 4"
+#endif
 
-static volatile uint32_t edge_capture_buffer[EDGE_CAPTURE_BUFFER_SIZE];
-static volatile uint8_t edge_capture_index = 0;
-static volatile bool measurement_ready = false;
-static volatile bool counter_1_overflow = false;
-static volatile uint32_t period_measurement_us = 0;
+// The IRQ handler captures the edges itself, the other modes hand the timer
+// to their own module.
+#define CAPTURE_EDGES_IN_HANDLER \
+  (!CONFIG_TIMER_RECIPROCAL_ENABLE && !CONFIG_TIMER_QUADRATURE_ENABLE)
+// The periods are measured edge to edge, the duty cycle mode pairs the edges
+// into pulses instead.
+#define MEASURE_EDGE_PERIODS \
+  (CAPTURE_EDGES_IN_HANDLER && !CONFIG_TIMER_DUTY_CYCLE_ENABLE)
 
-static void sl_gpio_init(void);
-static void sl_config_timer_init(void);
-static void RSI_EGPIO_CLK_init(void);
-static uint32_t calculate_period(void);
+#if CONFIG_TIMER_DUTY_CYCLE_ENABLE
+// The first capture is a rising edge, then the captured edge alternates.
+#define CAPTURE_START_EVENT           CAPTURE_TIMER_RISING_EDGE
+// Set on the queued timestamps of rising edges, far above any timestamp
+#define PULSE_RISING_EDGE_TAG         (1ULL << 63)
+#else
+#define CAPTURE_START_EVENT           CAPTURE_TIMER_FALLING_EDGE
+#endif
+
+#define CAPTURE_INTERRUPT_EVENTS      (CAPTURE_TIMER_CAPTURE_EVENT | CAPTURE_TIMER_WRAP_EVENT)
+
+static capture_ring_t edge_capture_ring;
+static capture_timebase_t edge_timebase;
+#if MEASURE_EDGE_PERIODS || BENCHMARK_ENABLE
+static uint64_t previous_edge = 0;
+static bool previous_edge_valid = false;
+#endif
+static timer_convert_t period_convert;
+static volatile uint64_t period_measurement_ns = 0;
+static volatile uint64_t frequency_measurement_millihz = 0;
+static volatile uint32_t period_count = 0;
+static stream_stats_t period_stats;
+#if CONFIG_TIMER_QUADRATURE_ENABLE
+static volatile int64_t encoder_position = 0;
+static volatile int64_t encoder_velocity_mcps = 0;
+#endif
+#if CONFIG_TIMER_DUTY_CYCLE_ENABLE
+// Written by the IRQ handler only
+static bool pulse_rising_edge_next = true;
+// Written by the main loop only
+static bool pulse_rising_edge_valid = false;
+static bool pulse_falling_edge_valid = false;
+static uint64_t pulse_rising_edge = 0;
+static uint64_t pulse_falling_edge = 0;
+static uint64_t pulse_last_edge = 0;
+static uint64_t pulse_hold_counts = 0;
+static volatile uint64_t high_width_ns = 0;
+static volatile uint32_t duty_cycle_ppm = 0;
+#endif
+#if BENCHMARK_ENABLE
+static uint64_t benchmark_edges[CAPTURE_BATCH_SIZE];
+static volatile uint32_t benchmark_period_sum = 0;
+#endif
+
+#if MEASURE_EDGE_PERIODS
+static void process_edge_captures(void);
+#endif
+static void report_period_stats(void);
+#if CONFIG_TIMER_DUTY_CYCLE_ENABLE
+static void capture_pulse_edge(uint64_t edge);
+static void process_pulses(void);
+static void check_pulse_hold(void);
+#endif
+#if MEASURE_EDGE_PERIODS || BENCHMARK_ENABLE
+static void measure_periods(const uint64_t *edges,
+                            const bool *gaps,
+                            uint32_t count);
+#endif
+#if CONFIG_TIMER_RECIPROCAL_ENABLE
+static void process_frequency_counter(void);
+#endif
+#if CONFIG_TIMER_QUADRATURE_ENABLE
+static void process_quadrature_decoder(void);
+#endif
+static uint32_t calculate_period(uint64_t first_edge, uint64_t second_edge);
+#if CAPTURE_EDGES_IN_HANDLER
+static void capture_edge(uint64_t edge);
+#endif
+#if BENCHMARK_ENABLE
+static void run_benchmarks(void);
+#if MEASURE_EDGE_PERIODS
+static void benchmark_capture_edge(void *context);
+#endif
+static void benchmark_calculate_period(void *context);
+static void benchmark_measure_periods(void *context);
+#endif
 
 /***************************************************************************/ /**
  * Initialize application.
  ******************************************************************************/
 void app_init(void)
 {
-  sl_gpio_init();
-  sl_config_timer_init();
+  // The timer clock is selected first, the tracing and the conversions need
+  // its frequency.
+  capture_timer_clock_init();
+#if ISR_TRACE_ENABLE
+  isr_trace_init();
+  isr_trace_set_timer_frequency(CAPTURE_TIMER_FREQUENCY);
+#endif
+  capture_timebase_init(&edge_timebase, CAPTURE_TIMER_COUNTER_BITS);
+  capture_ring_init(&edge_capture_ring);
+#if CONFIG_TIMER_DUTY_CYCLE_ENABLE
+  pulse_rising_edge_next = true;
+  pulse_rising_edge_valid = false;
+  pulse_falling_edge_valid = false;
+  pulse_last_edge = 0;
+  pulse_hold_counts = ((uint64_t)CAPTURE_TIMER_FREQUENCY * DUTY_CYCLE_HOLD_MS) / 1000;
+#endif
+  capture_timer_gpio_init();
+#if CONFIG_TIMER_RECIPROCAL_ENABLE
+  frequency_counter_init();
+#elif CONFIG_TIMER_QUADRATURE_ENABLE
+  quadrature_decoder_init();
+#else
+  capture_timer_init(CAPTURE_INTERRUPT_EVENTS, CAPTURE_START_EVENT);
+#endif
+  // The conversion factors only change with the timer clock, they are
+  // computed once here.
+  timer_convert_init(&period_convert, CAPTURE_TIMER_FREQUENCY);
+  stream_stats_init(&period_stats, PERIOD_STATS_BIN_WIDTH);
+#if BENCHMARK_ENABLE
+  // The handler is held off while the benchmarks use the capture state.
+  NVIC_DisableIRQ(CAPTURE_TIMER_IRQn);
+  run_benchmarks();
+  NVIC_EnableIRQ(CAPTURE_TIMER_IRQn);
+#endif
 }
 
 /***************************************************************************/ /**
@@ -77,112 +218,456 @@ void app_init(void)
  ******************************************************************************/
 void app_process_action(void)
 {
-  if (measurement_ready) {
-    period_measurement_us = calculate_period();
+#if CONFIG_TIMER_RECIPROCAL_ENABLE
+  process_frequency_counter();
+#elif CONFIG_TIMER_QUADRATURE_ENABLE
+  process_quadrature_decoder();
+#elif CONFIG_TIMER_DUTY_CYCLE_ENABLE
+  process_pulses();
+#else
+  process_edge_captures();
+#endif
+  if (period_stats.count >= PERIOD_STATS_REPORT_COUNT) {
+    report_period_stats();
+  }
+  deferred_log_process();
+#if ISR_TRACE_ENABLE
+  isr_trace_stats_t trace_stats;
+
+  isr_trace_process();
+  isr_trace_get_stats(CONFIG_TIMER_ISR_TRACE_ID, &trace_stats);
+  if (trace_stats.duration.count >= CONFIG_TIMER_TRACE_REPORT_RUNS) {
+    isr_trace_print(CONFIG_TIMER_ISR_TRACE_ID, "CONFIG_TIMER_IRQHandler");
+#if BENCHMARK_ENABLE
+    benchmark_report("config_timer_irq_handler",
+                     trace_stats.duration.count,
+                     trace_stats.duration.total,
+                     BENCHMARK_IRQ_MAX_CYCLES);
+#endif
+    isr_trace_reset(CONFIG_TIMER_ISR_TRACE_ID);
   }
+#endif
 }
 
-static void sl_gpio_init(void)
+#if MEASURE_EDGE_PERIODS
+/***************************************************************************/ /**
+ * Drains the capture ring and measures the period between every pair of
+ * consecutive edges. Edges following dropped ones start a new pair, a period
+ * is never measured across a gap.
+ ******************************************************************************/
+static void process_edge_captures(void)
 {
-  RSI_EGPIO_CLK_init();
+  uint64_t edges[CAPTURE_BATCH_SIZE];
+  bool gaps[CAPTURE_BATCH_SIZE];
+  uint32_t count = 0;
 
-  if ((CONFIG_TIMER_INPUT_GPIO_PIN > 24)
-      && (CONFIG_TIMER_INPUT_GPIO_PIN < 31)) {
-    RSI_EGPIO_HostPadsGpioModeEnable(RTE_SCT_IN_0_PIN);
-  }
+  do {
+    count = capture_ring_pop_batch(&edge_capture_ring, edges, gaps,
+                                   CAPTURE_BATCH_SIZE);
+    measure_periods(edges, gaps, count);
+  } while (count == CAPTURE_BATCH_SIZE);
+}
+#endif
 
-  RSI_EGPIO_PadReceiverEnable(RTE_SCT_IN_0_PIN);
+#if MEASURE_EDGE_PERIODS || BENCHMARK_ENABLE
+/***************************************************************************/ /**
+ * Measures the periods of a batch of edges, the first one is paired with the
+ * last edge of the previous batch. gaps can be NULL when no edge was lost.
+ * The periods are converted to nanoseconds in one pass, with the scale
+ * factors computed at init, and the last one is also converted to a
+ * frequency.
+ ******************************************************************************/
+static void measure_periods(const uint64_t *edges,
+                            const bool *gaps,
+                            uint32_t count)
+{
+  uint32_t period_counts[CAPTURE_BATCH_SIZE];
+  uint64_t periods_ns[CAPTURE_BATCH_SIZE];
+  uint32_t periods = 0;
 
-  RSI_EGPIO_SetDir(EGPIO, CONFIG_TIMER_INPUT_GPIO_PORT,
-                   CONFIG_TIMER_INPUT_GPIO_PIN, EGPIO_CONFIG_DIR_INPUT);
+  for (uint32_t index = 0; index < count; index++) {
+    if (previous_edge_valid && ((gaps == NULL) || !gaps[index])) {
+      period_counts[periods++] = calculate_period(previous_edge, edges[index]);
+    }
+    previous_edge = edges[index];
+    previous_edge_valid = true;
+  }
+  if (periods == 0) {
+    return;
+  }
+  stream_stats_add_batch(&period_stats, period_counts, periods);
+  timer_convert_counts_to_ns_batch(&period_convert,
+                                   period_counts,
+                                   periods_ns,
+                                   periods);
+  period_measurement_ns = periods_ns[periods - 1];
+  if (period_counts[periods - 1] != 0) {
+    frequency_measurement_millihz =
+      timer_convert_counts_to_millihz(&period_convert, period_counts[periods - 1]);
+  }
+  period_count += periods;
+}
+#endif
 
-  RSI_EGPIO_SetPinMux(EGPIO, CONFIG_TIMER_INPUT_GPIO_PORT,
-                      CONFIG_TIMER_INPUT_GPIO_PIN, RTE_SCT_IN_0_MUX);
+/***************************************************************************/ /**
+ * Prints the period statistics on the debug console and starts a new window.
+ * The statistics are in timer counts, the fractional values with three
+ * decimals. The report is recorded with DLOG, the longer lines a few
+ * arguments at a time, so the main loop does not wait for the debug UART.
+ ******************************************************************************/
+static void report_period_stats(void)
+{
+  stream_stats_snapshot_t snapshot;
+  uint64_t mean_milli = 0;
+  uint64_t std_dev_milli = 0;
+  uint64_t jitter_rms_milli = 0;
 
-  DEBUGOUT("Successfully set pin mode for GPIO_25\r\n");
+  if (!stream_stats_get_snapshot(&period_stats, &snapshot)) {
+    return;
+  }
+  mean_milli = (uint64_t)((snapshot.mean * 1000) + 0.5);
+  std_dev_milli = (uint64_t)((snapshot.std_dev * 1000) + 0.5);
+  jitter_rms_milli = (uint64_t)((snapshot.jitter_rms * 1000) + 0.5);
+  DLOG("Periods: %lu, min %lu max %lu",
+       (unsigned long)snapshot.count,
+       (unsigned long)snapshot.min,
+       (unsigned long)snapshot.max);
+  DLOG(" mean %lu.%03lu std dev %lu.%03lu counts \n",
+       (unsigned long)(mean_milli / 1000),
+       (unsigned long)(mean_milli % 1000),
+       (unsigned long)(std_dev_milli / 1000),
+       (unsigned long)(std_dev_milli % 1000));
+  DLOG("Cycle-to-cycle jitter: max %lu rms %lu.%03lu counts \n",
+       (unsigned long)snapshot.jitter_max,
+       (unsigned long)(jitter_rms_milli / 1000),
+       (unsigned long)(jitter_rms_milli % 1000));
+  if (snapshot.saturated) {
+    DLOG("Period statistics saturated, std dev and jitter rms unknown \n");
+  }
+  DLOG("Period histogram from %lu, %lu counts per bin:",
+       (unsigned long)snapshot.histogram_start,
+       (unsigned long)snapshot.bin_width);
+  for (uint32_t bin = 0; bin < STREAM_STATS_HISTOGRAM_BINS; bin += 4) {
+    DLOG(" %lu %lu %lu %lu",
+         (unsigned long)snapshot.histogram[bin],
+         (unsigned long)snapshot.histogram[bin + 1],
+         (unsigned long)snapshot.histogram[bin + 2],
+         (unsigned long)snapshot.histogram[bin + 3]);
+  }
+  DLOG(" \n");
+  stream_stats_reset(&period_stats);
 }
 
-static void sl_config_timer_init(void)
+#if CONFIG_TIMER_DUTY_CYCLE_ENABLE
+/***************************************************************************/ /**
+ * Handles one captured edge in duty cycle mode, from the IRQ handler.
+ * The capture event alternates between the rising and the falling edge, so
+ * the polarity of each capture is known without reading the pin. The edge is
+ * queued in the capture ring, tagged with its polarity.
+ * An edge arriving before the next event is selected is missed: the input is
+ * then already at the level the armed edge leads to, with no capture
+ * pending. The missed edge is counted as lost, so the pulses around it are
+ * not measured, and the other edge is armed.
+ ******************************************************************************/
+static void capture_pulse_edge(uint64_t edge)
 {
-  uint32_t ct_config_value = 0;
-  ct_config_value = 0;
-  uint32_t interrupt_flags = 0;
-  interrupt_flags = 0;
+  uint32_t next_event = CAPTURE_TIMER_RISING_EDGE;
+  uint32_t other_event = CAPTURE_TIMER_FALLING_EDGE;
+  uint64_t tag = 0;
+  bool level = false;
 
-  RSI_CLK_CtClkConfig(M4CLK, CT_SOCPLLCLK, SCT_CLOCK_DIV_FACT,
-                      ENABLE_STATIC_CLK);
+  if (pulse_rising_edge_next) {
+    next_event = CAPTURE_TIMER_FALLING_EDGE;
+    other_event = CAPTURE_TIMER_RISING_EDGE;
+    tag = PULSE_RISING_EDGE_TAG;
+  }
+  // The next edge is armed first, the rest of the handler can be late.
+  capture_timer_select_edge(next_event);
+  capture_ring_push(&edge_capture_ring, edge | tag);
+  // The level is read before the status, an edge between them is captured.
+  level = RSI_EGPIO_GetPin(EGPIO, CAPTURE_TIMER_INPUT_PORT,
+                           CAPTURE_TIMER_INPUT_PIN) != 0;
+  if ((level != pulse_rising_edge_next)
+      && !(RSI_CT_GetInterruptStatus(CAPTURE_TIMER_BASE)
+           & CAPTURE_TIMER_CAPTURE_EVENT)) {
+    capture_timer_select_edge(other_event);
+    capture_ring_mark_lost(&edge_capture_ring);
+    return;
+  }
+  pulse_rising_edge_next = !pulse_rising_edge_next;
+}
 
-  ct_config_value = COUNTER32_BITMODE | PERIODIC_ENCOUNTER_0 | COUNTER0_UP;
-  interrupt_flags = RSI_CT_EVENT_INTR_0_l | RSI_CT_EVENT_COUNTER_0_IS_PEAK_l
-                    | RSI_CT_EVENT_COUNTER_1_IS_PEAK_l;
+/***************************************************************************/ /**
+ * Drains the capture ring and pairs the tagged edges into pulses. On each
+ * rising edge, the pulse started by the previous rising edge is measured if
+ * its falling edge was seen. Edges following dropped ones start a new pulse.
+ * The last pulse is published: its period, high time and duty cycle.
+ ******************************************************************************/
+static void process_pulses(void)
+{
+  uint64_t edges[CAPTURE_BATCH_SIZE];
+  bool gaps[CAPTURE_BATCH_SIZE];
+  uint32_t period_counts[CAPTURE_BATCH_SIZE];
+  uint32_t last_period = 0;
+  uint32_t last_high_width = 0;
+  uint32_t total = 0;
+  uint32_t periods = 0;
+  uint32_t count = 0;
+  uint64_t edge = 0;
 
-  RSI_CT_SetControl(CONFIG_TIMER_0_BASE_ADD, ct_config_value);
-  DEBUGOUT("Successfully set configuration for Config Timer\r\n");
+  do {
+    count = capture_ring_pop_batch(&edge_capture_ring, edges, gaps,
+                                   CAPTURE_BATCH_SIZE);
+    periods = 0;
+    for (uint32_t index = 0; index < count; index++) {
+      edge = edges[index] & ~PULSE_RISING_EDGE_TAG;
+      pulse_last_edge = edge;
+      if (gaps[index]) {
+        pulse_rising_edge_valid = false;
+        pulse_falling_edge_valid = false;
+      }
+      if (!(edges[index] & PULSE_RISING_EDGE_TAG)) {
+        pulse_falling_edge = edge;
+        pulse_falling_edge_valid = pulse_rising_edge_valid;
+        continue;
+      }
+      if (pulse_falling_edge_valid) {
+        last_period = calculate_period(pulse_rising_edge, edge);
+        last_high_width = calculate_period(pulse_rising_edge, pulse_falling_edge);
+        period_counts[periods++] = last_period;
+      }
+      pulse_rising_edge = edge;
+      pulse_rising_edge_valid = true;
+      pulse_falling_edge_valid = false;
+    }
+    stream_stats_add_batch(&period_stats, period_counts, periods);
+    total += periods;
+  } while (count == CAPTURE_BATCH_SIZE);
+  if ((total == 0) || (last_period == 0)) {
+    check_pulse_hold();
+    return;
+  }
+  period_measurement_ns =
+    timer_convert_counts_to_ns(&period_convert, last_period);
+  high_width_ns =
+    timer_convert_counts_to_ns(&period_convert, last_high_width);
+  frequency_measurement_millihz =
+    timer_convert_counts_to_millihz(&period_convert, last_period);
+  duty_cycle_ppm =
+    (uint32_t)(((uint64_t)last_high_width * DUTY_CYCLE_FULL_PPM) / last_period);
+  period_count += total;
+}
 
-  RSI_CT_PeripheralReset(CONFIG_TIMER_0_BASE_ADD, (boolean_t)COUNTER_0);
-  RSI_CT_SetCount(CONFIG_TIMER_0_BASE_ADD, 0);
-  DEBUGOUT("Successfully set CT Initial Count\n");
+/***************************************************************************/ /**
+ * Publishes a held input once no edge came for DUTY_CYCLE_HOLD_MS: no period,
+ * and a duty cycle of 0 % or 100 % from the input level. The timer count is
+ * read again if it wrapped while it was extended.
+ ******************************************************************************/
+static void check_pulse_hold(void)
+{
+  uint32_t count = 0;
+  uint64_t now = 0;
 
-  CONFIG_TIMER_0_BASE_ADD->CT_MATCH_REG = TOP_COUNTER_VALUE;
-  DEBUGOUT("Successfully set CT Match Count\n");
+  do {
+    count = capture_timer_get_count();
+    now = capture_timebase_extend_at(&edge_timebase, count, count);
+  } while (capture_timer_get_count() < count);
+  if ((now < pulse_last_edge) || ((now - pulse_last_edge) < pulse_hold_counts)) {
+    return;
+  }
+  period_measurement_ns = 0;
+  high_width_ns = 0;
+  frequency_measurement_millihz = 0;
+  duty_cycle_ppm = RSI_EGPIO_GetPin(EGPIO, CAPTURE_TIMER_INPUT_PORT,
+                                    CAPTURE_TIMER_INPUT_PIN)
+                   ? DUTY_CYCLE_FULL_PPM : 0;
+}
+#endif // CONFIG_TIMER_DUTY_CYCLE_ENABLE
 
-  RSI_CT_InterruptDisable(CONFIG_TIMER_0_BASE_ADD, interrupt_flags);
-  RSI_CT_InterruptEnable(CONFIG_TIMER_0_BASE_ADD, interrupt_flags);
-  NVIC_EnableIRQ(CT_IRQn);
-  DEBUGOUT("Successfully enabled interrupt for Config Timer\r\n");
+#if CONFIG_TIMER_RECIPROCAL_ENABLE
+/***************************************************************************/ /**
+ * Publishes the result of the last gate. The period is the gate duration
+ * divided by the number of periods it holds.
+ ******************************************************************************/
+static void process_frequency_counter(void)
+{
+  frequency_counter_result_t result;
 
-  RSI_CT_InterruptEventSelect(CONFIG_TIMER_0_BASE_ADD, FALLING_EDGE_EVENT);
-  DEBUGOUT("Successfully selected interrupt action event for Config Timer\r\n");
+  if (!frequency_counter_get_result(&result)) {
+    return;
+  }
+  frequency_measurement_millihz = result.frequency_millihz;
+  period_measurement_ns =
+    timer_convert_counts64_to_ns(&period_convert, result.gate_counts)
+    / result.edges;
+  period_count += result.edges;
+}
+#endif // CONFIG_TIMER_RECIPROCAL_ENABLE
 
-  RSI_CT_CaptureEventSelect(CONFIG_TIMER_0_BASE_ADD, FALLING_EDGE_EVENT);
-  DEBUGOUT("Successfully selected capture action event for Config Timer\r\n");
+#if CONFIG_TIMER_QUADRATURE_ENABLE
+/***************************************************************************/ /**
+ * Publishes the encoder position and velocity at the end of each window.
+ ******************************************************************************/
+static void process_quadrature_decoder(void)
+{
+  quadrature_decoder_state_t state;
 
-  RSI_CT_StartSoftwareTrig(CONFIG_TIMER_0_BASE_ADD, COUNTER_0);
-  DEBUGOUT("Successfully started Config Timer\r\n");
+  if (!quadrature_decoder_process()) {
+    return;
+  }
+  quadrature_decoder_get_state(&state);
+  encoder_position = state.position;
+  encoder_velocity_mcps = state.velocity_mcps;
 }
+#endif // CONFIG_TIMER_QUADRATURE_ENABLE
 
-static uint32_t calculate_period(void)
+/***************************************************************************/ /**
+ * Returns the counts between two extended timestamps. The timestamps never
+ * wrap, periods longer than UINT32_MAX counts are saturated.
+ ******************************************************************************/
+static uint32_t calculate_period(uint64_t first_edge, uint64_t second_edge)
 {
-  uint32_t counts_between_edges = 0;
+  uint64_t counts_between_edges = second_edge - first_edge;
 
-  if (edge_capture_buffer[1] < edge_capture_buffer[0]) {
-    counts_between_edges = TOP_COUNTER_VALUE - edge_capture_buffer[0] + 1
-                           + edge_capture_buffer[1];
-  } else {
-    counts_between_edges = edge_capture_buffer[1] - edge_capture_buffer[0];
+  if (counts_between_edges > UINT32_MAX) {
+    counts_between_edges = UINT32_MAX;
   }
-  measurement_ready = false;
 
-  return (counts_between_edges / (CONFIG_TIMER_FREQ / 1000000)); // Period in micro seconds
+  return (uint32_t)counts_between_edges; // Period in timer counts
 }
 
-static void RSI_EGPIO_CLK_init(void)
+#if CAPTURE_EDGES_IN_HANDLER
+/***************************************************************************/ /**
+ * Handles one extended capture, from the IRQ handler.
+ ******************************************************************************/
+static void capture_edge(uint64_t edge)
 {
-  M4CLK->CLK_ENABLE_SET_REG3_b.EGPIO_CLK_ENABLE_b = 1;
-  M4CLK->CLK_ENABLE_SET_REG2_b.EGPIO_PCLK_ENABLE_b = 1;
+#if CONFIG_TIMER_DUTY_CYCLE_ENABLE
+  capture_pulse_edge(edge);
+#else
+  // Every edge is queued, the periods are measured by the main loop.
+  capture_ring_push(&edge_capture_ring, edge);
+#endif
 }
+#endif // CAPTURE_EDGES_IN_HANDLER
 
-void CONFIG_TIMER_IRQHandler(void)
+#if BENCHMARK_ENABLE
+/***************************************************************************/ /**
+ * Measures the hot paths on synthetic edges and prints one JSON line per
+ * benchmark. The capture state is cleared afterwards, the handler must be
+ * held off.
+ ******************************************************************************/
+static void run_benchmarks(void)
 {
-  uint32_t flag = RSI_CT_GetInterruptStatus(CONFIG_TIMER_0_BASE_ADD);
-  RSI_CT_InterruptClear(CONFIG_TIMER_0_BASE_ADD, flag);
-  if (flag & RSI_CT_EVENT_COUNTER_1_IS_PEAK_l) {
-    counter_1_overflow = 1;
+#if MEASURE_EDGE_PERIODS
+  uint32_t capture = 0;
+#endif
+
+  for (uint32_t index = 0; index < CAPTURE_BATCH_SIZE; index++) {
+    benchmark_edges[index] = (uint64_t)index * BENCHMARK_EDGE_STEP;
   }
+  benchmark_init();
+#if MEASURE_EDGE_PERIODS
+  // One edge per call, the ring is full after the last one.
+  capture_ring_init(&edge_capture_ring);
+  benchmark_run("capture_edge",
+                benchmark_capture_edge,
+                &capture,
+                CAPTURE_RING_SIZE,
+                1,
+                BENCHMARK_CAPTURE_MAX_CYCLES);
+#endif
+  benchmark_run("calculate_period",
+                benchmark_calculate_period,
+                NULL,
+                BENCHMARK_BATCHES,
+                CAPTURE_BATCH_SIZE - 1,
+                BENCHMARK_CALCULATE_PERIOD_MAX_CYCLES);
+  // The first edge of each batch is paired with the last one of the
+  // previous batch, every edge gives a period.
+  previous_edge = 0;
+  previous_edge_valid = true;
+  benchmark_run("measure_periods",
+                benchmark_measure_periods,
+                NULL,
+                BENCHMARK_BATCHES,
+                CAPTURE_BATCH_SIZE,
+                BENCHMARK_MEASURE_MAX_CYCLES);
+  benchmark_print_summary();
+  capture_ring_init(&edge_capture_ring);
+  previous_edge_valid = false;
+  stream_stats_reset(&period_stats);
+  period_count = 0;
+}
 
-  if (flag & RSI_CT_EVENT_COUNTER_0_IS_PEAK_l) {
-    if (counter_1_overflow) {
-      CONFIG_TIMER_0_BASE_ADD->CT_COUNTER_REG = 0;
-      counter_1_overflow = 0;
-    }
+#if MEASURE_EDGE_PERIODS
+/***************************************************************************/ /**
+ * Benchmark of the capture path of the IRQ handler, the register accesses
+ * of capture_timer_service() excluded. The context is the next capture value.
+ ******************************************************************************/
+static void benchmark_capture_edge(void *context)
+{
+  uint32_t *capture = context;
+
+  capture_edge(capture_timebase_extend(&edge_timebase, *capture, false));
+  *capture += BENCHMARK_EDGE_STEP;
+}
+#endif
+
+/***************************************************************************/ /**
+ * Benchmark of calculate_period over the pairs of one batch of edges.
+ ******************************************************************************/
+static void benchmark_calculate_period(void *context)
+{
+  uint32_t sum = 0;
+
+  (void)context;
+  for (uint32_t index = 1; index < CAPTURE_BATCH_SIZE; index++) {
+    sum += calculate_period(benchmark_edges[index - 1],
+                            benchmark_edges[index]);
   }
+  benchmark_period_sum = sum;
+}
 
-  if (flag == RSI_CT_EVENT_INTR_0_l) {
-    edge_capture_buffer[edge_capture_index++] =
-      CONFIG_TIMER_0_BASE_ADD->CT_CAPTURE_REG;
-    if (edge_capture_index >= EDGE_CAPTURE_BUFFER_SIZE) {
-      edge_capture_index = 0;
-      measurement_ready = true;
-    }
+/***************************************************************************/ /**
+ * Benchmark of measure_periods on one batch of edges, statistics and
+ * conversions included.
+ ******************************************************************************/
+static void benchmark_measure_periods(void *context)
+{
+  (void)context;
+  measure_periods(benchmark_edges, NULL, CAPTURE_BATCH_SIZE);
+}
+#endif // BENCHMARK_ENABLE
+
+void CAPTURE_TIMER_IRQHandler(void)
+{
+  ISR_TRACE_ENTER(CONFIG_TIMER_ISR_TRACE_ID);
+#if ISR_TRACE_ENABLE
+#if CAPTURE_EDGES_IN_HANDLER
+  uint32_t entry_count = capture_timer_get_count();
+#endif
+  uint32_t latency = ISR_TRACE_NO_LATENCY;
+#endif
+#if CONFIG_TIMER_RECIPROCAL_ENABLE
+  uint32_t flag = RSI_CT_GetInterruptStatus(CAPTURE_TIMER_BASE);
+  RSI_CT_InterruptClear(CAPTURE_TIMER_BASE, flag);
+  frequency_counter_irq_handler(flag);
+#elif CONFIG_TIMER_QUADRATURE_ENABLE
+  quadrature_decoder_irq_handler();
+#else
+  uint64_t edge = 0;
+
+  if (capture_timer_service(&edge_timebase, &edge)
+      & CAPTURE_TIMER_CAPTURE_EVENT) {
+    capture_edge(edge);
+#if ISR_TRACE_ENABLE
+    // The low bits of the timestamp hold the count at the edge, the latency
+    // is the count elapsed until entry.
+    latency = isr_trace_timer_to_cycles((entry_count - (uint32_t)edge)
+                                        & CAPTURE_TIMER_COUNTER_MASK);
+#endif
   }
+#endif
+  ISR_TRACE_EXIT(CONFIG_TIMER_ISR_TRACE_ID, latency);
 }
@@ -0,0 +1,337 @@
+/***************************************************************************//**
+ * @file frequency_counter.c
+ * @brief Reciprocal frequency counter on the config timer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#include "frequency_counter.h"
+#include "capture_timebase.h"
+#include "capture_timer.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define FREQUENCY_COUNTER_BASE_ADD    CAPTURE_TIMER_BASE
+#define FREQUENCY_COUNTER_GATE_US     10000  // Target gate time, sets the resolution and the interrupt rate
+#define FREQUENCY_COUNTER_MAX_EDGES   0xFF00 // Largest number of edges per gate
+#define FREQUENCY_COUNTER_RACE_EDGES  4      // Most edges between reading counter 1 and setting its match
+#define COUNTER_1_SHIFT               16     // Counter 1 fields are the upper halves
+#define COUNTER_16BIT_MASK            0xFFFF
+#define COUNTER_16BIT_BITS            16
+#define MICROSECONDS_PER_SECOND       1000000ULL
+#define MILLIHERTZ_PER_HERTZ          1000ULL
+#define PPB_PER_UNIT                  1000000000ULL
+
+/*******************************************************************************
+ **********************  Local variables   *************************************
+ ******************************************************************************/
+static uint32_t timer_frequency = 0;
+static uint64_t gate_target_counts = 0;
+// Counter 0 wraps, extending the 16-bit timebase
+static capture_timebase_t timebase;
+// Counter 1 match of the running gate
+static uint32_t gate_match = 0;
+// Edges of the running gate, 0 until the first gate is started
+static uint32_t gate_edges = 0;
+// Absolute number of the edge which ends the running gate
+static uint64_t gate_edge = 0;
+// Edge number and timestamp of the previous gate reference
+static uint64_t reference_edge = 0;
+static uint64_t reference_timestamp = 0;
+static bool reference_valid = false;
+// Last gate, written by the IRQ handler under an odd sequence number
+static volatile uint32_t result_sequence = 0;
+static volatile uint32_t result_edges = 0;
+static volatile uint64_t result_counts = 0;
+static uint32_t result_read_sequence = 0;
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static uint64_t read_reference(uint32_t *position);
+static void start_first_gate(void);
+static uint32_t size_next_gate(uint32_t edges, uint64_t counts);
+static void set_gate_edges(uint32_t edges, uint32_t position);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Configures CT0 in 16-bit mode. Counter 0 counts the timer clock and wraps at
+ * 0xFFFF, the capture of counter 0 is done on every falling edge. Counter 1
+ * is incremented by the falling edges, its peak ends the gate. Counter 1 runs
+ * free until the first gate is started.
+ ******************************************************************************/
+void frequency_counter_init(void)
+{
+  uint32_t ct_config_value = 0;
+  uint32_t interrupt_flags = 0;
+
+  capture_timer_clock_init();
+  timer_frequency = CAPTURE_TIMER_FREQUENCY;
+  gate_target_counts = ((uint64_t)timer_frequency * FREQUENCY_COUNTER_GATE_US)
+                       / MICROSECONDS_PER_SECOND;
+
+  ct_config_value = PERIODIC_ENCOUNTER_0 | COUNTER0_UP
+                    | PERIODIC_ENCOUNTER_1 | COUNTER1_UP;
+  interrupt_flags = RSI_CT_EVENT_COUNTER_0_IS_PEAK_l
+                    | RSI_CT_EVENT_COUNTER_1_IS_PEAK_l;
+
+  capture_timebase_init(&timebase, COUNTER_16BIT_BITS);
+  gate_edges = 0;
+  reference_valid = false;
+  result_read_sequence = result_sequence;
+  RSI_CT_SetControl(FREQUENCY_COUNTER_BASE_ADD, ct_config_value);
+  RSI_CT_PeripheralReset(FREQUENCY_COUNTER_BASE_ADD, (boolean_t)COUNTER_0);
+  RSI_CT_PeripheralReset(FREQUENCY_COUNTER_BASE_ADD, (boolean_t)COUNTER_1);
+  RSI_CT_SetCount(FREQUENCY_COUNTER_BASE_ADD, 0);
+
+  gate_match = COUNTER_16BIT_MASK;
+  FREQUENCY_COUNTER_BASE_ADD->CT_MATCH_REG = (gate_match << COUNTER_1_SHIFT)
+                                             | COUNTER_16BIT_MASK;
+
+  RSI_CT_InterruptDisable(FREQUENCY_COUNTER_BASE_ADD, interrupt_flags);
+  RSI_CT_InterruptEnable(FREQUENCY_COUNTER_BASE_ADD, interrupt_flags);
+  NVIC_EnableIRQ(CAPTURE_TIMER_IRQn);
+
+  RSI_CT_CaptureEventSelect(FREQUENCY_COUNTER_BASE_ADD, CAPTURE_TIMER_FALLING_EDGE);
+  RSI_CT_IncrementEventSelect(FREQUENCY_COUNTER_BASE_ADD,
+                              CAPTURE_TIMER_FALLING_EDGE << COUNTER_1_SHIFT);
+
+  RSI_CT_StartSoftwareTrig(FREQUENCY_COUNTER_BASE_ADD, COUNTER_0);
+  RSI_CT_StartSoftwareTrig(FREQUENCY_COUNTER_BASE_ADD, COUNTER_1);
+}
+
+/*******************************************************************************
+ * Gate handling, once per gate and once per timebase wrap. At the end of a
+ * gate, the number of edges and the timer counts since the previous gate are
+ * published, and the next gate is sized to last about FREQUENCY_COUNTER_GATE_US
+ * with a 32-bit division.
+ ******************************************************************************/
+void frequency_counter_irq_handler(uint32_t flags)
+{
+  uint32_t position = 0;
+  uint64_t timestamp = 0;
+  uint64_t edge = 0;
+  uint64_t counts = 0;
+  uint32_t edges = 0;
+
+  if (flags & RSI_CT_EVENT_COUNTER_0_IS_PEAK_l) {
+    capture_timebase_wrap(&timebase);
+    if (gate_edges == 0) {
+      start_first_gate();
+      return;
+    }
+  }
+  if (!(flags & RSI_CT_EVENT_COUNTER_1_IS_PEAK_l) || (gate_edges == 0)) {
+    return;
+  }
+  // The captured edge is the gate edge, or a later one if more edges came
+  // before the handler ran. Counter 1 stays on its match until the next edge,
+  // which restarts it from 0, so the number of the captured edge is known.
+  timestamp = read_reference(&position);
+  edge = gate_edge + ((position == gate_match) ? 0 : (position + 1));
+  if (reference_valid && (timestamp > reference_timestamp)) {
+    edges = (uint32_t)(edge - reference_edge);
+    counts = timestamp - reference_timestamp;
+    result_sequence++;
+    result_edges = edges;
+    result_counts = counts;
+    result_sequence++;
+    set_gate_edges(size_next_gate(edges, counts), position);
+  } else {
+    set_gate_edges(gate_edges, position);
+  }
+  reference_edge = edge;
+  reference_timestamp = timestamp;
+  reference_valid = true;
+}
+
+/*******************************************************************************
+ * Returns the last gate result. The 64-bit frequency division is done here,
+ * out of the IRQ handler.
+ ******************************************************************************/
+bool frequency_counter_get_result(frequency_counter_result_t *result)
+{
+  uint32_t sequence = 0;
+  uint32_t edges = 0;
+  uint64_t counts = 0;
+
+  do {
+    sequence = result_sequence;
+    edges = result_edges;
+    counts = result_counts;
+  } while ((sequence & 1) || (sequence != result_sequence));
+  if ((sequence == result_read_sequence) || (counts == 0)) {
+    return false;
+  }
+  result_read_sequence = sequence;
+  result->edges = edges;
+  result->gate_counts = counts;
+  result->frequency_millihz = (((uint64_t)edges * timer_frequency
+                            * MILLIHERTZ_PER_HERTZ) + (counts / 2)) / counts;
+  result->resolution_ppb = (uint32_t)(PPB_PER_UNIT / counts);
+  return true;
+}
+
+/*******************************************************************************
+ * Reads the last capture as a 64-bit timestamp, with the value of counter 1
+ * at the captured edge. The counters are read again until no edge and no wrap
+ * happened during the read, a pending wrap is counted here.
+ ******************************************************************************/
+static uint64_t read_reference(uint32_t *position)
+{
+  uint32_t before = 0;
+  uint32_t after = 0;
+  uint32_t capture = 0;
+
+  do {
+    before = FREQUENCY_COUNTER_BASE_ADD->CT_COUNTER_REG;
+    capture = FREQUENCY_COUNTER_BASE_ADD->CT_CAPTURE_REG & COUNTER_16BIT_MASK;
+    if (RSI_CT_GetInterruptStatus(FREQUENCY_COUNTER_BASE_ADD)
+        & RSI_CT_EVENT_COUNTER_0_IS_PEAK_l) {
+      RSI_CT_InterruptClear(FREQUENCY_COUNTER_BASE_ADD,
+                            RSI_CT_EVENT_COUNTER_0_IS_PEAK_l);
+      capture_timebase_wrap(&timebase);
+    }
+    after = FREQUENCY_COUNTER_BASE_ADD->CT_COUNTER_REG;
+  } while (((after >> COUNTER_1_SHIFT) != (before >> COUNTER_1_SHIFT))
+           || ((after & COUNTER_16BIT_MASK) < (before & COUNTER_16BIT_MASK)));
+
+  *position = after >> COUNTER_1_SHIFT;
+
+  // The wraps up to the counter value read last are counted.
+  return capture_timebase_extend_at(&timebase,
+                                    capture,
+                                    after & COUNTER_16BIT_MASK);
+}
+
+/*******************************************************************************
+ * Function to start the first gate, on a timebase wrap once an edge was
+ * counted. The free running counter 1 gives the edge number and the edge rate
+ * since the timer started, which sizes the first gate.
+ *
+ * @param[in] none
+ * @return none
+ ******************************************************************************/
+static void start_first_gate(void)
+{
+  uint32_t position = FREQUENCY_COUNTER_BASE_ADD->CT_COUNTER_REG >> COUNTER_1_SHIFT;
+
+  if (position == 0) {
+    return;
+  }
+  // Counter 1 goes on from its position as from the match of a gate.
+  gate_match = position;
+  gate_edge = position;
+  set_gate_edges(size_next_gate(position, (uint64_t)timebase.epoch << COUNTER_16BIT_BITS),
+                 position);
+}
+
+/*******************************************************************************
+ * Function to compute the edges needed for the target gate time, at the
+ * frequency measured over the last gate. Both terms of the ratio are shifted
+ * down until they fit in 32 bits: the core divides those in a few cycles,
+ * while a 64-bit division is a library call of a few hundred. The dropped
+ * low bits change the gate length much less than the rounding down to whole
+ * edges, and the result of a gate is exact whatever its length.
+ *
+ * @param[in] edges (uint32_t) Edges of the last gate.
+ * @param[in] counts (uint64_t) Timer counts of the last gate, not 0.
+ * @return edges of the next gate, clamped by set_gate_edges()
+ ******************************************************************************/
+static uint32_t size_next_gate(uint32_t edges, uint64_t counts)
+{
+  uint64_t scaled_edges = (uint64_t)edges * gate_target_counts;
+  uint32_t high = (uint32_t)((scaled_edges | counts) >> 32);
+  uint32_t shift = (high != 0) ? (32 - __CLZ(high)) : 0;
+  uint32_t divisor = (uint32_t)(counts >> shift);
+
+  if (divisor == 0) {
+    return FREQUENCY_COUNTER_MAX_EDGES;
+  }
+  return (uint32_t)(scaled_edges >> shift) / divisor;
+}
+
+/*******************************************************************************
+ * Function to set the number of edges of the next gate, counted from the gate
+ * edge. Counter 1 compares its value with the match at each edge: an edge
+ * seen on the match restarts it from 0, so a new match written before the
+ * next edge lets it go on counting from the old one. An edge coming between
+ * the read of counter 1 and the write of the match restarts it against the
+ * old match; counter 1 is read back and the match is set again from there.
+ * Matches close to 0 are skipped, so that a restart is never mistaken for
+ * the counter going on.
+ *
+ * @param[in] edges (uint32_t) Edges of the next gate.
+ * @param[in] position (uint32_t) Counter 1 value, read since the gate edge.
+ * @return none
+ ******************************************************************************/
+static void set_gate_edges(uint32_t edges, uint32_t position)
+{
+  uint32_t match = 0;
+  uint32_t check = 0;
+
+  if (edges < 1) {
+    edges = 1;
+  } else if (edges > FREQUENCY_COUNTER_MAX_EDGES) {
+    edges = FREQUENCY_COUNTER_MAX_EDGES;
+  }
+  for (;;) {
+    if (position == gate_match) {
+      // No edge since the gate edge, counter 1 goes on from the match.
+      match = (gate_match + edges) & COUNTER_16BIT_MASK;
+      if ((match <= FREQUENCY_COUNTER_RACE_EDGES)
+          || (match >= COUNTER_16BIT_MASK - FREQUENCY_COUNTER_RACE_EDGES)) {
+        edges += (FREQUENCY_COUNTER_RACE_EDGES + 1 - match) & COUNTER_16BIT_MASK;
+        match = FREQUENCY_COUNTER_RACE_EDGES + 1;
+      }
+    } else {
+      // Counter 1 restarted on the first edge after the gate edge, the gate
+      // ends after the edges already counted.
+      if (edges < position + FREQUENCY_COUNTER_RACE_EDGES + 2) {
+        edges = position + FREQUENCY_COUNTER_RACE_EDGES + 2;
+      }
+      match = edges - 1;
+    }
+    FREQUENCY_COUNTER_BASE_ADD->CT_MATCH_REG = (match << COUNTER_1_SHIFT)
+                                               | COUNTER_16BIT_MASK;
+    check = FREQUENCY_COUNTER_BASE_ADD->CT_COUNTER_REG >> COUNTER_1_SHIFT;
+    if ((position != gate_match)
+        || (((check - position) & COUNTER_16BIT_MASK) <= FREQUENCY_COUNTER_RACE_EDGES)) {
+      break;
+    }
+    position = check;
+  }
+  gate_match = match;
+  gate_edges = edges;
+  gate_edge += edges;
+}
@@ -0,0 +1,424 @@
+/***************************************************************************//**
+ * @file quadrature_decoder.c
+ * @brief Quadrature encoder decoding on the config timer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ ********************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided \'as-is\', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Experimental Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+#include "quadrature_decoder.h"
+#include "capture_ring.h"
+#include "capture_timebase.h"
+#include "capture_timer.h"
+#include "cycle_counter.h"
+#include "multi_capture.h"
+#include "rsi_rom_egpio.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define QUADRATURE_WINDOW_US          1000   // Velocity window, the mode is checked once per window
+#define QUADRATURE_STOP_US            200000 // Velocity is 0 after this time without edge
+#define QUADRATURE_COUNT_ENTER_CPS    100000 // Speed switching to the count mode, in counts per second
+#define QUADRATURE_COUNT_EXIT_CPS     50000  // Speed switching back to the capture mode, in counts per second
+#define QUADRATURE_BATCH_SIZE         16     // Edges taken from the ring at once
+#define CHANNEL_A                     0      // Capture channel of SCT_IN_0
+#define CHANNEL_B                     1      // Capture channel of SCT_IN_1
+#define CHANNEL_EVENTS                (RSI_CT_EVENT_INTR_0_l | RSI_CT_EVENT_INTR_1_l)
+#define WRAP_EVENT                    RSI_CT_EVENT_COUNTER_0_IS_PEAK_l
+#define COUNTER_1_SHIFT               16     // Counter 1 fields are the upper halves
+#define COUNTER_16BIT_MASK            0xFFFF
+#define COUNTS_PER_A_EDGE             2      // Counts between two edges of A, one edge of B in between
+#define MILLICOUNTS_PER_COUNT         1000LL
+#define PHASE_MASK                    0x3    // Four counts per line
+
+/*******************************************************************************
+ **********************  Local variables   *************************************
+ ******************************************************************************/
+// Counter 0 wraps, extending the timebase shared by the channels
+static capture_timebase_t timebase;
+static capture_ring_t edge_ring;
+static uint64_t edge_batch[QUADRATURE_BATCH_SIZE];
+static bool gap_batch[QUADRATURE_BATCH_SIZE];
+// Read by the IRQ handler, only written with the handler held off
+static volatile quadrature_decoder_mode_t mode = QUADRATURE_DECODER_CAPTURE;
+static uint32_t timer_frequency = 0;
+// Levels of A and B after the last decoded edge
+static uint8_t level_a = 0;
+static uint8_t level_b = 0;
+// Edges found missing from the level of the next edge of their channel
+static uint32_t missing_edges = 0;
+// Phase of the levels at position 0, a phase counts 0 to 3 forward
+static uint8_t phase_offset = 0;
+static int64_t position = 0;
+static int64_t velocity_mcps = 0;
+// Sign of the last decoded count, the direction of the count mode
+static int8_t direction = 1;
+// Last decoded edge, and the last edge of the previous window with edges
+static int64_t edge_position = 0;
+static uint64_t edge_timestamp = 0;
+static uint32_t window_edges = 0;
+static int64_t reference_position = 0;
+static uint64_t reference_timestamp = 0;
+static bool reference_valid = false;
+static cycle_counter_timeout_t window_timeout;
+static uint32_t window_start_cycles = 0;
+static uint32_t last_edge_cycles = 0;
+static uint32_t stop_cycles = 0;
+// Counter 1 value at the start of the count mode window
+static uint32_t previous_a_edges = 0;
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static void read_levels(void);
+static uint8_t get_phase(void);
+static void decode_edges(void);
+static void decode_edge(uint64_t event);
+static void update_capture_velocity(uint32_t now_cycles);
+static void update_count_velocity(uint32_t now_cycles);
+static void enter_count_mode(uint32_t now_cycles);
+static void enter_capture_mode(uint32_t now_cycles);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Starts the decoder in capture mode. The levels of A and B are read once,
+ * each edge then gives the level of its channel.
+ ******************************************************************************/
+void quadrature_decoder_init(void)
+{
+  cycle_counter_init();
+  capture_ring_init(&edge_ring);
+  mode = QUADRATURE_DECODER_CAPTURE;
+  multi_capture_init(&timebase,
+                     CAPTURE_TIMER_INPUT_BOTH_EDGES(0),
+                     CAPTURE_TIMER_INPUT_BOTH_EDGES(1));
+  timer_frequency = CAPTURE_TIMER_FREQUENCY;
+  stop_cycles = cycle_counter_us_to_cycles(QUADRATURE_STOP_US);
+  read_levels();
+  phase_offset = get_phase();
+  window_start_cycles = cycle_counter_get();
+  last_edge_cycles = window_start_cycles;
+  cycle_counter_timeout_start(&window_timeout, QUADRATURE_WINDOW_US);
+}
+
+/*******************************************************************************
+ * In capture mode, the edges are queued in time order. In count mode, the
+ * capture interrupts are disabled and only the wraps are counted.
+ ******************************************************************************/
+void quadrature_decoder_irq_handler(void)
+{
+  uint32_t events = 0;
+
+  if (mode == QUADRATURE_DECODER_CAPTURE) {
+    multi_capture_service(&timebase, &edge_ring);
+    return;
+  }
+  events = RSI_CT_GetInterruptStatus(CAPTURE_TIMER_BASE);
+  RSI_CT_InterruptClear(CAPTURE_TIMER_BASE, events);
+  if (events & WRAP_EVENT) {
+    capture_timebase_wrap(&timebase);
+  }
+}
+
+/*******************************************************************************
+ * Decodes the queued edges, then updates the velocity at the end of each
+ * window. The mode changes with hysteresis, so a speed near a threshold does
+ * not switch the mode every window.
+ ******************************************************************************/
+bool quadrature_decoder_process(void)
+{
+  uint32_t now_cycles = 0;
+  int64_t speed_cps = 0;
+
+  if (mode == QUADRATURE_DECODER_CAPTURE) {
+    decode_edges();
+  }
+  if (!cycle_counter_timeout_expired(&window_timeout)) {
+    return false;
+  }
+  cycle_counter_timeout_start(&window_timeout, QUADRATURE_WINDOW_US);
+  now_cycles = cycle_counter_get();
+  if (mode == QUADRATURE_DECODER_CAPTURE) {
+    update_capture_velocity(now_cycles);
+  } else {
+    update_count_velocity(now_cycles);
+  }
+  window_start_cycles = now_cycles;
+
+  speed_cps = velocity_mcps / MILLICOUNTS_PER_COUNT;
+  if (speed_cps < 0) {
+    speed_cps = -speed_cps;
+  }
+  if ((mode == QUADRATURE_DECODER_CAPTURE)
+      && (speed_cps >= QUADRATURE_COUNT_ENTER_CPS)) {
+    enter_count_mode(now_cycles);
+  } else if ((mode == QUADRATURE_DECODER_COUNT)
+             && (speed_cps < QUADRATURE_COUNT_EXIT_CPS)) {
+    enter_capture_mode(now_cycles);
+  }
+  return true;
+}
+
+/*******************************************************************************
+ * Returns the decoder state.
+ ******************************************************************************/
+void quadrature_decoder_get_state(quadrature_decoder_state_t *state)
+{
+  state->position = position;
+  state->velocity_mcps = velocity_mcps;
+  state->mode = mode;
+  state->lost_edges = capture_ring_get_overruns(&edge_ring) + missing_edges;
+}
+
+/*******************************************************************************
+ * Function to read the levels of A and B from their pins.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void read_levels(void)
+{
+  level_a = RSI_EGPIO_GetPin(EGPIO, RTE_SCT_IN_0_PORT, RTE_SCT_IN_0_PIN);
+  level_b = RSI_EGPIO_GetPin(EGPIO, RTE_SCT_IN_1_PORT, RTE_SCT_IN_1_PIN);
+}
+
+/*******************************************************************************
+ * Function to return the phase of the levels. Forward, A and B go through
+ * 00, 01, 11 and 10, one phase per count.
+ *
+ * @param none
+ * @return phase, 0 to 3
+ ******************************************************************************/
+static uint8_t get_phase(void)
+{
+  return (uint8_t)((level_a << 1) | (level_a ^ level_b));
+}
+
+/*******************************************************************************
+ * Function to drain the edge ring. An edge following dropped ones only gives
+ * the level of its channel and the velocity reference starts over, the
+ * dropped edges are lost from the position.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void decode_edges(void)
+{
+  uint64_t event = 0;
+  uint32_t count = 0;
+
+  do {
+    count = capture_ring_pop_batch(&edge_ring,
+                                   edge_batch,
+                                   gap_batch,
+                                   QUADRATURE_BATCH_SIZE);
+    for (uint32_t index = 0; index < count; index++) {
+      event = edge_batch[index];
+      if (gap_batch[index]) {
+        if (multi_capture_get_channel(event) == CHANNEL_B) {
+          level_b = multi_capture_get_level(event);
+        } else {
+          level_a = multi_capture_get_level(event);
+        }
+        phase_offset = (uint8_t)(get_phase() - (uint32_t)position) & PHASE_MASK;
+        reference_valid = false;
+        continue;
+      }
+      decode_edge(event);
+    }
+  } while (count == QUADRATURE_BATCH_SIZE);
+}
+
+/*******************************************************************************
+ * Function to decode one edge. An edge of B while A and B are equal, or an
+ * edge of A while they differ, is a count forward, any other edge a count
+ * backward. The level after the edge comes with it: an edge leaving its
+ * channel at the same level follows an odd number of missing edges of that
+ * channel, such as a capture overwritten before the handler ran. It is not
+ * counted and the velocity reference starts over, the levels stay right.
+ *
+ * @param[in] event (uint64_t) Event taken from the ring.
+ * @return none
+ ******************************************************************************/
+static void decode_edge(uint64_t event)
+{
+  uint8_t level = multi_capture_get_level(event);
+  int8_t delta = 0;
+
+  if (multi_capture_get_channel(event) == CHANNEL_B) {
+    if (level == level_b) {
+      missing_edges++;
+      reference_valid = false;
+      return;
+    }
+    delta = (level_a != level) ? 1 : -1;
+    level_b = level;
+  } else {
+    if (level == level_a) {
+      missing_edges++;
+      reference_valid = false;
+      return;
+    }
+    delta = (level == level_b) ? 1 : -1;
+    level_a = level;
+  }
+  position += delta;
+  direction = delta;
+  edge_position = position;
+  edge_timestamp = multi_capture_get_timestamp(event);
+  window_edges++;
+}
+
+/*******************************************************************************
+ * Function to update the velocity in capture mode. The counts are divided by
+ * the exact time between the last edge of this window and the last edge of
+ * the previous window with edges, so one count is enough at low speed. In a
+ * window without edges, the speed cannot be more than one count since the
+ * last edge, and the velocity decays to that bound.
+ *
+ * @param[in] now_cycles (uint32_t) Cycle count at the end of the window.
+ * @return none
+ ******************************************************************************/
+static void update_capture_velocity(uint32_t now_cycles)
+{
+  uint32_t idle_cycles = 0;
+  int64_t bound_mcps = 0;
+
+  if (window_edges > 0) {
+    if (reference_valid && (edge_timestamp > reference_timestamp)) {
+      velocity_mcps = ((edge_position - reference_position)
+                       * (int64_t)timer_frequency * MILLICOUNTS_PER_COUNT)
+                      / (int64_t)(edge_timestamp - reference_timestamp);
+    }
+    reference_position = edge_position;
+    reference_timestamp = edge_timestamp;
+    reference_valid = true;
+    window_edges = 0;
+    last_edge_cycles = now_cycles;
+    return;
+  }
+  idle_cycles = now_cycles - last_edge_cycles;
+  if (idle_cycles >= stop_cycles) {
+    velocity_mcps = 0;
+    return;
+  }
+  bound_mcps = ((int64_t)cycle_counter_get_frequency() * MILLICOUNTS_PER_COUNT)
+               / idle_cycles;
+  if (velocity_mcps > bound_mcps) {
+    velocity_mcps = bound_mcps;
+  } else if (velocity_mcps < -bound_mcps) {
+    velocity_mcps = -bound_mcps;
+  }
+}
+
+/*******************************************************************************
+ * Function to update the position and the velocity in count mode, from the
+ * edges of A counted by counter 1 over the window. The direction cannot
+ * change at this speed, it is the one decoded before the count mode.
+ *
+ * @param[in] now_cycles (uint32_t) Cycle count at the end of the window.
+ * @return none
+ ******************************************************************************/
+static void update_count_velocity(uint32_t now_cycles)
+{
+  uint32_t a_edges = CAPTURE_TIMER_BASE->CT_COUNTER_REG >> COUNTER_1_SHIFT;
+  int64_t counts = (int64_t)((a_edges - previous_a_edges) & COUNTER_16BIT_MASK)
+                   * COUNTS_PER_A_EDGE * direction;
+
+  previous_a_edges = a_edges;
+  position += counts;
+  velocity_mcps = (counts * (int64_t)cycle_counter_get_frequency()
+                   * MILLICOUNTS_PER_COUNT)
+                  / (int64_t)(now_cycles - window_start_cycles);
+}
+
+/*******************************************************************************
+ * Function to switch to the count mode. The capture interrupts are disabled
+ * and the queued edges decoded, then counter 1 counts both edges of A instead
+ * of the timer clock. The handler only counts the wraps from here.
+ *
+ * @param[in] now_cycles (uint32_t) Cycle count at the start of the window.
+ * @return none
+ ******************************************************************************/
+static void enter_count_mode(uint32_t now_cycles)
+{
+  NVIC_DisableIRQ(CAPTURE_TIMER_IRQn);
+  RSI_CT_InterruptDisable(CAPTURE_TIMER_BASE, CHANNEL_EVENTS);
+  // The captures already taken are queued before the mode changes.
+  multi_capture_service(&timebase, &edge_ring);
+  mode = QUADRATURE_DECODER_COUNT;
+  NVIC_EnableIRQ(CAPTURE_TIMER_IRQn);
+  decode_edges();
+
+  RSI_CT_IncrementEventSelect(CAPTURE_TIMER_BASE,
+                              CAPTURE_TIMER_INPUT_BOTH_EDGES(0)
+                              << COUNTER_1_SHIFT);
+  previous_a_edges = CAPTURE_TIMER_BASE->CT_COUNTER_REG >> COUNTER_1_SHIFT;
+  window_start_cycles = now_cycles;
+}
+
+/*******************************************************************************
+ * Function to switch back to the capture mode. Counter 1 counts the timer
+ * clock again and is resynchronized with counter 0, the levels are read from
+ * the pins and the velocity reference starts over with the next edge. The
+ * count mode counts two per edge of A, an edge of B alone is missed or
+ * counted early, the phase of the levels corrects the position.
+ *
+ * @param[in] now_cycles (uint32_t) Cycle count at the start of the window.
+ * @return none
+ ******************************************************************************/
+static void enter_capture_mode(uint32_t now_cycles)
+{
+  uint8_t phase_error = 0;
+
+  NVIC_DisableIRQ(CAPTURE_TIMER_IRQn);
+  RSI_CT_IncrementEventSelect(CAPTURE_TIMER_BASE, 0);
+  multi_capture_resync();
+  read_levels();
+  phase_error = (uint8_t)(get_phase() - phase_offset - (uint32_t)position)
+                & PHASE_MASK;
+  if (phase_error == 1) {
+    position++;
+  } else if (phase_error == 2) {
+    position += 2 * direction;
+  } else if (phase_error == 3) {
+    position--;
+  }
+  reference_valid = false;
+  window_edges = 0;
+  last_edge_cycles = now_cycles;
+  // Captures taken while counting are stale.
+  RSI_CT_InterruptClear(CAPTURE_TIMER_BASE, CHANNEL_EVENTS);
+  RSI_CT_InterruptEnable(CAPTURE_TIMER_BASE, CHANNEL_EVENTS);
+  mode = QUADRATURE_DECODER_CAPTURE;
+  NVIC_EnableIRQ(CAPTURE_TIMER_IRQn);
+}
@@ -17,116 +17,159 @@
  ******************************************************************************/
 #include "app.h"
 
-#include "rsi_rom_egpio.h"
-#include "rsi_rom_clks.h"
-#include "rsi_egpio.h"
-#include "rsi_ct.h"
 #include "rsi_debug.h"
+#include "isr_trace.h"
+#include "capture_timer.h"
+#include "capture_timebase.h"
+#include "capture_ring.h"
+#include "multi_capture.h"
+#include "capture_export.h"
+#include "cycle_counter.h"
+#include "deferred_log.h"
 
 /*******************************************************************************
  ***************************  Defines / Macros  ********************************
  ******************************************************************************/
-#define CONFIG_TIMER_INPUT_GPIO_PORT  RTE_SCT_IN_0_PORT
-#define CONFIG_TIMER_INPUT_GPIO_PIN   RTE_SCT_IN_0_PIN
-#define CONFIG_TIMER_INPUT_GPIO_PAD   RTE_SCT_IN_0_PAD
-#define CONFIG_TIMER_0_BASE_ADD       CT0
-#define CONFIG_TIMER_IRQHandler       IRQ034_Handler
-#define FALLING_EDGE_EVENT            0x05
-#define EDGE_CAPTURE_BUFFER_SIZE      2
-#define TOP_COUNTER_VALUE             0xFFFFFFFF
+#define CAPTURE_BATCH_SIZE            16   // Captures taken from the ring at once
+#define CONFIG_TIMER_ISR_TRACE_ID     0    // Handler identifier when ISR_TRACE_ENABLE is set
+#define CONFIG_TIMER_TRACE_REPORT_RUNS 1000 // Handler runs between two trace reports
+
+#ifndef CONFIG_TIMER_EXPORT_ENABLE
+#define CONFIG_TIMER_EXPORT_ENABLE    0    // Set to 1 to send the captures as binary frames instead of text
+#endif
+#define EXPORT_FLUSH_US               10000 // Longest time a capture waits in a frame being built
+#define EXPORT_TX_CHUNK               64   // Bytes written on the debug UART per loop iteration
+
+#ifndef CONFIG_TIMER_MULTI_CHANNEL_ENABLE
+#define CONFIG_TIMER_MULTI_CHANNEL_ENABLE 0 // Set to 1 to capture SCT_IN_0 and SCT_IN_1 on one channel-tagged stream
+#endif
+
+#if CONFIG_TIMER_MULTI_CHANNEL_ENABLE && CONFIG_TIMER_EXPORT_ENABLE
+#error "The export frames carry no channel, it cannot be combined with the multi-channel mode"
+#endif
+
+#if DEFERRED_LOG_ENABLE && !CONFIG_TIMER_EXPORT_ENABLE
+// The captures are taken at the rate the log prints them, a capture and its
+// gap message per capture, so a burst is dropped and counted by the capture
+// ring where the gap is, not by the log.
+#define CAPTURE_POP_SIZE              (DEFERRED_LOG_PROCESS_MAX / 2)
+#else
+#define CAPTURE_POP_SIZE              CAPTURE_BATCH_SIZE
+#endif
 
 /*******************************************************************************
  **********************  Local variables   *************************************
  ******************************************************************************/
-static volatile uint16_t flag;
-static volatile uint16_t capture_value;
-static volatile uint8_t data_ready;
+static capture_timebase_t capture_timebase;
+static capture_ring_t capture_ring;
+#if CONFIG_TIMER_EXPORT_ENABLE
+static capture_export_t capture_export;
+static cycle_counter_timeout_t export_flush_timeout;
+static uint32_t exported_overruns = 0;
+#endif
 
 /*******************************************************************************
  **********************  Local Function prototypes   ***************************
  ******************************************************************************/
-void CONFIG_TIMER_IRQHandler(void)
+void CAPTURE_TIMER_IRQHandler(void)
 {
-  uint32_t flag = RSI_CT_GetInterruptStatus(CONFIG_TIMER_0_BASE_ADD);
-  RSI_CT_InterruptClear(CONFIG_TIMER_0_BASE_ADD, flag);
-  if (flag == RSI_CT_EVENT_INTR_0_l) {
-    capture_value = CONFIG_TIMER_0_BASE_ADD->CT_CAPTURE_REG;
-    data_ready = 1;
+  ISR_TRACE_ENTER(CONFIG_TIMER_ISR_TRACE_ID);
+#if CONFIG_TIMER_MULTI_CHANNEL_ENABLE
+  // The captures of all the channels are handled in one run, the latency of
+  // each edge is not measured.
+  multi_capture_service(&capture_timebase, &capture_ring);
+  ISR_TRACE_EXIT(CONFIG_TIMER_ISR_TRACE_ID, ISR_TRACE_NO_LATENCY);
+#else
+#if ISR_TRACE_ENABLE
+  uint32_t entry_count = capture_timer_get_count();
+  uint32_t latency = ISR_TRACE_NO_LATENCY;
+#endif
+  uint64_t edge = 0;
+
+  if (capture_timer_service(&capture_timebase, &edge)
+      & CAPTURE_TIMER_CAPTURE_EVENT) {
+    // Every capture is queued with its full 64-bit timestamp.
+    capture_ring_push(&capture_ring, edge);
+#if ISR_TRACE_ENABLE
+    // The low bits of the timestamp hold the count at the edge, the latency
+    // is the count elapsed until entry.
+    latency = isr_trace_timer_to_cycles((entry_count - (uint32_t)edge)
+                                        & CAPTURE_TIMER_COUNTER_MASK);
+#endif
   }
+  ISR_TRACE_EXIT(CONFIG_TIMER_ISR_TRACE_ID, latency);
+#endif // CONFIG_TIMER_MULTI_CHANNEL_ENABLE
 }
 
-static void RSI_EGPIO_CLK_init(void)
-{
-  M4CLK->CLK_ENABLE_SET_REG3_b.EGPIO_CLK_ENABLE_b = 1;
-  M4CLK->CLK_ENABLE_SET_REG2_b.EGPIO_PCLK_ENABLE_b = 1;
-}
-
-static void gpio_init(void)
+#if CONFIG_TIMER_EXPORT_ENABLE
+/***************************************************************************//**
+ * Sends export bytes on the debug UART.
+ ******************************************************************************/
+static void export_write(const uint8_t *data, uint32_t length)
 {
-  RSI_EGPIO_CLK_init();
-
-  if ((CONFIG_TIMER_INPUT_GPIO_PIN > 24)
-      && (CONFIG_TIMER_INPUT_GPIO_PIN < 31)) {
-    RSI_EGPIO_HostPadsGpioModeEnable(RTE_SCT_IN_0_PIN);
+  for (uint32_t index = 0; index < length; index++) {
+    Board_UARTPutChar(data[index]);
   }
-
-  RSI_EGPIO_PadReceiverEnable(RTE_SCT_IN_0_PIN);
-
-  RSI_EGPIO_SetDir(EGPIO, CONFIG_TIMER_INPUT_GPIO_PORT,
-                   CONFIG_TIMER_INPUT_GPIO_PIN, EGPIO_CONFIG_DIR_INPUT);
-
-  RSI_EGPIO_SetPinMux(EGPIO, CONFIG_TIMER_INPUT_GPIO_PORT,
-                      CONFIG_TIMER_INPUT_GPIO_PIN, RTE_SCT_IN_0_MUX);
-
-  DEBUGOUT("Successfully set pin mode for GPIO_25\r\n");
 }
 
-static void config_timer_init(void)
+/***************************************************************************//**
+ * Encodes a batch of captures into export frames. A frame is closed when it
+ * is full, or EXPORT_FLUSH_US after its first capture so slow signals are
+ * still sent.
+ ******************************************************************************/
+static void export_captures(const uint64_t *captures,
+                            const bool *gaps,
+                            uint32_t count)
 {
-  uint32_t ct_config_value = 0;
-  ct_config_value = 0;
-  uint32_t interrupt_flags = 0;
-  interrupt_flags = 0;
-
-  RSI_CLK_CtClkConfig(M4CLK, CT_SOCPLLCLK, SCT_CLOCK_DIV_FACT,
-                      ENABLE_STATIC_CLK);
-
-  ct_config_value = COUNTER32_BITMODE | PERIODIC_ENCOUNTER_0 | COUNTER0_UP;
-  interrupt_flags = RSI_CT_EVENT_INTR_0_l | RSI_CT_EVENT_COUNTER_0_IS_PEAK_l
-                    | RSI_CT_EVENT_COUNTER_1_IS_PEAK_l;
-
-  RSI_CT_SetControl(CONFIG_TIMER_0_BASE_ADD, ct_config_value);
-  DEBUGOUT("Successfully set configuration for Config Timer\r\n");
-
-  RSI_CT_PeripheralReset(CONFIG_TIMER_0_BASE_ADD, (boolean_t)COUNTER_0);
-  RSI_CT_SetCount(CONFIG_TIMER_0_BASE_ADD, 0);
-  DEBUGOUT("Successfully set CT Initial Count\n");
-
-  CONFIG_TIMER_0_BASE_ADD->CT_MATCH_REG = TOP_COUNTER_VALUE;
-  DEBUGOUT("Successfully set CT Match Count\n");
-
-  RSI_CT_InterruptDisable(CONFIG_TIMER_0_BASE_ADD, interrupt_flags);
-  RSI_CT_InterruptEnable(CONFIG_TIMER_0_BASE_ADD, interrupt_flags);
-  NVIC_EnableIRQ(CT_IRQn);
-  DEBUGOUT("Successfully enabled interrupt for Config Timer\r\n");
-
-  RSI_CT_InterruptEventSelect(CONFIG_TIMER_0_BASE_ADD, FALLING_EDGE_EVENT);
-  DEBUGOUT("Successfully selected interrupt action event for Config Timer\r\n");
-
-  RSI_CT_CaptureEventSelect(CONFIG_TIMER_0_BASE_ADD, FALLING_EDGE_EVENT);
-  DEBUGOUT("Successfully selected capture action event for Config Timer\r\n");
-
-  RSI_CT_StartSoftwareTrig(CONFIG_TIMER_0_BASE_ADD, COUNTER_0);
-  DEBUGOUT("Successfully started Config Timer\r\n");
+  uint32_t overruns = 0;
+  uint32_t lost = 0;
+
+  for (uint32_t index = 0; index < count; index++) {
+    lost = 0;
+    if (gaps[index]) {
+      overruns = capture_ring_get_overruns(&capture_ring);
+      lost = overruns - exported_overruns;
+      exported_overruns = overruns;
+    }
+    if (!capture_export_is_pending(&capture_export)) {
+      cycle_counter_timeout_start(&export_flush_timeout, EXPORT_FLUSH_US);
+    }
+    capture_export_add(&capture_export, captures[index], lost);
+  }
+  if (capture_export_is_pending(&capture_export)
+      && cycle_counter_timeout_expired(&export_flush_timeout)) {
+    capture_export_flush(&capture_export);
+  }
+  capture_export_transmit(&capture_export, export_write, EXPORT_TX_CHUNK);
 }
+#endif // CONFIG_TIMER_EXPORT_ENABLE
 
 /***************************************************************************//**
  * Initialize application.
  ******************************************************************************/
 void app_init(void)
 {
-  gpio_init();
-  config_timer_init();
+  // The timer clock is selected first, the tracing needs its frequency.
+  capture_timer_clock_init();
+#if ISR_TRACE_ENABLE
+  isr_trace_init();
+  isr_trace_set_timer_frequency(CAPTURE_TIMER_FREQUENCY);
+#endif
+  capture_ring_init(&capture_ring);
+#if CONFIG_TIMER_EXPORT_ENABLE
+  cycle_counter_init();
+  capture_export_init(&capture_export);
+#endif
+#if CONFIG_TIMER_MULTI_CHANNEL_ENABLE
+  multi_capture_init(&capture_timebase,
+                     MULTI_CAPTURE_CHANNEL_0_EVENT,
+                     MULTI_CAPTURE_CHANNEL_1_EVENT);
+#else
+  capture_timebase_init(&capture_timebase, CAPTURE_TIMER_COUNTER_BITS);
+  capture_timer_gpio_init();
+  capture_timer_init(CAPTURE_TIMER_CAPTURE_EVENT | CAPTURE_TIMER_WRAP_EVENT,
+                     CAPTURE_TIMER_FALLING_EDGE);
+#endif
 }
 
 /***************************************************************************//**
@@ -134,9 +177,48 @@ void app_init(void)
  ******************************************************************************/
 void app_process_action(void)
 {
-  if (data_ready) {
-    // clear flag here
-    flag = 0;
-    DEBUGOUT("capture value %d\n", capture_value);
+  uint64_t captures[CAPTURE_BATCH_SIZE];
+  bool gaps[CAPTURE_BATCH_SIZE];
+  uint32_t count = 0;
+
+  // The captures queued since the last call are printed, or exported.
+  // Where captures were dropped because the ring was full, the total number
+  // of dropped captures is printed.
+  do {
+    count = capture_ring_pop_batch(&capture_ring, captures, gaps,
+                                   CAPTURE_POP_SIZE);
+#if CONFIG_TIMER_EXPORT_ENABLE
+    export_captures(captures, gaps, count);
+#else
+    for (uint32_t index = 0; index < count; index++) {
+      if (gaps[index]) {
+        DLOG("captures lost, %lu in total\n",
+             (unsigned long)capture_ring_get_overruns(&capture_ring));
+      }
+#if CONFIG_TIMER_MULTI_CHANNEL_ENABLE
+      uint64_t timestamp = multi_capture_get_timestamp(captures[index]);
+
+      DLOG("channel %u capture value 0x%08lX%08lX\n",
+           (unsigned int)multi_capture_get_channel(captures[index]),
+           (unsigned long)(timestamp >> 32),
+           (unsigned long)timestamp);
+#else
+      DLOG("capture value 0x%08lX%08lX\n",
+           (unsigned long)(captures[index] >> 32),
+           (unsigned long)captures[index]);
+#endif
+    }
+#endif
+  } while (count == CAPTURE_BATCH_SIZE);
+  deferred_log_process();
+#if ISR_TRACE_ENABLE
+  isr_trace_stats_t trace_stats;
+
+  isr_trace_process();
+  isr_trace_get_stats(CONFIG_TIMER_ISR_TRACE_ID, &trace_stats);
+  if (trace_stats.duration.count >= CONFIG_TIMER_TRACE_REPORT_RUNS) {
+    isr_trace_print(CONFIG_TIMER_ISR_TRACE_ID, "CONFIG_TIMER_IRQHandler");
+    isr_trace_reset(CONFIG_TIMER_ISR_TRACE_ID);
   }
+#endif
 }
@@ -17,6 +17,48 @@
 #ifndef I2C_LEADER_INTERRUPT_H_
 #define I2C_LEADER_INTERRUPT_H_
 
+#include <stdbool.h>
+#include <stdint.h>
+#include "sl_status.h"
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+typedef struct i2c_transaction i2c_transaction_t;
+
+// Callback invoked from the I2C IRQ handler once a transaction is finished
+typedef void (*i2c_transaction_callback_t)(i2c_transaction_t *transaction,
+                                           sl_status_t status);
+
+// I2C transaction descriptor. It is owned by the driver from submission until
+// its callback is invoked, and must stay valid in the meantime.
+// When both lengths are set, the read follows the write with a repeated start
+// and a single stop, as needed for register reads.
+// A transaction is completed with SL_STATUS_ABORT when it is NACKed or loses
+// the arbitration, and with SL_STATUS_TIMEOUT when it is not finished before
+// its deadline. The bus is then recovered, SL_STATUS_BUS_ERROR is reported
+// if it is still held low.
+struct i2c_transaction {
+  uint16_t follower_address;           // 7-bit or 10-bit follower address
+  const uint8_t *write_buffer;         // Data to write, unused if write_length is 0
+  uint32_t write_length;               // Number of bytes to write
+  uint8_t *read_buffer;                // Buffer for the read data, unused if read_length is 0
+  uint32_t read_length;                // Number of bytes to read after the write
+  i2c_transaction_callback_t callback; // Completion callback, can be NULL
+  uint32_t timeout_us;                 // Deadline from the start, 0 for the default
+  void *context;                       // User context, not used by the driver
+};
+
+// Error counters of the driver, they are only cleared on request
+typedef struct {
+  uint32_t address_nacks;         // Transfers aborted by an address NACK
+  uint32_t data_nacks;            // Transfers aborted by a data NACK
+  uint32_t arbitration_losses;    // Transfers aborted by a lost arbitration
+  uint32_t timeouts;              // Transactions aborted at their deadline
+  uint32_t bus_recoveries;        // Bus recovery sequences run after a timeout
+  uint32_t bus_recovery_failures; // Recoveries leaving SCL or SDA held low
+} i2c_leader_error_counters_t;
+
 // -----------------------------------------------------------------------------
 // Prototypes
 
@@ -38,4 +80,40 @@ void i2c_leader_interrupt_init(void);
  ******************************************************************************/
 void i2c_leader_interrupt_process_action(void);
 
+/***************************************************************************/ /**
+ * Queues a transaction. The write bytes are sent first, then the read bytes
+ * are received after a repeated start. Queued transactions are chained back to back by the IRQ
+ * handler, the function never blocks.
+ * It must be called from a single context, and not from the callbacks.
+ *
+ * @param[in] transaction Transaction descriptor, valid until its callback.
+ * @return SL_STATUS_OK if queued, SL_STATUS_FULL if the queue is full,
+ *         SL_STATUS_INVALID_PARAMETER for an empty transaction.
+ ******************************************************************************/
+sl_status_t i2c_leader_submit_transaction(i2c_transaction_t *transaction);
+
+/***************************************************************************/ /**
+ * Checks whether the driver has no active or queued transaction.
+ *
+ * @param none
+ * @return true if idle, false otherwise.
+ ******************************************************************************/
+bool i2c_leader_is_idle(void);
+
+/***************************************************************************/ /**
+ * Copies the error counters.
+ *
+ * @param[out] counters Error counters.
+ * @return none
+ ******************************************************************************/
+void i2c_leader_get_error_counters(i2c_leader_error_counters_t *counters);
+
+/***************************************************************************/ /**
+ * Clears the error counters.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void i2c_leader_clear_error_counters(void);
+
 #endif /* I2C_LEADER_INTERRUPT_H_ */
@@ -0,0 +1,117 @@
+/***************************************************************************/ /**
+ * @file i2c_scheduler.h
+ * @brief I2C multi-follower bus scheduler
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#ifndef I2C_SCHEDULER_H_
+#define I2C_SCHEDULER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sl_status.h"
+#include "i2c_leader_interrupt.h"
+
+// -----------------------------------------------------------------------------
+// Defines
+
+#define I2C_SCHEDULER_MAX_DEVICES 10 // Maximum number of registered devices
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+typedef struct i2c_scheduler_device i2c_scheduler_device_t;
+
+// Time source of the scheduler, returns a free-running tick count
+typedef uint32_t (*i2c_scheduler_time_t)(void);
+
+// Callback invoked from the I2C IRQ handler once a polling transfer is finished
+typedef void (*i2c_scheduler_callback_t)(i2c_scheduler_device_t *device,
+                                         sl_status_t status);
+
+// Device polled by the scheduler. The transfer template is submitted once per
+// period, its callback and context fields are used by the scheduler.
+struct i2c_scheduler_device {
+  i2c_transaction_t transaction;     // Transfer template
+  uint32_t period;                   // Polling period, in ticks
+  uint8_t priority;                  // Priority, 0 is the highest
+  i2c_scheduler_callback_t callback; // Completion callback, can be NULL
+  // Statistics, read only
+  uint32_t completions;              // Number of completed transfers
+  uint32_t errors;                   // Number of failed transfers
+  uint32_t deadline_misses;          // Late transfers and skipped periods
+  uint32_t max_latency;              // Longest release to completion time, in ticks
+  // Internal state
+  uint32_t release_time;             // Start of the current period
+  uint32_t next_release;             // Start of the next period
+  uint32_t submit_time;              // Submission of the current transfer
+  volatile bool pending;             // Released, not submitted yet
+  volatile bool in_flight;           // Submitted, not completed yet
+};
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************/ /**
+ * Initializes the scheduler and removes all devices.
+ *
+ * @param[in] get_time Time source used for releases and deadlines.
+ * @return none
+ ******************************************************************************/
+void i2c_scheduler_init(i2c_scheduler_time_t get_time);
+
+/***************************************************************************/ /**
+ * Registers a device. Its first transfer is released right away.
+ * The transaction template (follower address, buffers and lengths), period,
+ * priority and callback must be filled before the call.
+ *
+ * @param[in] device Device, valid as long as the scheduler runs.
+ * @return SL_STATUS_OK if registered, SL_STATUS_FULL if no slot is left,
+ *         SL_STATUS_INVALID_PARAMETER for a zero period.
+ ******************************************************************************/
+sl_status_t i2c_scheduler_add_device(i2c_scheduler_device_t *device);
+
+/***************************************************************************/ /**
+ * Releases the devices whose period has started and submits the released
+ * transfers by priority, then earliest deadline. All due transfers are queued
+ * at once, so the I2C driver runs them back to back.
+ * A device still busy with its previous transfer when a new period starts
+ * skips that period, and periods elapsed during a stall of the main loop are
+ * skipped too. Each skipped period and each transfer completed after the end
+ * of its period counts a deadline miss.
+ * It must be called from the main loop.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void i2c_scheduler_process(void);
+
+/***************************************************************************/ /**
+ * Returns the share of time the bus spent on the scheduled transfers since
+ * the initialization or the last clear. The window must stay shorter than
+ * the wrap of the tick counter.
+ *
+ * @param none
+ * @return bus utilization, in parts per million
+ ******************************************************************************/
+uint32_t i2c_scheduler_get_utilization_ppm(void);
+
+/***************************************************************************/ /**
+ * Clears the busy time and starts a new utilization window.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+void i2c_scheduler_clear_utilization(void);
+
+#endif /* I2C_SCHEDULER_H_ */
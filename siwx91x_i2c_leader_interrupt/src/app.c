@@ -15,6 +15,51 @@
  *
  ******************************************************************************/
 #include "i2c_leader_interrupt.h"
+#include "i2c_scheduler.h"
+#include "cycle_counter.h"
+#include "deferred_log.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#ifndef I2C_SCHEDULER_ENABLE
+#define I2C_SCHEDULER_ENABLE 0 // Set to 1 to poll the Follower with i2c_scheduler.c after the example transactions
+#endif
+#define SCHEDULER_FOLLOWER_ADDR   0x50    // Follower polled by the scheduler
+#define SCHEDULER_FAST_PERIOD_US  10000   // Period of the short register read, in microseconds
+#define SCHEDULER_SLOW_PERIOD_US  100000  // Period of the long register read, in microseconds
+#define SCHEDULER_REPORT_US       1000000 // Time between two statistics reports, in microseconds
+#define SCHEDULER_FAST_LENGTH     2       // Bytes read by the short register read
+#define SCHEDULER_SLOW_LENGTH     16      // Bytes read by the long register read
+#define SCHEDULER_FAST_REGISTER   0x00    // Register read by the short register read
+#define SCHEDULER_SLOW_REGISTER   0x10    // Register read by the long register read
+
+#if I2C_SCHEDULER_ENABLE
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static const uint8_t fast_register = SCHEDULER_FAST_REGISTER;
+static const uint8_t slow_register = SCHEDULER_SLOW_REGISTER;
+static uint8_t fast_data[SCHEDULER_FAST_LENGTH];
+static uint8_t slow_data[SCHEDULER_SLOW_LENGTH];
+static i2c_scheduler_device_t fast_device;
+static i2c_scheduler_device_t slow_device;
+static bool scheduler_started = false;
+static cycle_counter_timeout_t report_timeout;
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static void scheduler_start(void);
+static void scheduler_add_device(i2c_scheduler_device_t *device,
+                                 const uint8_t *reg,
+                                 uint8_t *data,
+                                 uint32_t length,
+                                 uint32_t period_us,
+                                 uint8_t priority);
+static void scheduler_report(void);
+static void scheduler_report_device(const i2c_scheduler_device_t *device);
+#endif
 
 /***************************************************************************/ /**
  * Initialize application.
@@ -30,4 +75,113 @@ void app_init(void)
 void app_process_action(void)
 {
   i2c_leader_interrupt_process_action();
+#if I2C_SCHEDULER_ENABLE
+  // The Follower is polled once the example transactions are over.
+  if (!scheduler_started && i2c_leader_is_idle()) {
+    scheduler_start();
+  }
+  if (scheduler_started) {
+    i2c_scheduler_process();
+    if (cycle_counter_timeout_expired(&report_timeout)) {
+      scheduler_report();
+      cycle_counter_timeout_start(&report_timeout, SCHEDULER_REPORT_US);
+    }
+  }
+#endif
+  // The messages recorded during the step are printed here.
+  deferred_log_process();
+}
+
+#if I2C_SCHEDULER_ENABLE
+/*******************************************************************************
+ * Function to register the polled register reads. The cycle counter is the
+ * tick source of the scheduler.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void scheduler_start(void)
+{
+  i2c_scheduler_init(cycle_counter_get);
+  scheduler_add_device(&fast_device,
+                       &fast_register,
+                       fast_data,
+                       SCHEDULER_FAST_LENGTH,
+                       SCHEDULER_FAST_PERIOD_US,
+                       0);
+  scheduler_add_device(&slow_device,
+                       &slow_register,
+                       slow_data,
+                       SCHEDULER_SLOW_LENGTH,
+                       SCHEDULER_SLOW_PERIOD_US,
+                       1);
+  i2c_leader_clear_error_counters();
+  cycle_counter_timeout_start(&report_timeout, SCHEDULER_REPORT_US);
+  scheduler_started = true;
+}
+
+/*******************************************************************************
+ * Function to register one register read of the Follower.
+ *
+ * @param[in] device (i2c_scheduler_device_t) Device to register.
+ * @param[in] reg (uint8_t) Register address, written before the read.
+ * @param[in] data (uint8_t) Buffer for the read data.
+ * @param[in] length (uint32_t) Number of bytes to read.
+ * @param[in] period_us (uint32_t) Polling period, in microseconds.
+ * @param[in] priority (uint8_t) Priority, 0 is the highest.
+ * @return none
+ ******************************************************************************/
+static void scheduler_add_device(i2c_scheduler_device_t *device,
+                                 const uint8_t *reg,
+                                 uint8_t *data,
+                                 uint32_t length,
+                                 uint32_t period_us,
+                                 uint8_t priority)
+{
+  device->transaction.follower_address = SCHEDULER_FOLLOWER_ADDR;
+  device->transaction.write_buffer = reg;
+  device->transaction.write_length = 1;
+  device->transaction.read_buffer = data;
+  device->transaction.read_length = length;
+  device->period = cycle_counter_us_to_cycles(period_us);
+  device->priority = priority;
+  if (i2c_scheduler_add_device(device) != SL_STATUS_OK) {
+    DLOG("Scheduler device registration failed \n");
+  }
+}
+
+/*******************************************************************************
+ * Function to print the statistics of the polled reads and the bus
+ * utilization of the last report period, then start a new one.
+ *
+ * @param none
+ * @return none
+ ******************************************************************************/
+static void scheduler_report(void)
+{
+  // The records of a report are printed on the same line.
+  DLOG("Fast poll: ");
+  scheduler_report_device(&fast_device);
+  DLOG("Slow poll: ");
+  scheduler_report_device(&slow_device);
+  DLOG("Bus utilization: %lu ppm \n",
+       (unsigned long)i2c_scheduler_get_utilization_ppm());
+  i2c_scheduler_clear_utilization();
+}
+
+/*******************************************************************************
+ * Function to print the statistics of one polled read.
+ *
+ * @param[in] device (i2c_scheduler_device_t) Polled device.
+ * @return none
+ ******************************************************************************/
+static void scheduler_report_device(const i2c_scheduler_device_t *device)
+{
+  DLOG("%lu completed, %lu errors, ",
+       (unsigned long)device->completions,
+       (unsigned long)device->errors);
+  DLOG("%lu deadline misses, max latency %lu us \n",
+       (unsigned long)device->deadline_misses,
+       (unsigned long)cycle_counter_cycles_to_us(device->max_latency));
 }
+#endif
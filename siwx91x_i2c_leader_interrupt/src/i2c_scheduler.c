@@ -0,0 +1,244 @@
+/***************************************************************************/ /**
+ * @file i2c_scheduler.c
+ * @brief I2C multi-follower bus scheduler
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stddef.h>
+#include "si91x_device.h"
+#include "i2c_scheduler.h"
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define I2C_SCHEDULER_PPM 1000000 // Parts per million of the utilization
+
+/*******************************************************************************
+ *************************** LOCAL VARIABLES   *******************************
+ ******************************************************************************/
+static i2c_scheduler_device_t *devices[I2C_SCHEDULER_MAX_DEVICES];
+static uint32_t device_count = 0;
+static i2c_scheduler_time_t scheduler_time = NULL;
+// Bus utilization, updated by the completion callback
+static volatile uint32_t busy_time = 0;
+static volatile uint32_t window_start = 0;
+static uint32_t last_completion = 0;
+
+/*******************************************************************************
+ **********************  Local Function prototypes   ***************************
+ ******************************************************************************/
+static bool time_reached(uint32_t now, uint32_t time);
+static uint32_t latest_time(uint32_t first, uint32_t second);
+static i2c_scheduler_device_t *select_next_device(void);
+static void scheduler_transaction_callback(i2c_transaction_t *transaction,
+                                           sl_status_t status);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+/*******************************************************************************
+ * Initializes the scheduler.
+ ******************************************************************************/
+void i2c_scheduler_init(i2c_scheduler_time_t get_time)
+{
+  scheduler_time = get_time;
+  device_count = 0;
+  i2c_scheduler_clear_utilization();
+}
+
+/*******************************************************************************
+ * Registers a device.
+ ******************************************************************************/
+sl_status_t i2c_scheduler_add_device(i2c_scheduler_device_t *device)
+{
+  if ((device == NULL) || (device->period == 0)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  if (device_count >= I2C_SCHEDULER_MAX_DEVICES) {
+    return SL_STATUS_FULL;
+  }
+  device->transaction.callback = scheduler_transaction_callback;
+  device->transaction.context = device;
+  device->completions = 0;
+  device->errors = 0;
+  device->deadline_misses = 0;
+  device->max_latency = 0;
+  device->pending = false;
+  device->in_flight = false;
+  device->next_release = scheduler_time();
+  devices[device_count++] = device;
+  return SL_STATUS_OK;
+}
+
+/*******************************************************************************
+ * Releases and submits the due transfers.
+ ******************************************************************************/
+void i2c_scheduler_process(void)
+{
+  i2c_scheduler_device_t *device;
+  uint32_t now = scheduler_time();
+
+  for (uint32_t index = 0; index < device_count; index++) {
+    device = devices[index];
+    if (!time_reached(now, device->next_release)) {
+      continue;
+    }
+    // A device still busy with its previous transfer skips this period, which
+    // counts a deadline miss. The late transfer counts its own miss when it
+    // completes.
+    if (!device->pending && !device->in_flight) {
+      device->release_time = device->next_release;
+      device->pending = true;
+    } else {
+      device->deadline_misses++;
+    }
+    device->next_release += device->period;
+    // After a long stall, periods are skipped rather than released in a burst,
+    // each skipped period counts a deadline miss.
+    if (time_reached(now, device->next_release)) {
+      device->deadline_misses +=
+        (now - device->next_release) / device->period + 1;
+      device->next_release = now + device->period;
+    }
+  }
+
+  while ((device = select_next_device()) != NULL) {
+    device->submit_time = now;
+    device->in_flight = true;
+    if (i2c_leader_submit_transaction(&device->transaction) != SL_STATUS_OK) {
+      // The driver queue is full, the remaining ones wait for the next call.
+      device->in_flight = false;
+      break;
+    }
+    device->pending = false;
+  }
+}
+
+/*******************************************************************************
+ * Returns the bus utilization since the last clear. The busy time and the
+ * window start are read with the I2C interrupt masked, so the callback cannot
+ * update them in between.
+ ******************************************************************************/
+uint32_t i2c_scheduler_get_utilization_ppm(void)
+{
+  uint32_t busy;
+  uint32_t window;
+
+  __disable_irq();
+  busy = busy_time;
+  window = scheduler_time() - window_start;
+  __enable_irq();
+  if (window == 0) {
+    return 0;
+  }
+  return (uint32_t)(((uint64_t)busy * I2C_SCHEDULER_PPM) / window);
+}
+
+/*******************************************************************************
+ * Starts a new utilization window.
+ ******************************************************************************/
+void i2c_scheduler_clear_utilization(void)
+{
+  __disable_irq();
+  busy_time = 0;
+  window_start = scheduler_time();
+  last_completion = window_start;
+  __enable_irq();
+}
+
+/*******************************************************************************
+ * Checks whether the time has been reached, across the tick counter wrap.
+ *
+ * @param[in] now (uint32_t) Current time.
+ * @param[in] time (uint32_t) Time to check.
+ * @return true if now is at or after time.
+ ******************************************************************************/
+static bool time_reached(uint32_t now, uint32_t time)
+{
+  return (int32_t)(now - time) >= 0;
+}
+
+/*******************************************************************************
+ * Returns the later of two times, across the tick counter wrap.
+ *
+ * @param[in] first (uint32_t) First time.
+ * @param[in] second (uint32_t) Second time.
+ * @return the later time.
+ ******************************************************************************/
+static uint32_t latest_time(uint32_t first, uint32_t second)
+{
+  return time_reached(first, second) ? first : second;
+}
+
+/*******************************************************************************
+ * Selects the released device to submit first: highest priority, then
+ * earliest deadline.
+ *
+ * @param none
+ * @return device to submit, NULL if none is released.
+ ******************************************************************************/
+static i2c_scheduler_device_t *select_next_device(void)
+{
+  i2c_scheduler_device_t *selected = NULL;
+  i2c_scheduler_device_t *device;
+
+  for (uint32_t index = 0; index < device_count; index++) {
+    device = devices[index];
+    if (!device->pending) {
+      continue;
+    }
+    if ((selected == NULL) || (device->priority < selected->priority)
+        || ((device->priority == selected->priority)
+            && ((int32_t)((device->release_time + device->period)
+                          - (selected->release_time + selected->period))
+                < 0))) {
+      selected = device;
+    }
+  }
+  return selected;
+}
+
+/*******************************************************************************
+ * Completion callback of the scheduled transfers, called from the I2C IRQ
+ * handler. It updates the device statistics and the bus busy time.
+ * The driver runs the queued transfers one after the other, so a transfer
+ * occupies the bus from its submission or from the previous completion,
+ * whichever is later, until its own completion.
+ ******************************************************************************/
+static void scheduler_transaction_callback(i2c_transaction_t *transaction,
+                                           sl_status_t status)
+{
+  i2c_scheduler_device_t *device = transaction->context;
+  uint32_t now = scheduler_time();
+  uint32_t latency = now - device->release_time;
+  uint32_t start = latest_time(device->submit_time, last_completion);
+
+  busy_time += now - start;
+  last_completion = now;
+
+  if (status == SL_STATUS_OK) {
+    device->completions++;
+  } else {
+    device->errors++;
+  }
+  if (latency > device->max_latency) {
+    device->max_latency = latency;
+  }
+  if (latency > device->period) {
+    device->deadline_misses++;
+  }
+  device->in_flight = false;
+  if (device->callback != NULL) {
+    device->callback(device, status);
+  }
+}